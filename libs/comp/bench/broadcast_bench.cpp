@@ -0,0 +1,141 @@
+// Fan-out scaling: one producer, 1..16 consumers
+//
+// Compares a BroadcastRing (producer writes once, consumers share the data) against
+// per-consumer SPSC rings (producer copies every block once per consumer).
+//
+// Usage: dspai_comp_broadcast_bench [samples_per_run]
+
+#include <dspai/comp/broadcast_ring.hpp>
+#include <dspai/comp/spsc_ring.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace dspai::comp;
+
+namespace {
+
+constexpr std::size_t block_size = 256;
+constexpr std::size_t ring_capacity = 16 * 1024;
+
+using Clock = std::chrono::steady_clock;
+
+// Keep the consumer loop from being optimized away
+std::atomic<std::uint64_t> sink{0};
+
+double run_broadcast(std::size_t consumers, std::uint64_t samples) {
+    BroadcastRing<float> ring;
+    ring.allocate(ring_capacity, consumers);
+    std::vector<std::size_t> ids;
+    for (std::size_t c = 0; c < consumers; ++c) {
+        ids.push_back(*ring.attach());
+    }
+
+    std::vector<std::thread> threads;
+    const auto start = Clock::now();
+    for (std::size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            std::uint64_t seen = 0;
+            float acc = 0.0f;
+            while (seen < samples) {
+                auto region = ring.readable(ids[c]);
+                for (float v : region) {
+                    acc += v;
+                }
+                ring.consume(ids[c], region.size());
+                seen += region.size();
+                if (region.empty()) {
+                    std::this_thread::yield();
+                }
+            }
+            sink.fetch_add(static_cast<std::uint64_t>(acc), std::memory_order_relaxed);
+        });
+    }
+
+    for (std::uint64_t written = 0; written < samples;) {
+        auto region = ring.writable(block_size);
+        for (std::size_t i = 0; i < region.size(); ++i) {
+            region[i] = static_cast<float>(i);
+        }
+        ring.commit(region.size());
+        written += region.size();
+        if (region.empty()) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double run_copy(std::size_t consumers, std::uint64_t samples) {
+    std::vector<std::unique_ptr<SpscRing<float>>> rings;
+    for (std::size_t c = 0; c < consumers; ++c) {
+        rings.push_back(std::make_unique<SpscRing<float>>());
+        rings.back()->allocate(ring_capacity);
+    }
+
+    std::vector<std::thread> threads;
+    const auto start = Clock::now();
+    for (std::size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            std::uint64_t seen = 0;
+            float acc = 0.0f;
+            while (seen < samples) {
+                auto region = rings[c]->readable();
+                for (float v : region) {
+                    acc += v;
+                }
+                rings[c]->consume(region.size());
+                seen += region.size();
+                if (region.empty()) {
+                    std::this_thread::yield();
+                }
+            }
+            sink.fetch_add(static_cast<std::uint64_t>(acc), std::memory_order_relaxed);
+        });
+    }
+
+    std::array<float, block_size> block{};
+    for (std::size_t i = 0; i < block_size; ++i) {
+        block[i] = static_cast<float>(i);
+    }
+    for (std::uint64_t written = 0; written < samples; written += block_size) {
+        for (auto& ring : rings) {
+            for (std::size_t done = 0; done < block_size;) {
+                done += ring->write(std::span<const float>(block.data() + done, block_size - done));
+                if (done < block_size) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t samples = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1u << 24;
+
+    std::printf("Broadcast fan-out benchmark: %llu samples/consumer, block %zu, %u hardware threads\n",
+                static_cast<unsigned long long>(samples), block_size, std::thread::hardware_concurrency());
+    std::printf("%9s %16s %16s %9s\n", "consumers", "broadcast MS/s", "copy MS/s", "speedup");
+    for (std::size_t consumers : {1u, 2u, 4u, 8u, 16u}) {
+        const double broadcast = run_broadcast(consumers, samples);
+        const double copy = run_copy(consumers, samples);
+        // Producer throughput: samples delivered to every consumer per second
+        std::printf("%9zu %16.1f %16.1f %8.2fx\n", consumers, samples / broadcast / 1e6, samples / copy / 1e6,
+                    copy / broadcast);
+    }
+    return 0;
+}
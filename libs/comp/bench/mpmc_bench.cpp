@@ -0,0 +1,155 @@
+// Fan-in scaling: 1..64 producers, one consumer
+//
+// Compares MpmcQueue (single and batched push/pop) against a mutex-protected std::deque.
+//
+// Usage: dspai_comp_mpmc_bench [events_total]
+
+#include <dspai/comp/mpmc_queue.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace dspai::comp;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Event {
+    std::uint32_t channel = 0;
+    std::uint32_t kind = 0;
+    std::uint64_t offset = 0;
+};
+
+constexpr std::size_t queue_capacity = 4096;
+
+struct Result {
+    double seconds = 0.0;
+    std::uint64_t retries = 0;
+};
+
+// Spin (with yield) until all producers are ready, then time the transfer
+template <typename Produce, typename Consume>
+double timed_run(std::size_t producers, Produce&& produce, Consume&& consume) {
+    std::atomic<std::size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            produce(p);
+        });
+    }
+    while (ready.load() < producers) {
+        std::this_thread::yield();
+    }
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    consume();
+    const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return seconds;
+}
+
+Result run_mpmc(std::size_t producers, std::uint64_t per_producer, std::size_t batch) {
+    MpmcQueue<Event> queue;
+    queue.allocate(queue_capacity);
+    const std::uint64_t total = producers * per_producer;
+
+    Result result;
+    result.seconds = timed_run(
+        producers,
+        [&](std::size_t p) {
+            std::vector<Event> events(batch);
+            for (std::uint64_t i = 0; i < per_producer;) {
+                const std::size_t n = std::min<std::uint64_t>(batch, per_producer - i);
+                for (std::size_t k = 0; k < n; ++k) {
+                    events[k] = Event{static_cast<std::uint32_t>(p), 1, i + k};
+                }
+                const auto pushed = queue.push_batch(std::span<const Event>(events.data(), n));
+                i += pushed;
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        },
+        [&] {
+            std::vector<Event> events(batch);
+            for (std::uint64_t received = 0; received < total;) {
+                const auto n = queue.pop_batch(events);
+                received += n;
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    result.retries = queue.cas_retries();
+    return result;
+}
+
+Result run_mutex(std::size_t producers, std::uint64_t per_producer) {
+    std::mutex mutex;
+    std::deque<Event> queue;
+    const std::uint64_t total = producers * per_producer;
+
+    Result result;
+    result.seconds = timed_run(
+        producers,
+        [&](std::size_t p) {
+            for (std::uint64_t i = 0; i < per_producer;) {
+                std::unique_lock lock(mutex);
+                if (queue.size() < queue_capacity) {
+                    queue.push_back(Event{static_cast<std::uint32_t>(p), 1, i});
+                    ++i;
+                } else {
+                    lock.unlock();
+                    std::this_thread::yield();
+                }
+            }
+        },
+        [&] {
+            for (std::uint64_t received = 0; received < total;) {
+                std::unique_lock lock(mutex);
+                if (!queue.empty()) {
+                    queue.pop_front();
+                    ++received;
+                } else {
+                    lock.unlock();
+                    std::this_thread::yield();
+                }
+            }
+        });
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t events = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1u << 22;
+
+    std::printf("MPMC fan-in benchmark: %llu events total, %u hardware threads\n",
+                static_cast<unsigned long long>(events), std::thread::hardware_concurrency());
+    std::printf("%9s %14s %14s %14s %12s\n", "producers", "mutex Mev/s", "mpmc Mev/s", "mpmc16 Mev/s", "CAS retries");
+    for (std::size_t producers : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+        const std::uint64_t per_producer = events / producers;
+        const double total = static_cast<double>(per_producer * producers);
+        const auto mutex = run_mutex(producers, per_producer);
+        const auto single = run_mpmc(producers, per_producer, 1);
+        const auto batched = run_mpmc(producers, per_producer, 16);
+        std::printf("%9zu %14.2f %14.2f %14.2f %12llu\n", producers, total / mutex.seconds / 1e6,
+                    total / single.seconds / 1e6, total / batched.seconds / 1e6,
+                    static_cast<unsigned long long>(single.retries + batched.retries));
+    }
+    return 0;
+}
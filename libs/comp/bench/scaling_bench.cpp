@@ -0,0 +1,519 @@
+// Core scaling: throughput vs threads for each executor
+//
+// Runs three workloads on 1..N threads and reports throughput and parallel efficiency
+// (throughput / (threads * single-thread throughput)):
+// - pipeline/threaded: chains of source -> stage -> sink linked by SPSC rings, one chain per
+//   thread, on ThreadedExecutor (nodes owned round-robin in topological order).
+// - independent/pool: independent components stepped in tasks on ThreadPool (shared task
+//   queue, dynamic load distribution), each step publishing a result to a shared MpmcQueue.
+// - soa/threaded: ComponentArray<16> instances (16 lanes per step) on ThreadedExecutor.
+// ThreadedExecutor runs are pinned "compact" (fill one socket first) and, on multi-socket
+// machines, "spread" (alternate sockets) to expose cross-socket effects. A calibration
+// probe (workload "calibration") compares synthetic per-thread counters packed into one
+// cache line against padded ones; it shows what false sharing costs on this machine and
+// says nothing about the executors.
+//
+// Contention hotspots are flagged after the table: MpmcQueue push CAS retries per push (the
+// draining consumer's pop retries are excluded), the thread count where efficiency drops
+// below 70%, cross-socket slowdowns and the false-sharing calibration probe.
+//
+// Usage: dspai_comp_scaling_bench [--threads N] [--duration-ms D] [--json]
+//        (CSV on stdout by default; hotspots as trailing '#' lines)
+
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/component_array.hpp>
+#include <dspai/comp/executor.hpp>
+#include <dspai/comp/mpmc_queue.hpp>
+#include <dspai/comp/spsc_ring.hpp>
+#include <dspai/comp/thread_pool.hpp>
+#include <dspai/comp/topology.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace dspai::comp;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t ring_capacity = 1024;
+constexpr std::size_t batch = 64;
+constexpr std::uint32_t rounds = 16; // Mixing rounds per item: the "DSP work"
+
+std::uint64_t mix(std::uint64_t x, std::uint32_t n) noexcept {
+    for (std::uint32_t r = 0; r < n; ++r) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        x ^= x >> 29;
+    }
+    return x;
+}
+
+class Source : public Component {
+public:
+    explicit Source(SpscRing<std::uint64_t>& out) : out_(&out) {}
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override { next_ = 0; }
+    bool doExecute() noexcept override {
+        auto region = out_->writable();
+        const auto n = std::min(region.size(), batch);
+        for (std::size_t i = 0; i < n; ++i) {
+            region[i] = next_++;
+        }
+        out_->commit(n);
+        return false;
+    }
+
+private:
+    SpscRing<std::uint64_t>* out_;
+    std::uint64_t next_ = 0;
+};
+
+class Stage : public Component {
+public:
+    Stage(SpscRing<std::uint64_t>& in, SpscRing<std::uint64_t>& out) : in_(&in), out_(&out) {}
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override {}
+    bool doExecute() noexcept override {
+        auto input = in_->readable();
+        auto output = out_->writable();
+        const auto n = std::min({input.size(), output.size(), batch});
+        for (std::size_t i = 0; i < n; ++i) {
+            output[i] = mix(input[i], rounds);
+        }
+        in_->consume(n);
+        out_->commit(n);
+        return false;
+    }
+
+private:
+    SpscRing<std::uint64_t>* in_;
+    SpscRing<std::uint64_t>* out_;
+};
+
+class Sink : public Component {
+public:
+    explicit Sink(SpscRing<std::uint64_t>& in) : in_(&in) {}
+    std::uint64_t items() const noexcept { return items_.load(std::memory_order_relaxed); }
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override {}
+    bool doExecute() noexcept override {
+        auto input = in_->readable();
+        const auto n = std::min(input.size(), batch);
+        for (std::size_t i = 0; i < n; ++i) {
+            checksum_ ^= input[i];
+        }
+        in_->consume(n);
+        items_.store(items_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        return false;
+    }
+
+private:
+    SpscRing<std::uint64_t>* in_;
+    std::atomic<std::uint64_t> items_{0};
+    std::uint64_t checksum_ = 0;
+};
+
+// Independent component: one batch of work per step, result published to a shared queue
+class Worker : public Component {
+public:
+    Worker(std::uint64_t seed, MpmcQueue<std::uint64_t>& results) : state_(seed), results_(&results) {}
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override {}
+    bool doExecute() noexcept override {
+        for (std::size_t i = 0; i < batch; ++i) {
+            state_ = mix(state_, rounds);
+        }
+        results_->try_push(state_);
+        return false;
+    }
+
+private:
+    std::uint64_t state_;
+    MpmcQueue<std::uint64_t>* results_;
+};
+
+// Struct-of-arrays component: 16 lanes of work per step
+class Lanes : public ComponentArray<16> {
+protected:
+    std::error_code doInitialize() noexcept override {
+        for (std::size_t l = 0; l < lanes; ++l) {
+            state_[l] = l + 1;
+        }
+        return {};
+    }
+    void doTerminate() noexcept override {}
+    void doReset(const Mask&) noexcept override {}
+    Mask doExecute(const Mask&) noexcept override {
+        for (std::size_t i = 0; i < batch; ++i) {
+            for (std::size_t l = 0; l < lanes; ++l) {
+                state_[l] = mix(state_[l], rounds);
+            }
+        }
+        return {};
+    }
+
+private:
+    std::array<std::uint64_t, lanes> state_{};
+};
+
+struct Row {
+    std::string workload;
+    std::string executor;
+    std::size_t threads = 0;
+    std::string placement;        // compact / spread / os (unpinned)
+    unsigned sockets = 0;         // Sockets the pinned workers span (0 = unpinned)
+    double throughput = 0.0;      // Items per second
+    double efficiency = 0.0;
+    double retries_per_op = 0.0;  // MpmcQueue push CAS retries per push
+};
+
+struct Placement {
+    std::string name;
+    std::vector<unsigned> cpus; // One per worker; empty = unpinned
+    unsigned sockets = 0;
+};
+
+// CPU lists for `threads` workers: compact fills a socket (physical cores first), spread alternates sockets
+std::vector<Placement> placements(const CpuTopology* topology, std::size_t threads) {
+    if (!topology || topology->cpus.size() < threads) {
+        return {{"os", {}, 0}};
+    }
+    auto cpus = topology->cpus;
+    std::sort(cpus.begin(), cpus.end(), [](const LogicalCpu& a, const LogicalCpu& b) {
+        return std::tie(a.package, a.smt, a.core, a.id) < std::tie(b.package, b.smt, b.core, b.id);
+    });
+    auto sockets_of = [](const std::vector<unsigned>& ids, const CpuTopology& topo) {
+        std::set<unsigned> packages;
+        for (auto id : ids) {
+            packages.insert(topo.find(id)->package);
+        }
+        return static_cast<unsigned>(packages.size());
+    };
+
+    std::vector<Placement> result;
+    Placement compact{"compact", {}, 0};
+    for (std::size_t i = 0; i < threads; ++i) {
+        compact.cpus.push_back(cpus[i].id);
+    }
+    compact.sockets = sockets_of(compact.cpus, *topology);
+    result.push_back(compact);
+
+    if (topology->packages > 1 && threads > 1) {
+        std::map<unsigned, std::vector<unsigned>> by_package;
+        for (const auto& cpu : cpus) {
+            by_package[cpu.package].push_back(cpu.id);
+        }
+        Placement spread{"spread", {}, 0};
+        for (std::size_t i = 0; spread.cpus.size() < threads; ++i) {
+            for (auto& [package, ids] : by_package) {
+                if (i < ids.size() && spread.cpus.size() < threads) {
+                    spread.cpus.push_back(ids[i]);
+                }
+            }
+        }
+        spread.sockets = sockets_of(spread.cpus, *topology);
+        result.push_back(spread);
+    }
+    return result;
+}
+
+// Run a built graph on the executor; `items` reads the progress counter
+template <typename Items>
+double run_threaded(Graph& graph, std::size_t threads, const Placement& placement, std::chrono::milliseconds duration,
+                    Items&& items) {
+    ThreadedExecutor executor(graph);
+    if (executor.start(threads, {}, placement.cpus)) {
+        return 0.0;
+    }
+    std::this_thread::sleep_for(duration / 10); // Warm up
+    const auto start_items = items(executor);
+    const auto start = Clock::now();
+    std::this_thread::sleep_for(duration);
+    const auto end_items = items(executor);
+    const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    executor.stop();
+    return static_cast<double>(end_items - start_items) / seconds;
+}
+
+double run_pipeline(std::size_t threads, const Placement& placement, std::chrono::milliseconds duration) {
+    const std::size_t chains = threads;
+    std::vector<std::unique_ptr<SpscRing<std::uint64_t>>> rings;
+    std::vector<std::unique_ptr<Component>> nodes;
+    std::vector<Sink*> sinks;
+    Graph graph;
+    for (std::size_t c = 0; c < chains; ++c) {
+        auto& a = *rings.emplace_back(std::make_unique<SpscRing<std::uint64_t>>());
+        auto& b = *rings.emplace_back(std::make_unique<SpscRing<std::uint64_t>>());
+        a.allocate(ring_capacity);
+        b.allocate(ring_capacity);
+        auto source = std::make_unique<Source>(a);
+        auto stage = std::make_unique<Stage>(a, b);
+        auto sink = std::make_unique<Sink>(b);
+        sinks.push_back(sink.get());
+        const auto s = *graph.add(*source);
+        const auto m = *graph.add(*stage);
+        const auto k = *graph.add(*sink);
+        graph.connect(s, m);
+        graph.connect(m, k);
+        nodes.push_back(std::move(source));
+        nodes.push_back(std::move(stage));
+        nodes.push_back(std::move(sink));
+    }
+    for (auto& node : nodes) {
+        node->initialize();
+    }
+    graph.build();
+    return run_threaded(graph, threads, placement, duration, [&](const ThreadedExecutor&) {
+        std::uint64_t total = 0;
+        for (auto* sink : sinks) {
+            total += sink->items();
+        }
+        return total;
+    });
+}
+
+double run_soa(std::size_t threads, const Placement& placement, std::chrono::milliseconds duration) {
+    std::vector<std::unique_ptr<Lanes>> arrays;
+    Graph graph;
+    for (std::size_t i = 0; i < threads; ++i) {
+        auto& lanes = *arrays.emplace_back(std::make_unique<Lanes>());
+        lanes.initialize();
+        graph.add(lanes);
+    }
+    graph.build();
+    return run_threaded(graph, threads, placement, duration, [&](const ThreadedExecutor& executor) {
+        std::uint64_t steps = 0;
+        for (NodeId id = 0; id < graph.size(); ++id) {
+            steps += executor.steps(id);
+        }
+        return steps * Lanes::lanes;
+    });
+}
+
+// Rounds of 4 tasks per thread, each running a component for a slice of steps
+double run_pool(std::size_t threads, std::chrono::milliseconds duration, double& retries_per_op) {
+    constexpr std::uint32_t steps_per_task = 32;
+    MpmcQueue<std::uint64_t> results;
+    results.allocate(4096);
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (std::size_t i = 0; i < 4 * threads; ++i) {
+        workers.push_back(std::make_unique<Worker>(i + 1, results));
+        workers.back()->initialize();
+    }
+    ThreadPool pool;
+    if (pool.start(threads)) {
+        return 0.0;
+    }
+
+    std::uint64_t drained = 0;
+    std::uint64_t steps = 0;
+    const auto start = Clock::now();
+    const auto deadline = start + duration;
+    std::uint64_t value = 0;
+    while (Clock::now() < deadline) {
+        std::atomic<std::size_t> remaining{workers.size()};
+        for (auto& worker : workers) {
+            pool.submit([&remaining, component = worker.get()] {
+                for (std::uint32_t s = 0; s < steps_per_task; ++s) {
+                    component->execute();
+                }
+                remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        while (remaining.load(std::memory_order_acquire) != 0) {
+            while (results.try_pop(value)) {
+                drained++;
+            }
+            std::this_thread::yield();
+        }
+        steps += workers.size() * steps_per_task;
+    }
+    const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    pool.stop();
+    // Producers only: the drain loop above pops concurrently and its retries are not pushes
+    retries_per_op =
+        static_cast<double>(results.push_retries()) / static_cast<double>(std::max<std::uint64_t>(steps, 1));
+    return static_cast<double>(steps) / seconds;
+}
+
+// Per-thread counters in one cache line (packed) or one line each (padded)
+template <typename Counter>
+double run_counters(std::size_t threads, std::chrono::milliseconds duration) {
+    std::vector<Counter> counters(threads);
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> pool;
+    for (std::size_t t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            auto& value = counters[t].value;
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (int i = 0; i < 1024; ++i) {
+                    value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    std::this_thread::sleep_for(duration);
+    stop = true;
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    std::uint64_t total = 0;
+    for (auto& counter : counters) {
+        total += counter.value.load();
+    }
+    return static_cast<double>(total) / std::chrono::duration<double>(duration).count();
+}
+
+struct Packed {
+    std::atomic<std::uint64_t> value{0};
+};
+
+struct alignas(cache_line_size) Padded {
+    std::atomic<std::uint64_t> value{0};
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::chrono::milliseconds duration(200);
+    bool json = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            max_threads = std::max<std::size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--duration-ms") == 0 && i + 1 < argc) {
+            duration = std::chrono::milliseconds(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else {
+            std::fprintf(stderr, "Usage: %s [--threads N] [--duration-ms D] [--json]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<std::size_t> counts;
+    for (std::size_t t = 1; t < max_threads; t *= 2) {
+        counts.push_back(t);
+    }
+    counts.push_back(max_threads);
+
+    auto topology = discover_topology();
+    const CpuTopology* topo = topology ? &*topology : nullptr;
+
+    std::vector<Row> rows;
+    std::vector<std::string> hotspots;
+    char note[192];
+    auto add = [&](Row row) {
+        // Efficiency against the 1-thread run of the same workload and executor
+        for (const auto& base : rows) {
+            if (base.workload == row.workload && base.executor == row.executor && base.threads == 1 &&
+                base.throughput > 0.0) {
+                row.efficiency = row.throughput / (static_cast<double>(row.threads) * base.throughput);
+                break;
+            }
+        }
+        if (row.threads == 1) {
+            row.efficiency = 1.0;
+        }
+        rows.push_back(row);
+    };
+
+    for (auto threads : counts) {
+        for (const auto& placement : placements(topo, threads)) {
+            add({"pipeline", "threaded", threads, placement.name, placement.sockets,
+                 run_pipeline(threads, placement, duration), 0.0, 0.0});
+            add({"soa", "threaded", threads, placement.name, placement.sockets, run_soa(threads, placement, duration),
+                 0.0, 0.0});
+        }
+        double retries = 0.0;
+        const double pool = run_pool(threads, duration, retries);
+        add({"independent", "pool", threads, "os", 0, pool, 0.0, retries});
+        add({"calibration", "packed", threads, "os", 0, run_counters<Packed>(threads, duration), 0.0, 0.0});
+        add({"calibration", "padded", threads, "os", 0, run_counters<Padded>(threads, duration), 0.0, 0.0});
+    }
+
+    // Hotspots
+    std::set<std::string> knees;
+    for (const auto& row : rows) {
+        const auto series = row.workload + "/" + row.executor + "/" + row.placement;
+        // The calibration probe only feeds the false-sharing note below
+        if (row.workload != "calibration" && row.threads > 1 && row.efficiency > 0.0 && row.efficiency < 0.7 &&
+            knees.insert(series).second) {
+            std::snprintf(note, sizeof(note), "%s stops scaling at %zu threads (efficiency %.0f%%)", series.c_str(),
+                          row.threads, row.efficiency * 100.0);
+            hotspots.push_back(note);
+        }
+        if (row.retries_per_op > 0.05) {
+            std::snprintf(note, sizeof(note), "MpmcQueue push contention: %.2f CAS retries per push at %zu threads",
+                          row.retries_per_op, row.threads);
+            hotspots.push_back(note);
+        }
+        for (const auto& other : rows) {
+            if (row.placement == "spread" && other.placement == "compact" && other.workload == row.workload &&
+                other.threads == row.threads && row.throughput < 0.8 * other.throughput) {
+                std::snprintf(note, sizeof(note), "%s: cross-socket placement %.0f%% slower at %zu threads",
+                              row.workload.c_str(), (1.0 - row.throughput / other.throughput) * 100.0, row.threads);
+                hotspots.push_back(note);
+            }
+            if (row.executor == "packed" && other.executor == "padded" && other.threads == row.threads &&
+                row.threads > 1 && row.throughput < 0.7 * other.throughput) {
+                std::snprintf(note, sizeof(note),
+                              "calibration probe (synthetic counters): false sharing makes packed per-thread "
+                              "counters %.1fx slower than padded at %zu threads",
+                              other.throughput / std::max(row.throughput, 1.0), row.threads);
+                hotspots.push_back(note);
+            }
+        }
+    }
+
+    if (json) {
+        std::printf("{\n  \"hardware_threads\": %u,\n  \"sockets\": %u,\n  \"results\": [\n",
+                    std::thread::hardware_concurrency(), topo ? topo->packages : 0);
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            const auto& r = rows[i];
+            std::printf("    {\"workload\": \"%s\", \"executor\": \"%s\", \"threads\": %zu, \"placement\": \"%s\", "
+                        "\"sockets\": %u, \"throughput\": %.0f, \"efficiency\": %.3f, \"push_retries_per_op\": %.4f}%s\n",
+                        r.workload.c_str(), r.executor.c_str(), r.threads, r.placement.c_str(), r.sockets,
+                        r.throughput, r.efficiency, r.retries_per_op, i + 1 < rows.size() ? "," : "");
+        }
+        std::printf("  ],\n  \"hotspots\": [");
+        for (std::size_t i = 0; i < hotspots.size(); ++i) {
+            std::printf("%s\n    \"%s\"", i ? "," : "", hotspots[i].c_str());
+        }
+        std::printf("%s]\n}\n", hotspots.empty() ? "" : "\n  ");
+    } else {
+        std::printf("workload,executor,threads,placement,sockets,throughput,efficiency,push_retries_per_op\n");
+        for (const auto& r : rows) {
+            std::printf("%s,%s,%zu,%s,%u,%.0f,%.3f,%.4f\n", r.workload.c_str(), r.executor.c_str(), r.threads,
+                        r.placement.c_str(), r.sockets, r.throughput, r.efficiency, r.retries_per_op);
+        }
+        for (const auto& hotspot : hotspots) {
+            std::printf("# hotspot: %s\n", hotspot.c_str());
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <dspai/comp/execution.hpp>
+#include <dspai/comp/thread_pool.hpp>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <span>
+
+namespace dspai::comp {
+
+/**
+ * How AsyncInit performs the wrapped component's initialize()
+ *
+ */
+enum class InitMode {
+    Eager, ///< initialize() runs inline (same as calling the component directly)
+    Async, ///< initialize() queues the work on a ThreadPool and returns immediately
+    Lazy   ///< initialize() is deferred until the first execute() (first data)
+};
+
+/**
+ * Asynchronous / lazy initialization wrapper for a component
+ *
+ * Lets expensive initialize() work (model loads, large filter designs) run off the streaming
+ * thread so the rest of the graph can start processing as soon as its critical path is ready.
+ * - Async: initialize() submits the component's initialize() to the pool and returns empty
+ *   once queued. The wrapper stays Uninitialized until the work completes, then becomes
+ *   Initialized (or Uninitialized again on failure, so initialize() may be retried).
+ * - Lazy: initialize() only arms the wrapper. The first execute() starts the real
+ *   initialization: on the pool if one was given (execute() returns false until ready),
+ *   otherwise inline in that execute() call.
+ * - While not Initialized the IExecution no-op behavior applies: execute() returns false,
+ *   count() is 0, execution_state() is Reset.
+ * - ready() returns a future completed with the result of the component's initialize().
+ * - terminate() and the destructor wait for pending initialization before tearing down.
+ *
+ * Thread Safety: the wrapped component is touched by the pool thread only while
+ * initialization is pending, and by the owner thread only after lifecycle_state() reports
+ * Initialized (acquire/release handoff). lifecycle_state() and ready() may be called from any
+ * thread; all other methods from the owner thread only.
+ */
+class AsyncInit : public IExecution {
+public:
+    /**
+     * @param component: wrapped component; must outlive this wrapper
+     * @param mode: initialization mode
+     * @param pool: worker pool; required for Async, optional for Lazy, unused for Eager
+     */
+    AsyncInit(IExecution& component, InitMode mode, ThreadPool* pool = nullptr) noexcept
+        : component_(&component), mode_(mode), pool_(pool) {}
+
+    ~AsyncInit() noexcept override { wait(); }
+
+    InitMode mode() const noexcept { return mode_; }
+
+    /// Initialization requested but not yet complete
+    bool pending() const noexcept {
+        const auto phase = phase_.load(std::memory_order_acquire);
+        return phase == Phase::Deferred || phase == Phase::Pending;
+    }
+
+    /**
+     * @brief Future completed with the wrapped component's initialize() result
+     *
+     * Invalid (valid() == false) before initialize() has been called.
+     */
+    std::shared_future<std::error_code> ready() const noexcept { return ready_; }
+
+    /**
+     * @brief Block until pending asynchronous initialization completes
+     *
+     * Does not trigger a deferred (Lazy) initialization.
+     */
+    void wait() const noexcept {
+        if (phase_.load(std::memory_order_acquire) == Phase::Pending) {
+            ready_.wait();
+        }
+    }
+
+    // ILifecycle interface
+    LifecycleState lifecycle_state() const noexcept override {
+        switch (phase_.load(std::memory_order_acquire)) {
+        case Phase::Ready:
+            return LifecycleState::Initialized;
+        case Phase::Terminated:
+            return LifecycleState::Terminated;
+        default:
+            return LifecycleState::Uninitialized;
+        }
+    }
+
+    /**
+     * @brief Start (Async), defer (Lazy) or perform (Eager) initialization
+     *
+     * @return std::error_code - empty on success (Async/Lazy: once queued/armed)
+     *         - operation_not_permitted if already initialized, pending or terminated
+     *         - invalid_argument if mode is Async and no pool was given
+     *         - not_enough_memory if the readiness future cannot be created
+     *         - Eager: any error from the component's initialize()
+     *         - Async: any error from ThreadPool::submit()
+     */
+    std::error_code initialize() noexcept override {
+        const auto phase = phase_.load(std::memory_order_acquire);
+        if (phase != Phase::Idle) {
+            return std::make_error_code(std::errc::operation_not_permitted);
+        }
+        if (mode_ == InitMode::Async && pool_ == nullptr) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+        if (auto ec = arm()) {
+            return ec;
+        }
+
+        switch (mode_) {
+        case InitMode::Eager:
+            run_initialize(promise_);
+            return ready_.get();
+        case InitMode::Async:
+            return launch();
+        case InitMode::Lazy:
+            phase_.store(Phase::Deferred, std::memory_order_release);
+            return {};
+        }
+        return {};
+    }
+
+    void terminate() noexcept override {
+        if (phase_.load(std::memory_order_acquire) == Phase::Terminated) {
+            return; // Idempotent
+        }
+        wait();
+        if (phase_.load(std::memory_order_acquire) == Phase::Deferred) {
+            complete(promise_, Phase::Idle, std::make_error_code(std::errc::operation_canceled));
+        }
+        component_->terminate();
+        phase_.store(Phase::Terminated, std::memory_order_release);
+    }
+
+    // IExecution interface
+    ExecutionState execution_state() const noexcept override {
+        switch (phase_.load(std::memory_order_acquire)) {
+        case Phase::Ready:
+            return component_->execution_state();
+        case Phase::Terminated:
+            return ExecutionState::Done;
+        default:
+            return ExecutionState::Reset;
+        }
+    }
+
+    std::uint64_t count() const noexcept override {
+        return phase_.load(std::memory_order_acquire) == Phase::Ready ? component_->count() : 0;
+    }
+
+    /**
+     * @brief Execute one step of the wrapped component
+     *
+     * A Lazy wrapper starts initialization on its first call.
+     */
+    bool execute() noexcept override {
+        auto phase = phase_.load(std::memory_order_acquire);
+        if (phase == Phase::Deferred) {
+            if (pool_ != nullptr) {
+                launch();
+                return false;
+            }
+            run_initialize(promise_);
+            phase = phase_.load(std::memory_order_acquire);
+        }
+        if (phase != Phase::Ready) {
+            return false;
+        }
+        return component_->execute();
+    }
+
+    void reset() noexcept override {
+        if (phase_.load(std::memory_order_acquire) == Phase::Ready) {
+            component_->reset();
+        }
+    }
+
+    std::error_code last_error() const noexcept override {
+        return phase_.load(std::memory_order_acquire) == Phase::Ready ? component_->last_error() : std::error_code{};
+    }
+
+private:
+    enum class Phase { Idle, Deferred, Pending, Ready, Terminated };
+    using Promise = std::shared_ptr<std::promise<std::error_code>>;
+
+    // Create a fresh promise/future pair for this initialization attempt
+    std::error_code arm() noexcept {
+        try {
+            promise_ = std::make_shared<std::promise<std::error_code>>();
+            ready_ = promise_->get_future().share();
+        } catch (...) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        return {};
+    }
+
+    std::error_code launch() noexcept {
+        phase_.store(Phase::Pending, std::memory_order_release);
+        std::error_code ec;
+        try {
+            ec = pool_->submit([this, promise = promise_] { run_initialize(promise); });
+        } catch (...) {
+            ec = std::make_error_code(std::errc::not_enough_memory);
+        }
+        if (ec) {
+            complete(promise_, Phase::Idle, ec);
+        }
+        return ec;
+    }
+
+    void run_initialize(const Promise& promise) noexcept {
+        const auto ec = component_->initialize();
+        complete(promise, ec ? Phase::Idle : Phase::Ready, ec);
+    }
+
+    // Publish the phase before completing the future so waiters observe it. The wrapper
+    // may be destroyed right after the phase store, so only the shared promise is used after.
+    void complete(const Promise& promise, Phase phase, std::error_code result) noexcept {
+        auto keep = promise;
+        phase_.store(phase, std::memory_order_release);
+        try {
+            keep->set_value(result);
+        } catch (...) {
+        }
+    }
+
+    IExecution* component_;
+    InitMode mode_;
+    ThreadPool* pool_;
+    std::atomic<Phase> phase_{Phase::Idle};
+    Promise promise_;
+    std::shared_future<std::error_code> ready_;
+};
+
+/**
+ * @brief Wait until all components on the critical path are initialized
+ *
+ * Blocks on pending asynchronous initializations; deferred (Lazy) components are skipped.
+ *
+ * @return std::error_code - empty if every waited-on component initialized successfully,
+ *         otherwise the first failure
+ */
+inline std::error_code wait_ready(std::span<AsyncInit* const> components) noexcept {
+    std::error_code first;
+    for (auto* component : components) {
+        component->wait();
+        if (!first && !component->pending() && component->lifecycle_state() == LifecycleState::Uninitialized) {
+            auto future = component->ready();
+            if (future.valid()) {
+                first = future.get();
+            }
+        }
+    }
+    return first;
+}
+
+} // namespace dspai::comp
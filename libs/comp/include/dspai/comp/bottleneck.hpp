@@ -0,0 +1,290 @@
+#pragma once
+
+#include <dspai/comp/clock.hpp>
+#include <dspai/comp/executor.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <expected>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace dspai::comp {
+
+/**
+ * Bottleneck analyzer configuration
+ *
+ */
+struct BottleneckConfig {
+    double full = 0.9;          ///< Backlog fill (0..1) at which the producer counts as blocked
+    double tolerance = 0.1;     ///< Stages scoring within this fraction of the top score are also limiting
+    double speedup_factor = 2.0; ///< Stage speedup assumed by StageAnalysis::speedup (e.g. 2 workers)
+};
+
+/**
+ * Measurements and verdict for one node over the analysis window
+ *
+ */
+struct StageAnalysis {
+    NodeId node = 0;
+    double utilization = 0.0; ///< Share of wall time spent in the node's steps
+    double starved = 0.0;     ///< Fraction of samples with its input backlog empty
+    double blocked = 0.0;     ///< Fraction of samples with a downstream backlog at `full`
+    double fill = 0.0;        ///< Mean input backlog fill (0..1)
+    double trend = 0.0;       ///< Input fill change over the window (least-squares), -1..1
+    double effective = 0.0;   ///< Productive load: utilization * (1 - starved) * (1 - blocked)
+    double score = 0.0;       ///< Bottleneck score: (1 - blocked) * max(utilization * (1 - starved), pressure)
+    double speedup = 1.0;     ///< Estimated graph speedup if this stage ran speedup_factor times faster
+    double ceiling = 1.0;     ///< Estimated graph speedup if this stage cost nothing
+    bool limiting = false;    ///< Among the throughput-limiting stages
+};
+
+/**
+ * Result of BottleneckAnalyzer::analyze()
+ *
+ */
+struct BottleneckReport {
+    std::vector<StageAnalysis> stages; ///< Indexed by NodeId
+    NodeId critical = 0;               ///< Highest-scoring stage
+    std::size_t samples = 0;
+    std::chrono::nanoseconds window{0};
+};
+
+/**
+ * Identifies the throughput-limiting stage(s) of a graph running on a ThreadedExecutor
+ *
+ * sample(), called periodically from a control thread, reads each node's busy ticks and the
+ * backlog of every node with NodeOptions::backlog and backlog_capacity (the same probes
+ * LoadShedder uses). analyze() then combines, per node:
+ * - utilization: busy ticks / wall time. Spinning on an empty input also counts as busy, which
+ *   is why starved time is factored out.
+ * - starved: its own backlog was empty; blocked: some downstream backlog was at `full`, so
+ *   its rate is set by that consumer.
+ * - pressure: mean input fill plus its trend over the window, so a queue that is still
+ *   filling up scores like one that is already full.
+ * The stage with the highest score, (1 - blocked) * max(utilization * (1 - starved), pressure),
+ * is critical; stages within `tolerance` of it are limiting too.
+ *
+ * Speedup estimates assume every stage handles the same item rate, so stage j can sustain at
+ * most 1 / effective_j times the current rate. Making stage i k times faster gives
+ * min(k / effective_i, min over j != i of 1 / effective_j). Blocked stages hide their true
+ * capacity, so the estimates are upper bounds.
+ *
+ * Thread Safety: sample()/analyze()/restart() from one control thread while the executor runs.
+ */
+class BottleneckAnalyzer {
+public:
+    explicit BottleneckAnalyzer(ThreadedExecutor& executor, BottleneckConfig config = {}) noexcept
+        : executor_(&executor), config_(config) {}
+
+    /**
+     * @brief Record one sample of busy ticks and backlogs
+     *
+     * The first sample after construction or restart() is the baseline of the window.
+     *
+     * @return std::error_code - empty on success
+     *         - operation_not_permitted if the executor is not running
+     *         - not_enough_memory
+     */
+    std::error_code sample() noexcept {
+        if (!executor_->running()) {
+            return std::make_error_code(std::errc::operation_not_permitted);
+        }
+        const auto& graph = executor_->graph();
+        const auto now = TickClock::now();
+        const auto n = graph.size();
+        if (nodes_.size() != n) {
+            try {
+                nodes_.assign(n, NodeSamples{});
+                fill_.assign(n, -1.0);
+            } catch (...) {
+                nodes_.clear();
+                return std::make_error_code(std::errc::not_enough_memory);
+            }
+            samples_ = 0;
+        }
+        if (samples_ == 0) {
+            std::fill(nodes_.begin(), nodes_.end(), NodeSamples{});
+            first_ = now;
+        }
+        last_ = now;
+
+        const double t = static_cast<double>(now - first_);
+        for (NodeId id = 0; id < n; ++id) {
+            const auto& options = graph.options(id);
+            fill_[id] = -1.0;
+            if (options.backlog && options.backlog_capacity > 0) {
+                const auto depth = options.backlog();
+                fill_[id] = std::min(1.0, static_cast<double>(depth) / static_cast<double>(options.backlog_capacity));
+                auto& node = nodes_[id];
+                node.starved += depth == 0;
+                node.sum_f += fill_[id];
+                node.sum_t += t;
+                node.sum_tt += t * t;
+                node.sum_tf += t * fill_[id];
+            }
+        }
+        for (NodeId id = 0; id < n; ++id) {
+            auto& node = nodes_[id];
+            const auto ticks = executor_->node_ticks(id);
+            if (samples_ == 0) {
+                node.first_ticks = ticks;
+            }
+            node.last_ticks = ticks;
+            for (auto to : graph.downstream(id)) {
+                if (fill_[to] >= config_.full) {
+                    node.blocked++;
+                    break;
+                }
+            }
+        }
+        samples_++;
+        return {};
+    }
+
+    /// Start a new analysis window at the next sample()
+    void restart() noexcept { samples_ = 0; }
+
+    /// Samples in the current window
+    std::size_t samples() const noexcept { return samples_; }
+
+    /**
+     * @brief Analyze the current window
+     *
+     * @return the report, or
+     *         - resource_unavailable_try_again if fewer than two samples were taken
+     *         - not_enough_memory
+     */
+    std::expected<BottleneckReport, std::error_code> analyze() const noexcept {
+        if (samples_ < 2 || last_ <= first_) {
+            return std::unexpected(std::make_error_code(std::errc::resource_unavailable_try_again));
+        }
+        BottleneckReport report;
+        try {
+            report.stages.resize(nodes_.size());
+        } catch (...) {
+            return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+        }
+        const auto& graph = executor_->graph();
+        const double elapsed = static_cast<double>(last_ - first_);
+        const double count = static_cast<double>(samples_);
+        report.samples = samples_;
+        report.window = TickClock::to_duration(last_ - first_);
+
+        for (NodeId id = 0; id < nodes_.size(); ++id) {
+            const auto& node = nodes_[id];
+            auto& stage = report.stages[id];
+            stage.node = id;
+            const auto busy = node.last_ticks >= node.first_ticks ? node.last_ticks - node.first_ticks : node.last_ticks;
+            stage.utilization = std::min(1.0, static_cast<double>(busy) / elapsed);
+            stage.blocked = static_cast<double>(node.blocked) / count;
+
+            double pressure = 0.0;
+            const auto& options = graph.options(id);
+            if (options.backlog && options.backlog_capacity > 0) {
+                stage.starved = static_cast<double>(node.starved) / count;
+                stage.fill = node.sum_f / count;
+                const double variance = count * node.sum_tt - node.sum_t * node.sum_t;
+                if (variance > 0.0) {
+                    const double slope = (count * node.sum_tf - node.sum_t * node.sum_f) / variance;
+                    stage.trend = std::clamp(slope * elapsed, -1.0, 1.0);
+                }
+                pressure = std::clamp(stage.fill + std::max(stage.trend, 0.0), 0.0, 1.0);
+            }
+            stage.effective = stage.utilization * (1.0 - stage.starved) * (1.0 - stage.blocked);
+            stage.score = (1.0 - stage.blocked) * std::max(stage.utilization * (1.0 - stage.starved), pressure);
+            if (stage.score > report.stages[report.critical].score) {
+                report.critical = id;
+            }
+        }
+
+        const double top = report.stages.empty() ? 0.0 : report.stages[report.critical].score;
+        for (auto& stage : report.stages) {
+            stage.limiting = top > 0.0 && stage.score >= top * (1.0 - config_.tolerance);
+            double others = std::numeric_limits<double>::infinity();
+            for (const auto& other : report.stages) {
+                if (other.node != stage.node) {
+                    others = std::min(others, headroom(other.effective, 1.0));
+                }
+            }
+            // Normalized to the current rate, which the busiest stage sets
+            const double current = std::min(others, headroom(stage.effective, 1.0));
+            stage.speedup = std::min(others, headroom(stage.effective, config_.speedup_factor)) / current;
+            stage.ceiling = others / current;
+            if (!(stage.speedup < std::numeric_limits<double>::infinity())) {
+                stage.speedup = stage.ceiling = 1.0; // Nothing measurably busy
+            }
+        }
+        return report;
+    }
+
+private:
+    struct NodeSamples {
+        std::uint64_t first_ticks = 0;
+        std::uint64_t last_ticks = 0;
+        std::size_t starved = 0;
+        std::size_t blocked = 0;
+        double sum_f = 0.0; // Least-squares sums of fill over sample time
+        double sum_t = 0.0;
+        double sum_tt = 0.0;
+        double sum_tf = 0.0;
+    };
+
+    // Relative rate a stage could sustain when made `factor` times faster
+    static double headroom(double effective, double factor) noexcept {
+        return effective > 0.0 ? factor / effective : std::numeric_limits<double>::infinity();
+    }
+
+    ThreadedExecutor* executor_;
+    BottleneckConfig config_;
+    std::vector<NodeSamples> nodes_;
+    std::vector<double> fill_; // Scratch: fill per node in the current sample, -1 without probe
+    std::size_t samples_ = 0;
+    std::uint64_t first_ = 0;
+    std::uint64_t last_ = 0;
+};
+
+/**
+ * @brief Human-readable bottleneck report, one line per node, critical stage first
+ *
+ * Empty on allocation failure.
+ */
+inline std::string format_bottleneck_report(const BottleneckReport& report, const Graph& graph) noexcept {
+    try {
+        std::string out;
+        char line[192];
+        std::snprintf(line, sizeof(line), "window %.3f ms, %zu samples\n",
+                      static_cast<double>(report.window.count()) / 1e6, report.samples);
+        out += line;
+        std::snprintf(line, sizeof(line), "  %-20s %6s %7s %7s %6s %7s %6s %8s %8s\n", "stage", "util", "starved",
+                      "blocked", "fill", "trend", "score", "speedup", "ceiling");
+        out += line;
+
+        std::vector<NodeId> order;
+        order.reserve(report.stages.size());
+        for (const auto& stage : report.stages) {
+            order.push_back(stage.node);
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&](NodeId a, NodeId b) { return report.stages[a].score > report.stages[b].score; });
+        for (auto id : order) {
+            const auto& stage = report.stages[id];
+            const auto& name = graph.options(id).name;
+            const auto label = name.empty() ? "#" + std::to_string(id) : name;
+            std::snprintf(line, sizeof(line), "%c %-20s %6.2f %7.2f %7.2f %6.2f %+7.2f %6.2f %7.2fx %7.2fx\n",
+                          id == report.critical ? '*' : stage.limiting ? '+' : ' ', label.c_str(), stage.utilization,
+                          stage.starved, stage.blocked, stage.fill, stage.trend, stage.score, stage.speedup,
+                          stage.ceiling);
+            out += line;
+        }
+        return out;
+    } catch (...) {
+        return {};
+    }
+}
+
+} // namespace dspai::comp
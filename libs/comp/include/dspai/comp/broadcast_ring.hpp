@@ -0,0 +1,270 @@
+#pragma once
+
+#include <dspai/comp/spsc_ring.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <system_error>
+#include <type_traits>
+
+namespace dspai::comp {
+
+/**
+ * How a BroadcastRing treats a consumer that falls behind
+ */
+enum class BroadcastPolicy {
+    Throttle, ///< Producer waits for this consumer (no data loss)
+    Lossy     ///< Producer overwrites unread data; consumer skips ahead and counts drops
+};
+
+/**
+ * Bounded single-producer multi-consumer broadcast ring
+ *
+ * The producer writes each element once; every attached consumer reads every element
+ * through its own cursor, so fan-out costs no copies.
+ * - Lock-free. Storage and consumer slots are allocated once by allocate(), normally from
+ *   doInitialize(); push/read never allocate.
+ * - Throttle consumers bound the producer: free space is limited by the slowest of them.
+ * - Lossy consumers (monitoring taps) never block the producer. When overrun they skip to
+ *   the oldest retained element and count the skipped elements in dropped().
+ *   Their reads are validated after the fact (seqlock style): consume() returns false and
+ *   read() retries when the producer overwrote the region while it was being read.
+ * - Each consumer cursor lives on its own cache line.
+ *
+ * Thread Safety: producer-side methods from one thread; each consumer id from one thread.
+ * allocate(), attach() and detach() require external synchronization (setup time).
+ */
+template <typename T>
+class BroadcastRing {
+    static_assert(std::is_trivially_copyable_v<T>, "BroadcastRing requires trivially copyable elements");
+    static_assert(std::is_default_constructible_v<T>, "BroadcastRing requires default constructible elements");
+
+public:
+    BroadcastRing() = default;
+    BroadcastRing(const BroadcastRing&) = delete;
+    BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+    /**
+     * @brief Allocate storage for capacity elements and up to max_consumers consumers
+     *
+     * - Capacity is rounded up to a power of two.
+     * - Detaches all consumers and discards contents.
+     *
+     * @return std::error_code - invalid_argument for zero sizes, not_enough_memory on failure
+     */
+    std::error_code allocate(std::size_t capacity, std::size_t max_consumers) noexcept {
+        if (capacity == 0 || max_consumers == 0 || capacity > (std::size_t{1} << 62)) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+        const std::size_t size = std::bit_ceil(capacity);
+        std::unique_ptr<T[]> buffer(new (std::nothrow) T[size]);
+        std::unique_ptr<Consumer[]> consumers(new (std::nothrow) Consumer[max_consumers]);
+        if (!buffer || !consumers) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        buffer_ = std::move(buffer);
+        consumers_ = std::move(consumers);
+        max_consumers_ = max_consumers;
+        mask_ = size - 1;
+        head_.store(0, std::memory_order_relaxed);
+        claim_.store(0, std::memory_order_relaxed);
+        cached_min_ = 0;
+        return {};
+    }
+
+    std::size_t capacity() const noexcept { return buffer_ ? mask_ + 1 : 0; }
+    std::size_t max_consumers() const noexcept { return max_consumers_; }
+
+    /**
+     * @brief Attach a consumer; it receives elements written from now on
+     *
+     * @return consumer id, or not_enough_memory when all slots are in use
+     */
+    std::expected<std::size_t, std::error_code> attach(BroadcastPolicy policy = BroadcastPolicy::Throttle) noexcept {
+        for (std::size_t id = 0; id < max_consumers_; ++id) {
+            auto& consumer = consumers_[id];
+            if (!consumer.active.load(std::memory_order_relaxed)) {
+                const auto head = head_.load(std::memory_order_relaxed);
+                consumer.cursor.store(head, std::memory_order_relaxed);
+                consumer.policy = policy;
+                consumer.dropped = 0;
+                consumer.active.store(true, std::memory_order_release);
+                cached_min_ = std::min(cached_min_, head);
+                return id;
+            }
+        }
+        return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+    }
+
+    /// Detach a consumer; it no longer throttles the producer
+    void detach(std::size_t id) noexcept {
+        if (id < max_consumers_) {
+            consumers_[id].active.store(false, std::memory_order_release);
+        }
+    }
+
+    // Producer side
+
+    /// Contiguous free region of at most max elements for zero-copy writes; publish with commit()
+    std::span<T> writable(std::size_t max = std::numeric_limits<std::size_t>::max()) noexcept {
+        if (!buffer_) {
+            return {};
+        }
+        const auto head = head_.load(std::memory_order_relaxed);
+        const std::size_t size = mask_ + 1;
+        std::size_t free = size - static_cast<std::size_t>(head - cached_min_);
+        if (free < size / 2) {
+            // Refresh the slowest consumer only when running low on space
+            cached_min_ = slowest_throttle(head);
+            free = size - static_cast<std::size_t>(head - cached_min_);
+        }
+        const std::size_t index = static_cast<std::size_t>(head & mask_);
+        const std::size_t n = std::min({free, size - index, max});
+
+        // Announce the overwrite before touching the slots (validated by lossy readers)
+        claim_.store(head + n, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return {buffer_.get() + index, n};
+    }
+
+    /// Publish n elements written into writable()
+    void commit(std::size_t n) noexcept {
+        head_.store(head_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    /// Push one element; returns false if a throttling consumer has no room
+    bool try_push(const T& value) noexcept {
+        auto region = writable(1);
+        if (region.empty()) {
+            return false;
+        }
+        region[0] = value;
+        commit(1);
+        return true;
+    }
+
+    /// Push as many elements as fit; returns the number pushed
+    std::size_t write(std::span<const T> values) noexcept {
+        std::size_t total = 0;
+        for (int pass = 0; pass < 2 && total < values.size(); ++pass) {
+            auto region = writable(values.size() - total);
+            const std::size_t n = region.size();
+            std::copy_n(values.data() + total, n, region.data());
+            commit(n);
+            total += n;
+        }
+        return total;
+    }
+
+    // Consumer side
+
+    /// Elements available to consumer id
+    std::size_t size(std::size_t id) const noexcept {
+        const auto head = head_.load(std::memory_order_acquire);
+        const auto cursor = consumers_[id].cursor.load(std::memory_order_relaxed);
+        return static_cast<std::size_t>(std::min<std::uint64_t>(head - cursor, mask_ + 1));
+    }
+
+    /// Contiguous readable region of consumer id; release with consume()
+    std::span<const T> readable(std::size_t id) noexcept {
+        auto& consumer = consumers_[id];
+        auto cursor = consumer.cursor.load(std::memory_order_relaxed);
+        if (consumer.policy == BroadcastPolicy::Lossy) {
+            cursor = skip_overrun(consumer, cursor);
+        }
+        const auto head = head_.load(std::memory_order_acquire);
+        const std::size_t used = head > cursor ? static_cast<std::size_t>(head - cursor) : 0;
+        const std::size_t index = static_cast<std::size_t>(cursor & mask_);
+        return {buffer_.get() + index, std::min(used, mask_ + 1 - index)};
+    }
+
+    /**
+     * @brief Release n elements obtained from readable()
+     *
+     * @return false if consumer id is Lossy and the producer overwrote part of the region
+     *         while it was being read (discard what was read; the elements count as dropped)
+     */
+    bool consume(std::size_t id, std::size_t n) noexcept {
+        auto& consumer = consumers_[id];
+        const auto cursor = consumer.cursor.load(std::memory_order_relaxed);
+        bool valid = true;
+        if (consumer.policy == BroadcastPolicy::Lossy) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            valid = claim_.load(std::memory_order_relaxed) <= cursor + mask_ + 1;
+            if (!valid) {
+                consumer.dropped += n;
+            }
+        }
+        consumer.cursor.store(cursor + n, std::memory_order_release);
+        return valid;
+    }
+
+    /// Copy up to values.size() elements for consumer id; returns the number read
+    std::size_t read(std::size_t id, std::span<T> values) noexcept {
+        std::size_t total = 0;
+        for (int pass = 0; pass < 4 && total < values.size(); ++pass) {
+            auto region = readable(id);
+            const std::size_t n = std::min(values.size() - total, region.size());
+            if (n == 0) {
+                break;
+            }
+            std::copy_n(region.data(), n, values.data() + total);
+            if (consume(id, n)) {
+                total += n;
+            }
+        }
+        return total;
+    }
+
+    /// Elements consumer id missed because it was overrun (Lossy only)
+    std::uint64_t dropped(std::size_t id) const noexcept { return consumers_[id].dropped; }
+
+private:
+    struct alignas(cache_line_size) Consumer {
+        std::atomic<std::uint64_t> cursor{0};
+        std::atomic<bool> active{false};
+        BroadcastPolicy policy = BroadcastPolicy::Throttle;
+        std::uint64_t dropped = 0;
+    };
+
+    // Cursor of the slowest active throttling consumer (head if none)
+    std::uint64_t slowest_throttle(std::uint64_t head) const noexcept {
+        std::uint64_t slowest = head;
+        for (std::size_t id = 0; id < max_consumers_; ++id) {
+            const auto& consumer = consumers_[id];
+            if (consumer.active.load(std::memory_order_acquire) && consumer.policy == BroadcastPolicy::Throttle) {
+                slowest = std::min(slowest, consumer.cursor.load(std::memory_order_acquire));
+            }
+        }
+        return slowest;
+    }
+
+    // Move an overrun lossy cursor to the oldest element that cannot be overwritten yet
+    std::uint64_t skip_overrun(Consumer& consumer, std::uint64_t cursor) noexcept {
+        const std::uint64_t size = mask_ + 1;
+        const std::uint64_t claim = claim_.load(std::memory_order_acquire);
+        if (claim > size && cursor < claim - size) {
+            consumer.dropped += claim - size - cursor;
+            consumer.cursor.store(claim - size, std::memory_order_relaxed);
+            return claim - size;
+        }
+        return cursor;
+    }
+
+    alignas(cache_line_size) std::atomic<std::uint64_t> head_{0};
+    std::atomic<std::uint64_t> claim_{0};
+    std::uint64_t cached_min_ = 0;
+    alignas(cache_line_size) std::unique_ptr<T[]> buffer_;
+    std::unique_ptr<Consumer[]> consumers_;
+    std::size_t max_consumers_ = 0;
+    std::size_t mask_ = 0;
+};
+
+} // namespace dspai::comp
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#define DSPAI_COMP_HAS_TSC 1
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#define DSPAI_COMP_HAS_TSC 1
+#endif
+
+namespace dspai::comp {
+
+/**
+ * Cheap monotonic tick counter for hot-path time checks
+ *
+ * Reads the TSC on x86-64 (a few ns, no syscall); falls back to steady_clock nanoseconds
+ * elsewhere. Ticks are converted to time with a ratio calibrated once against steady_clock
+ * on first use (about 1 ms); Component::initialize() triggers it so the cost is paid outside
+ * the processing path. Assumes an invariant TSC (constant_tsc/nonstop_tsc), which all
+ * current x86-64 server parts provide.
+ *
+ * Thread Safety: all methods are thread-safe.
+ */
+class TickClock {
+public:
+    /// Current tick count
+    static std::uint64_t now() noexcept {
+#if defined(DSPAI_COMP_HAS_TSC)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+#endif
+    }
+
+    /// Ticks per nanosecond
+    static double ticks_per_ns() noexcept {
+        static const double ratio = calibrate();
+        return ratio;
+    }
+
+    /// Convert a duration to ticks (saturating)
+    static std::uint64_t to_ticks(std::chrono::nanoseconds duration) noexcept {
+        const auto ns = duration.count();
+        if (ns <= 0) {
+            return 0;
+        }
+        const double ticks = static_cast<double>(ns) * ticks_per_ns();
+        return ticks >= 18446744073709551615.0 ? ~std::uint64_t{0} : static_cast<std::uint64_t>(ticks);
+    }
+
+    /// Convert ticks to a duration
+    static std::chrono::nanoseconds to_duration(std::uint64_t ticks) noexcept {
+        return std::chrono::nanoseconds(static_cast<std::int64_t>(static_cast<double>(ticks) / ticks_per_ns()));
+    }
+
+    /// Absolute tick deadline `duration` from now (saturating)
+    static std::uint64_t deadline_in(std::chrono::nanoseconds duration) noexcept {
+        const auto start = now();
+        const auto ticks = to_ticks(duration);
+        return ticks > ~std::uint64_t{0} - start ? ~std::uint64_t{0} : start + ticks;
+    }
+
+private:
+    static double calibrate() noexcept {
+#if defined(DSPAI_COMP_HAS_TSC)
+        using std::chrono::steady_clock;
+        const auto t0 = steady_clock::now();
+        const auto c0 = now();
+        auto t1 = t0;
+        while (t1 - t0 < std::chrono::milliseconds(1)) {
+            t1 = steady_clock::now();
+        }
+        const auto c1 = now();
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        return ns > 0 && c1 > c0 ? static_cast<double>(c1 - c0) / static_cast<double>(ns) : 1.0;
+#else
+        return 1.0;
+#endif
+    }
+};
+
+} // namespace dspai::comp
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <dspai/comp/component.hpp>
+#include <concepts>
+#include <expected>
+#include <memory>
+#include <utility>
+
+namespace dspai::comp {
+
+/**
+ * Read-only artifact shared between a prototype and its clones (taps, tables, plans)
+ */
+template <typename T>
+using Shared = std::shared_ptr<const T>;
+
+/**
+ * @brief Create a new, already-initialized component from an initialized prototype
+ *
+ * Constructs a T from args and initializes it with initialize_from(prototype),
+ * so the clone shares the prototype's immutable artifacts instead of recomputing them.
+ * - No exceptions: allocation and constructor failures are reported as error codes.
+ * - The returned component is Initialized and in ExecutionState::Reset.
+ *
+ * @return the clone, or
+ *         - not_enough_memory if allocation or construction fails
+ *         - any error from initialize_from()
+ */
+template <std::derived_from<Component> T, typename... Args>
+std::expected<std::unique_ptr<T>, std::error_code> clone(const T& prototype, Args&&... args) noexcept {
+    std::unique_ptr<T> component;
+    try {
+        component.reset(new T(std::forward<Args>(args)...));
+    } catch (...) {
+        return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+    }
+
+    if (auto ec = component->initialize_from(prototype)) {
+        return std::unexpected(ec);
+    }
+    return component;
+}
+
+} // namespace dspai::comp
@@ -1,9 +1,21 @@
 #pragma once
 
 #include <dspai/comp/execution.hpp>
+#include <dspai/comp/memory.hpp>
+#include <dspai/comp/prefault.hpp>
+#include <typeinfo>
 
 namespace dspai::comp {
 
+/**
+ * Options for Component::warm_up()
+ *
+ */
+struct WarmupOptions {
+    bool prefault = true;             ///< Touch all allocated buffers (doPrefault())
+    std::uint32_t dry_run_steps = 16; ///< Maximum execute() calls on synthetic input (doWarmup())
+};
+
 /**
  * Base component class 
  *
@@ -29,15 +41,104 @@ public:
             return std::make_error_code(std::errc::operation_not_permitted);
         }
 
+        TickClock::ticks_per_ns(); // One-time calibration, kept off the first execute_for()
         auto result = doInitialize();
         if (!result) {
             lifecycle_state_ = LifecycleState::Initialized;
             execution_state_ = ExecutionState::Reset;
             count_ = 0;
+            error_ = {};
+        }
+        return result;
+    }
+
+    /**
+     * @brief Initialize from an already-initialized prototype
+     *
+     * Alternative to initialize() for spinning up additional instances quickly.
+     * - Only callable when LifecycleState is Uninitialized.
+     * - prototype must be Initialized and of the same dynamic type.
+     * - Shares the prototype's immutable artifacts, allocates only mutable state (see doClone()).
+     * - Same strong guarantee as initialize(); on success the clone is Initialized/Reset.
+     *
+     * @return std::error_code - empty on success
+     *         - operation_not_permitted if this component is not Uninitialized
+     *         - invalid_argument if prototype is not Initialized or of a different type
+     *         - operation_not_supported if the derived class does not implement doClone()
+     */
+    std::error_code initialize_from(const Component& prototype) noexcept {
+        if (lifecycle_state_ != LifecycleState::Uninitialized) {
+            return std::make_error_code(std::errc::operation_not_permitted);
+        }
+        if (&prototype == this || prototype.lifecycle_state_ != LifecycleState::Initialized ||
+            typeid(prototype) != typeid(*this)) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+
+        auto result = doClone(prototype);
+        if (!result) {
+            lifecycle_state_ = LifecycleState::Initialized;
+            execution_state_ = ExecutionState::Reset;
+            count_ = 0;
+            error_ = {};
         }
         return result;
     }
 
+    /**
+     * @brief Warm up a freshly initialized component
+     *
+     * Moves first-call costs (page faults, cold caches, cold branch predictors) out of the
+     * first real execute() so latency is at steady state from the start.
+     * - Only callable when Initialized and in ExecutionState::Reset.
+     * - Pre-faults buffers via doPrefault() if options.prefault.
+     * - If doWarmup() installs synthetic input, runs up to options.dry_run_steps execute()
+     *   calls (stopping early on Done), then reset().
+     * - On return the component is in ExecutionState::Reset with count() == 0.
+     *
+     * @return std::error_code - empty on success
+     *         - operation_not_permitted if not Initialized or not in ExecutionState::Reset
+     */
+    std::error_code warm_up(const WarmupOptions& options = {}) noexcept {
+        if (lifecycle_state_ != LifecycleState::Initialized || execution_state_ != ExecutionState::Reset) {
+            return std::make_error_code(std::errc::operation_not_permitted);
+        }
+
+        if (options.prefault) {
+            doPrefault();
+        }
+        if (options.dry_run_steps > 0 && doWarmup()) {
+            for (std::uint32_t i = 0; i < options.dry_run_steps; ++i) {
+                if (execute()) {
+                    break;
+                }
+            }
+            reset(); // doReset() discards the synthetic input
+        }
+        return {};
+    }
+
+    /**
+     * @brief Attribute this component's allocations to account
+     *
+     * - Only callable when LifecycleState is Uninitialized; nullptr detaches.
+     * - doInitialize() allocations made through memory() are charged to account; if that
+     *   takes it (or an ancestor) past its budget, initialize() fails with not_enough_memory.
+     * - account must outlive the component's allocations (until terminate()).
+     *
+     * @return std::error_code - empty on success
+     *         - operation_not_permitted if this component is not Uninitialized
+     */
+    std::error_code set_memory_account(MemoryAccount* account) noexcept {
+        if (lifecycle_state_ != LifecycleState::Uninitialized) {
+            return std::make_error_code(std::errc::operation_not_permitted);
+        }
+        memory_account_ = account;
+        return {};
+    }
+
+    MemoryAccount* memory_account() const noexcept { return memory_account_; }
+
     void terminate() noexcept override {
         if (lifecycle_state_ == LifecycleState::Terminated) {
             return; // Idempotent
@@ -47,6 +148,7 @@ public:
         lifecycle_state_ = LifecycleState::Terminated;
         execution_state_ = ExecutionState::Done;
         count_ = 0;
+        error_ = {};
     }
 
     // IExecution interface
@@ -85,6 +187,9 @@ public:
         bool done = doExecute();
         count_++;
 
+        if (error_) {
+            done = true; // Failed steps cannot continue until reset()
+        }
         if (done) {
             execution_state_ = ExecutionState::Done;
         }
@@ -104,6 +209,14 @@ public:
         doReset();
         execution_state_ = ExecutionState::Reset;
         count_ = 0;
+        error_ = {};
+    }
+
+    std::error_code last_error() const noexcept override {
+        if (lifecycle_state_ != LifecycleState::Initialized) {
+            return {};
+        }
+        return error_;
     }
 
 protected:
@@ -132,11 +245,23 @@ protected:
      * - Perform processing
      * - No exceptions
      * - No dynamic allocations
+     * - Report runtime errors (bad input, overflow) with fail(); the step then ends in Done
+     *   with last_error() set, whatever the return value.
      *
      * @return true if processing is complete, false to continue
      */
     virtual bool doExecute() noexcept = 0;
 
+    /**
+     * Latch a runtime error from doExecute().
+     * - The first error of a step wins; cleared by reset().
+     */
+    void fail(std::error_code ec) noexcept {
+        if (!error_) {
+            error_ = ec;
+        }
+    }
+
     /**
      * Override to implement termination logic.
      * - Cleanup resources - best effort
@@ -144,12 +269,52 @@ protected:
      */
     virtual void doTerminate() noexcept = 0;
 
+    /**
+     * Override to support initialize_from().
+     * - prototype is Initialized and has the same dynamic type as this (safe to static_cast).
+     * - Share immutable artifacts (taps, tables, plans) by reference, e.g. std::shared_ptr<const T>.
+     * - Allocate and default mutable state as doInitialize() + doReset() would.
+     * - All or nothing, like doInitialize().
+     *
+     * @return std::error_code - empty on success, error code on failure
+     */
+    virtual std::error_code doClone(const Component& prototype) noexcept {
+        (void)prototype;
+        return std::make_error_code(std::errc::operation_not_supported);
+    }
 
+    /**
+     * Override to support warm_up() pre-faulting.
+     * - Touch every allocated buffer, e.g. with prefault(std::span).
+     * - Must not change observable state.
+     */
+    virtual void doPrefault() noexcept {}
+
+    /**
+     * Override to support warm_up() dry-run steps.
+     * - Install synthetic input (e.g. zeros) so dry-run doExecute() calls do not consume
+     *   real data or produce visible output.
+     * - doReset() must discard the synthetic input and any state it produced.
+     * - No allocations.
+     *
+     * @return true if dry-run steps should run, false if unsupported (default)
+     */
+    virtual bool doWarmup() noexcept { return false; }
+
+    /**
+     * Resource for doInitialize()/doClone() allocations, e.g. make_array<T>(memory(), n).
+     * - The memory account if one is set, otherwise the default resource.
+     */
+    std::pmr::memory_resource* memory() const noexcept {
+        return memory_account_ ? memory_account_ : std::pmr::get_default_resource();
+    }
 
 private:
     LifecycleState lifecycle_state_ = LifecycleState::Uninitialized;
     ExecutionState execution_state_ = ExecutionState::Reset;
     std::uint64_t count_ = 0;
+    std::error_code error_;
+    MemoryAccount* memory_account_ = nullptr;
 };
 
 } // namespace dspai::comp
\ No newline at end of file
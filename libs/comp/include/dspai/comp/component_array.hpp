@@ -0,0 +1,262 @@
+#pragma once
+
+#include <dspai/comp/execution.hpp>
+#include <array>
+#include <bitset>
+#include <cstddef>
+
+namespace dspai::comp {
+
+/**
+ * One bit per lane of a ComponentArray
+ */
+template <std::size_t N>
+using LaneMask = std::bitset<N>;
+
+/**
+ * Multi-instance component base
+ *
+ * Runs N identical channels ("lanes") inside a single object.
+ * - Derived classes keep per-lane state as struct-of-arrays (e.g. std::array<float, N>)
+ *   so one doExecute() processes every active lane in a vectorizable loop.
+ * - Lifecycle is shared by all lanes; execution state is tracked per lane with bitmasks.
+ * - VMI: derived classes should override do* methods to implement specific behavior.
+ *
+ * The IExecution interface reports the aggregate of all lanes:
+ * - execution_state() is Reset when every lane is Reset, Done when every lane is Done,
+ *   Running otherwise.
+ * - execute() steps all lanes that are not Done and returns true once every lane is Done.
+ * - count() is the number of execute() calls since initialize() or a full reset().
+ * - reset() resets every lane; reset(lanes) resets a subset.
+ *
+ * Thread Safety: NOT thread-safe. External synchronization required.
+ */
+template <std::size_t N>
+class ComponentArray : public IExecution {
+    static_assert(N > 0, "ComponentArray requires at least one lane");
+
+public:
+    using Mask = LaneMask<N>;
+
+    static constexpr std::size_t lanes = N;
+
+    ComponentArray() = default;
+    virtual ~ComponentArray() noexcept = default;
+
+    // ILifecycle interface
+    LifecycleState lifecycle_state() const noexcept override {
+        return lifecycle_state_;
+    }
+
+    std::error_code initialize() noexcept override {
+        if (lifecycle_state_ != LifecycleState::Uninitialized) {
+            return std::make_error_code(std::errc::operation_not_permitted);
+        }
+
+        auto result = doInitialize();
+        if (!result) {
+            lifecycle_state_ = LifecycleState::Initialized;
+            clear_lanes(Mask{}.set());
+            count_ = 0;
+        }
+        return result;
+    }
+
+    void terminate() noexcept override {
+        if (lifecycle_state_ == LifecycleState::Terminated) {
+            return; // Idempotent
+        }
+
+        doTerminate();
+        lifecycle_state_ = LifecycleState::Terminated;
+        clear_lanes(Mask{}.set());
+        done_.set();
+        count_ = 0;
+    }
+
+    // IExecution interface (aggregate over all lanes)
+    ExecutionState execution_state() const noexcept override {
+        if (lifecycle_state_ == LifecycleState::Uninitialized) {
+            return ExecutionState::Reset;
+        }
+        if (lifecycle_state_ == LifecycleState::Terminated) {
+            return ExecutionState::Done;
+        }
+        if (done_.all()) {
+            return ExecutionState::Done;
+        }
+        if (running_.none() && done_.none()) {
+            return ExecutionState::Reset;
+        }
+        return ExecutionState::Running;
+    }
+
+    std::uint64_t count() const noexcept override {
+        if (lifecycle_state_ != LifecycleState::Initialized) {
+            return 0;
+        }
+        return count_;
+    }
+
+    bool execute() noexcept override {
+        if (lifecycle_state_ != LifecycleState::Initialized) {
+            return false; // No-op when not initialized
+        }
+
+        const Mask active = ~done_;
+        if (active.none()) {
+            return true; // Already done
+        }
+
+        // Lanes in Reset transition to Running
+        running_ |= active;
+
+        // Execute the actual work for all active lanes at once
+        const Mask done = doExecute(active) & active;
+        count_++;
+        for (std::size_t i = 0; i < N; ++i) {
+            lane_count_[i] += active[i];
+        }
+
+        done_ |= done;
+        running_ &= ~done;
+
+        return done_.all();
+    }
+
+    void reset() noexcept override {
+        reset(Mask{}.set());
+    }
+
+    // Per-lane interface
+
+    /**
+     * @brief Reset a subset of lanes
+     *
+     * - Lanes already in Reset are ignored; no-op if no selected lane needs a reset.
+     * - doReset() is called once with the lanes that actually need resetting.
+     * - Aggregate count() returns to zero once every lane is in Reset.
+     */
+    void reset(const Mask& lanes) noexcept {
+        if (lifecycle_state_ != LifecycleState::Initialized) {
+            return; // No-op when not initialized
+        }
+
+        const Mask mask = lanes & (running_ | done_);
+        if (mask.none()) {
+            return; // Selected lanes already in reset state (idempotent)
+        }
+
+        doReset(mask);
+        clear_lanes(mask);
+        if (running_.none() && done_.none()) {
+            count_ = 0;
+        }
+    }
+
+    void reset_lane(std::size_t lane) noexcept {
+        if (lane < N) {
+            reset(Mask{}.set(lane));
+        }
+    }
+
+    ExecutionState execution_state(std::size_t lane) const noexcept {
+        if (lifecycle_state_ == LifecycleState::Uninitialized) {
+            return ExecutionState::Reset;
+        }
+        if (lifecycle_state_ == LifecycleState::Terminated || lane >= N) {
+            return ExecutionState::Done;
+        }
+        if (done_[lane]) {
+            return ExecutionState::Done;
+        }
+        return running_[lane] ? ExecutionState::Running : ExecutionState::Reset;
+    }
+
+    /**
+     * @brief Number of execute() steps lane has taken since its last reset
+     */
+    std::uint64_t count(std::size_t lane) const noexcept {
+        if (lifecycle_state_ != LifecycleState::Initialized || lane >= N) {
+            return 0;
+        }
+        return lane_count_[lane];
+    }
+
+    /// Lanes in Reset state
+    Mask reset_lanes() const noexcept {
+        if (lifecycle_state_ != LifecycleState::Initialized) {
+            return lifecycle_state_ == LifecycleState::Uninitialized ? Mask{}.set() : Mask{};
+        }
+        return ~(running_ | done_);
+    }
+
+    /// Lanes in Running state
+    Mask running_lanes() const noexcept {
+        return lifecycle_state_ == LifecycleState::Initialized ? running_ : Mask{};
+    }
+
+    /// Lanes in Done state
+    Mask done_lanes() const noexcept {
+        return lifecycle_state_ == LifecycleState::Uninitialized ? Mask{} : done_;
+    }
+
+protected:
+    /**
+     * Override to implement initialization logic for all lanes.
+     * - All or nothing initialization.
+     * - No persistent side effects on failure.
+     *
+     * @return std::error_code - empty on success, error code on failure
+     */
+    virtual std::error_code doInitialize() noexcept = 0;
+
+    /**
+     * Override to implement reset logic.
+     *
+     * - Reset the state of every lane set in `lanes`; leave other lanes untouched
+     * - No allocations or deallocations
+     *
+     * @param lanes: lanes to reset (never empty)
+     */
+    virtual void doReset(const Mask& lanes) noexcept = 0;
+
+    /**
+     * Override to implement compute logic for all active lanes.
+     *
+     * - Process every lane set in `active` (lanes in Reset or Running)
+     * - Prefer branch-free SoA loops over all N lanes, masking out inactive ones
+     * - No exceptions
+     * - No dynamic allocations
+     *
+     * @param active: lanes to process (never empty)
+     * @return lanes whose processing is complete; bits outside `active` are ignored
+     */
+    virtual Mask doExecute(const Mask& active) noexcept = 0;
+
+    /**
+     * Override to implement termination logic.
+     * - Cleanup resources - best effort
+     * - No exceptions
+     */
+    virtual void doTerminate() noexcept = 0;
+
+private:
+    void clear_lanes(const Mask& mask) noexcept {
+        running_ &= ~mask;
+        done_ &= ~mask;
+        for (std::size_t i = 0; i < N; ++i) {
+            if (mask[i]) {
+                lane_count_[i] = 0;
+            }
+        }
+    }
+
+    LifecycleState lifecycle_state_ = LifecycleState::Uninitialized;
+    Mask running_{};
+    Mask done_{};
+    std::uint64_t count_ = 0;
+    std::array<std::uint64_t, N> lane_count_{};
+};
+
+} // namespace dspai::comp
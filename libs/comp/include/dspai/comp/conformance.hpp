@@ -0,0 +1,427 @@
+#pragma once
+
+#include <dspai/comp/clock.hpp>
+#include <dspai/comp/component.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dspai::comp {
+
+/**
+ * Counts heap allocations on the calling thread, for "no allocation" checks
+ *
+ * A header-only library cannot replace the global operator new, so counting is enabled by
+ * expanding DSPAI_COMP_COUNT_ALLOCATIONS() once, at namespace scope, in the test executable.
+ * Without it available() is false and allocation checks are skipped.
+ */
+class AllocationCounter {
+public:
+    static bool available() noexcept { return enabled().load(std::memory_order_relaxed); }
+
+    /// Allocations plus deallocations made by this thread so far
+    static std::uint64_t count() noexcept { return counter(); }
+
+    static void note() noexcept { counter()++; }
+    static void enable() noexcept { enabled().store(true, std::memory_order_relaxed); }
+
+private:
+    static std::atomic<bool>& enabled() noexcept {
+        static std::atomic<bool> flag{false};
+        return flag;
+    }
+    static std::uint64_t& counter() noexcept {
+        static thread_local std::uint64_t count = 0;
+        return count;
+    }
+};
+
+// Replaces the global allocation functions with counting malloc/free wrappers
+#define DSPAI_COMP_COUNT_ALLOCATIONS()                                                                  \
+    void* operator new(std::size_t size) {                                                              \
+        ::dspai::comp::AllocationCounter::note();                                                      \
+        if (void* p = std::malloc(size ? size : 1)) {                                                   \
+            return p;                                                                                   \
+        }                                                                                               \
+        throw std::bad_alloc();                                                                         \
+    }                                                                                                   \
+    void* operator new[](std::size_t size) { return ::operator new(size); }                             \
+    void* operator new(std::size_t size, std::align_val_t align) {                                      \
+        ::dspai::comp::AllocationCounter::note();                                                      \
+        const auto a = static_cast<std::size_t>(align);                                                 \
+        if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) {                                  \
+            return p;                                                                                   \
+        }                                                                                               \
+        throw std::bad_alloc();                                                                         \
+    }                                                                                                   \
+    void* operator new[](std::size_t size, std::align_val_t align) { return ::operator new(size, align); } \
+    void operator delete(void* p) noexcept {                                                            \
+        if (p) {                                                                                        \
+            ::dspai::comp::AllocationCounter::note();                                                  \
+        }                                                                                               \
+        std::free(p);                                                                                   \
+    }                                                                                                   \
+    void operator delete[](void* p) noexcept { ::operator delete(p); }                                  \
+    void operator delete(void* p, std::size_t) noexcept { ::operator delete(p); }                       \
+    void operator delete[](void* p, std::size_t) noexcept { ::operator delete(p); }                     \
+    void operator delete(void* p, std::align_val_t) noexcept { ::operator delete(p); }                  \
+    void operator delete[](void* p, std::align_val_t) noexcept { ::operator delete(p); }                \
+    void operator delete(void* p, std::size_t, std::align_val_t) noexcept { ::operator delete(p); }     \
+    void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { ::operator delete(p); }   \
+    static const bool dspai_comp_allocation_counter_enabled_ = (::dspai::comp::AllocationCounter::enable(), true)
+
+/**
+ * What check_component() verifies
+ *
+ */
+struct ConformanceOptions {
+    std::uint64_t max_steps = 256;              ///< execute() calls per run (fewer if Done first)
+    std::uint32_t latency_runs = 4;             ///< Runs (reset in between) timed for the latency bound
+    std::chrono::nanoseconds step_budget{0};    ///< Per-step latency bound; 0 = not checked
+    double budget_percentile = 99.0;            ///< Percentile of step latency held to step_budget
+    bool check_allocations = true;              ///< execute()/reset() must not allocate (if counting is available)
+};
+
+/**
+ * How check_component() drives a component type
+ *
+ */
+template <typename C>
+struct ConformanceHooks {
+    std::function<std::unique_ptr<C>()> make;  ///< Fresh Uninitialized instance (default: std::make_unique<C>())
+    std::function<void(C&)> prepare;           ///< Install input before each run (after initialize()/reset())
+    std::function<std::uint64_t(C&)> digest;  ///< Observable output after a step; enables the reset check
+};
+
+/**
+ * Outcome of check_component()
+ *
+ */
+struct ConformanceResult {
+    std::vector<std::string> failures;          ///< One line per violated rule
+    bool allocations_checked = false;
+    std::uint64_t allocations = 0;              ///< Allocations + deallocations inside execute()/reset()
+    std::uint64_t steps = 0;                    ///< Timed execute() calls
+    std::chrono::nanoseconds p50{0};            ///< Step latency percentiles over the timed runs
+    std::chrono::nanoseconds p99{0};
+    std::chrono::nanoseconds max{0};
+    bool aborted = false;                       ///< Ran out of memory or could not create the component
+
+    bool passed() const noexcept { return failures.empty() && !aborted; }
+
+    /// Failures, one per line, then a latency/allocation summary line
+    std::string summary() const noexcept {
+        try {
+            std::string out;
+            for (const auto& failure : failures) {
+                out += "FAIL " + failure + '\n';
+            }
+            char line[160];
+            std::snprintf(line, sizeof(line), "%s: %llu steps, p50 %lld ns, p99 %lld ns, max %lld ns, allocations %s\n",
+                          passed() ? "PASS" : aborted ? "ABORTED" : "FAIL", static_cast<unsigned long long>(steps),
+                          static_cast<long long>(p50.count()), static_cast<long long>(p99.count()),
+                          static_cast<long long>(max.count()),
+                          allocations_checked ? std::to_string(allocations).c_str() : "unchecked");
+            out += line;
+            return out;
+        } catch (...) {
+            return {};
+        }
+    }
+};
+
+namespace detail {
+
+template <typename C>
+class ConformanceRun {
+public:
+    ConformanceRun(const ConformanceHooks<C>& hooks, const ConformanceOptions& options, ConformanceResult& result)
+        : hooks_(hooks), options_(options), result_(result) {}
+
+    void run() {
+        auto fresh = make();
+        if (!fresh) {
+            return;
+        }
+        check_uninitialized(*fresh);
+
+        auto component = make();
+        if (!component) {
+            return;
+        }
+        auto& c = *component;
+        if (auto ec = c.initialize()) {
+            fail("initialize() failed: " + ec.message());
+            return;
+        }
+        expect(c.lifecycle_state() == LifecycleState::Initialized, "initialize(): lifecycle_state() != Initialized");
+        expect_reset(c, "initialize()");
+        expect(c.initialize() == std::errc::operation_not_permitted,
+               "initialize() twice: expected operation_not_permitted");
+        expect(c.lifecycle_state() == LifecycleState::Initialized, "initialize() twice: state changed");
+
+        c.reset();
+        expect_reset(c, "reset() in Reset");
+
+        std::vector<std::uint64_t> first;
+        std::vector<std::uint64_t> second;
+        prepare(c);
+        run_steps(c, hooks_.digest ? &first : nullptr, nullptr);
+        reset(c, "reset() after run");
+        reset(c, "reset() twice");
+        prepare(c);
+        run_steps(c, hooks_.digest ? &second : nullptr, nullptr);
+        compare_runs(first, second, "reset()");
+
+        // Interrupt a run: reset() from Running must restart it from scratch
+        reset(c, "reset() after run");
+        prepare(c);
+        run_steps(c, nullptr, nullptr, 1);
+        if (c.execution_state() == ExecutionState::Running) {
+            reset(c, "reset() while Running");
+            prepare(c);
+            second.clear();
+            run_steps(c, hooks_.digest ? &second : nullptr, nullptr);
+            compare_runs(first, second, "reset() while Running");
+        }
+
+        // Raw step durations, reserved up front so recording does not allocate
+        std::vector<std::chrono::nanoseconds> latency;
+        latency.reserve(static_cast<std::size_t>(options_.max_steps * options_.latency_runs));
+        for (std::uint32_t r = 0; r < options_.latency_runs; ++r) {
+            reset(c, "reset() between timed runs");
+            prepare(c);
+            run_steps(c, nullptr, &latency);
+        }
+        result_.steps = latency.size();
+        result_.p50 = percentile(latency, 50);
+        result_.p99 = percentile(latency, 99);
+        result_.max = percentile(latency, 100);
+        if (options_.step_budget.count() > 0 && !latency.empty()) {
+            const auto bound = percentile(latency, options_.budget_percentile);
+            if (bound > options_.step_budget) {
+                fail("step latency p" + std::to_string(static_cast<int>(options_.budget_percentile)) + " " +
+                     std::to_string(bound.count()) + " ns exceeds budget " +
+                     std::to_string(options_.step_budget.count()) + " ns");
+            }
+        }
+        if (result_.allocations_checked && result_.allocations != 0) {
+            fail("execute()/reset() allocated or freed " + std::to_string(result_.allocations) + " times");
+        }
+
+        c.terminate();
+        check_terminated(c);
+        c.terminate();
+        check_terminated(c);
+        expect(c.initialize() == std::errc::operation_not_permitted,
+               "initialize() after terminate(): expected operation_not_permitted");
+
+        fresh->terminate();
+        check_terminated(*fresh);
+    }
+
+private:
+    std::unique_ptr<C> make() {
+        std::unique_ptr<C> component;
+        if (hooks_.make) {
+            component = hooks_.make();
+        } else if constexpr (std::is_default_constructible_v<C>) {
+            component = std::make_unique<C>();
+        }
+        if (!component) {
+            result_.aborted = true;
+            fail("cannot create the component (no make hook?)");
+        } else if (component->lifecycle_state() != LifecycleState::Uninitialized) {
+            fail("make(): component is not Uninitialized");
+        }
+        return component;
+    }
+
+    void prepare(C& c) {
+        if (hooks_.prepare) {
+            hooks_.prepare(c);
+        }
+    }
+
+    void check_uninitialized(C& c) {
+        expect(c.execution_state() == ExecutionState::Reset, "Uninitialized: execution_state() != Reset");
+        expect(c.count() == 0, "Uninitialized: count() != 0");
+        expect(!c.is_ready(), "Uninitialized: is_ready()");
+        expect(!c.execute(), "Uninitialized: execute() returned true");
+        expect(c.count() == 0, "Uninitialized: execute() changed count()");
+        c.reset();
+        expect(c.lifecycle_state() == LifecycleState::Uninitialized, "Uninitialized: reset() changed the state");
+        expect(!c.last_error(), "Uninitialized: last_error() set");
+    }
+
+    void check_terminated(C& c) {
+        expect(c.lifecycle_state() == LifecycleState::Terminated, "terminate(): lifecycle_state() != Terminated");
+        expect(c.execution_state() == ExecutionState::Done, "Terminated: execution_state() != Done");
+        expect(c.count() == 0, "Terminated: count() != 0");
+        expect(!c.is_ready(), "Terminated: is_ready()");
+        expect(!c.execute(), "Terminated: execute() returned true");
+        c.reset();
+        expect(c.execution_state() == ExecutionState::Done, "Terminated: reset() changed the state");
+        expect(!c.last_error(), "Terminated: last_error() set");
+    }
+
+    void expect_reset(C& c, const char* after) {
+        expect(c.execution_state() == ExecutionState::Reset, std::string(after) + ": execution_state() != Reset");
+        expect(c.count() == 0, std::string(after) + ": count() != 0");
+        expect(c.is_ready(), std::string(after) + ": !is_ready()");
+        expect(!c.last_error(), std::string(after) + ": last_error() set");
+    }
+
+    void reset(C& c, const char* what) {
+        const auto before = AllocationCounter::count();
+        c.reset();
+        count_allocations(before);
+        expect_reset(c, what);
+    }
+
+    // Nearest-rank percentile (0-100) of durations; reorders durations
+    static std::chrono::nanoseconds percentile(std::vector<std::chrono::nanoseconds>& durations, double p) noexcept {
+        if (durations.empty()) {
+            return {};
+        }
+        const auto rank = static_cast<std::size_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 *
+                                                             static_cast<double>(durations.size())));
+        const auto nth = durations.begin() + static_cast<std::ptrdiff_t>(std::max<std::size_t>(rank, 1) - 1);
+        std::nth_element(durations.begin(), nth, durations.end());
+        return *nth;
+    }
+
+    // Digest sequences of two runs that must match
+    void compare_runs(const std::vector<std::uint64_t>& first, const std::vector<std::uint64_t>& second,
+                      const char* what) {
+        if (!hooks_.digest) {
+            return;
+        }
+        if (first.size() != second.size()) {
+            fail(std::string(what) + ": run lengths differ (" + std::to_string(first.size()) + " vs " +
+                 std::to_string(second.size()) + " steps)");
+            return;
+        }
+        for (std::size_t i = 0; i < first.size(); ++i) {
+            if (first[i] != second[i]) {
+                fail(std::string(what) + ": output differs from the first run at step " + std::to_string(i));
+                return;
+            }
+        }
+    }
+
+    // One run of up to max_steps (default: options.max_steps) execute() calls, checking
+    // every transition
+    void run_steps(C& c, std::vector<std::uint64_t>* digests, std::vector<std::chrono::nanoseconds>* latency,
+                   std::uint64_t max_steps = 0) {
+        if (max_steps == 0) {
+            max_steps = options_.max_steps;
+        }
+        if (digests) {
+            digests->reserve(static_cast<std::size_t>(max_steps));
+        }
+        for (std::uint64_t step = 1; step <= max_steps; ++step) {
+            const auto before = AllocationCounter::count();
+            const auto start = TickClock::now();
+            const bool done = c.execute();
+            const auto end = TickClock::now();
+            count_allocations(before);
+            if (latency) {
+                latency->push_back(TickClock::to_duration(end - start));
+            }
+
+            if (c.count() != step) {
+                fail("execute(): count() " + std::to_string(c.count()) + " after " + std::to_string(step) + " steps");
+                return;
+            }
+            const auto state = c.execution_state();
+            if (state != (done ? ExecutionState::Done : ExecutionState::Running)) {
+                fail("execute() returned " + std::string(done ? "true" : "false") + " but execution_state() is " +
+                     (state == ExecutionState::Done ? "Done" : state == ExecutionState::Running ? "Running" : "Reset"));
+                return;
+            }
+            if (c.last_error() && !done) {
+                fail("execute(): last_error() set but not done");
+            }
+            if (c.is_ready() == done) {
+                fail("execute(): is_ready() inconsistent with the returned state");
+            }
+            if (digests) {
+                digests->push_back(hooks_.digest(c));
+            }
+            if (done) {
+                expect(c.execute(), "execute() in Done returned false");
+                expect(c.count() == step, "execute() in Done changed count()");
+                return;
+            }
+        }
+    }
+
+    void count_allocations(std::uint64_t before) noexcept {
+        if (result_.allocations_checked) {
+            result_.allocations += AllocationCounter::count() - before;
+        }
+    }
+
+    void expect(bool condition, const std::string& failure) {
+        if (!condition) {
+            fail(failure);
+        }
+    }
+
+    void fail(std::string failure) { result_.failures.push_back(std::move(failure)); }
+
+    const ConformanceHooks<C>& hooks_;
+    const ConformanceOptions& options_;
+    ConformanceResult& result_;
+};
+
+} // namespace detail
+
+/**
+ * @brief Check a Component implementation against the lifecycle/execution contract
+ *
+ * Creates instances with hooks.make and verifies, per lifecycle.hpp and execution.hpp:
+ * - Uninitialized/Terminated no-op behavior of execute(), reset(), count(), is_ready(), and
+ *   operation_not_permitted from a second initialize() or one after terminate().
+ * - Every step: count() increments by one, execution_state() is Running or Done to match
+ *   the return value, a latched last_error() ends the run; execute() in Done is a no-op.
+ * - reset() and terminate() land in the documented states and are idempotent; reset()
+ *   also works from Running (mid-run).
+ * - With hooks.digest: runs separated by reset(), after Done or mid-run, produce identical
+ *   digest sequences.
+ * - With DSPAI_COMP_COUNT_ALLOCATIONS() in the test executable: execute() and reset() do
+ *   not allocate or free.
+ * - With options.step_budget: the budget_percentile step latency over latency_runs timed
+ *   runs is within budget (timing excludes prepare() and digest()). Percentiles are exact
+ *   (nearest rank over the recorded step durations).
+ *
+ * Runs on the calling thread; the result lists every violated rule.
+ */
+template <typename C>
+    requires std::derived_from<C, Component>
+ConformanceResult check_component(const ConformanceHooks<C>& hooks = {}, const ConformanceOptions& options = {}) noexcept {
+    ConformanceResult result;
+    result.allocations_checked = options.check_allocations && AllocationCounter::available();
+    try {
+        detail::ConformanceRun<C>(hooks, options, result).run();
+    } catch (...) {
+        result.aborted = true;
+    }
+    return result;
+}
+
+} // namespace dspai::comp
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <dspai/comp/clock.hpp>
 #include <dspai/comp/lifecycle.hpp>
+#include <chrono>
 #include <cstdint>
 
 namespace dspai::comp {
@@ -15,6 +17,24 @@ enum class ExecutionState {
     Done     ///< Processing is complete
 };
 
+/**
+ * Budget for a cooperative execute_until()/execute_for() slice
+ *
+ */
+struct ExecutionBudget {
+    std::uint64_t max_steps = ~std::uint64_t{0}; ///< Maximum execute() calls in the slice (0 is treated as 1)
+    std::uint64_t deadline = ~std::uint64_t{0};  ///< Absolute TickClock deadline
+    std::uint32_t check_interval = 1;            ///< execute() calls between clock reads
+};
+
+/**
+ * Outcome of a cooperative execution slice
+ *
+ */
+struct SliceResult {
+    bool done = false;       ///< Processing is complete (or cannot continue)
+    std::uint64_t steps = 0; ///< execute() calls made in the slice
+};
 
 /**
  * Execution interface for a Component
@@ -76,6 +96,19 @@ public:
      */
     virtual void reset() noexcept = 0;
 
+    /**
+     * @brief Runtime error latched by the last execute()
+     *
+     * Error channel for execute(): a step that fails transitions to Done and latches the
+     * cause here, so "failed" can be told apart from "finished".
+     * - Empty when processing is healthy or completed normally.
+     * - Cleared by reset(), initialize() and terminate().
+     * - Default implementation reports no errors.
+     *
+     * @return std::error_code - empty if no error is latched
+     */
+    virtual std::error_code last_error() const noexcept { return {}; }
+
     /**
      * @brief Check if component is ready for execution
      *
@@ -87,6 +120,59 @@ public:
         return s == ExecutionState::Reset || s == ExecutionState::Running;
     }
 
+    /**
+     * @brief Execute steps until done or the budget is exhausted
+     *
+     * Cooperative time slicing: lets one executor thread share its time fairly between
+     * latency-sensitive and bulk components.
+     * - Makes at least one execute() call when ready, even if the deadline has passed or
+     *   max_steps is 0, so every component progresses.
+     * - Reads TickClock (TSC) every check_interval steps; the deadline may be overrun by
+     *   up to check_interval steps.
+     * - When not ready: returns {done, 0} without calling execute(), where done is true in
+     *   Done state and false when not Initialized.
+     *
+     * @return SliceResult: whether processing completed and how many steps ran
+     */
+    SliceResult execute_until(const ExecutionBudget& budget) noexcept {
+        if (!is_ready()) {
+            return {lifecycle_state() == LifecycleState::Initialized, 0};
+        }
+
+        const std::uint32_t interval = budget.check_interval ? budget.check_interval : 1;
+        const std::uint64_t max_steps = budget.max_steps ? budget.max_steps : 1;
+        SliceResult result;
+        std::uint32_t until_check = interval;
+        while (result.steps < max_steps) {
+            result.done = execute();
+            result.steps++;
+            if (result.done) {
+                break;
+            }
+            if (--until_check == 0) {
+                if (TickClock::now() >= budget.deadline) {
+                    break;
+                }
+                until_check = interval;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Execute steps until done or `duration` has elapsed
+     *
+     * Convenience wrapper over execute_until() with a deadline relative to now.
+     * Converting duration to ticks needs the TickClock calibration (about 1 ms, once per
+     * process); Component::initialize() performs it, other IExecution implementations pay it
+     * on their first call unless they call TickClock::ticks_per_ns() up front.
+     */
+    SliceResult execute_for(std::chrono::nanoseconds duration,
+                            std::uint64_t max_steps = ~std::uint64_t{0},
+                            std::uint32_t check_interval = 1) noexcept {
+        return execute_until({max_steps, TickClock::deadline_in(duration), check_interval});
+    }
+
 
 };
 
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <dspai/comp/clock.hpp>
+#include <dspai/comp/flight_recorder.hpp>
+#include <dspai/comp/graph.hpp>
+#include <dspai/comp/spsc_ring.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace dspai::comp {
+
+/**
+ * What a worker thread is doing right now (see ThreadedExecutor::activity())
+ *
+ */
+struct WorkerActivity {
+    bool busy = false;             ///< Inside a node's step
+    NodeId node = 0;               ///< Node being executed (valid when busy)
+    std::uint64_t started = 0;     ///< TickClock time the step started (valid when busy)
+};
+
+/**
+ * Multi-threaded graph executor with migratable node ownership
+ *
+ * Each node is owned by one worker thread; each worker repeatedly runs execute_node() for
+ * its nodes in topological order until every node is finished (Done/Isolated) or the graph
+ * is stopped.
+ * - Ownership is a per-node atomic word (owner index | BUSY bit). A worker claims a node
+ *   with a CAS before each step and releases it after, so a node never runs on two threads
+ *   and the Component single-threaded contract holds across migrations (acquire/release
+ *   handoff of the component's state).
+ * - migrate() changes the owner at any time; an in-flight step completes on the old worker
+ *   and the new owner picks the node up at its next step boundary.
+ * - Per-step bookkeeping is one TickClock read and a few relaxed stores per worker, read by
+ *   monitors such as Watchdog through activity() and steps().
+ * - With a FlightRecorder attached, every step records ExecuteBegin/ExecuteEnd, plus Error,
+ *   StateChange and QueueDepth (nodes with NodeOptions::backlog) events.
+ * - Workers spin over their nodes; they yield only when they own nothing runnable, or after
+ *   every pass when there are more workers than hardware threads (so a spinning producer
+ *   cannot starve its consumer for a whole time slice).
+ *
+ * Thread Safety: start()/stop()/wait() from one control thread. migrate(), owner(),
+ * activity(), steps() and finished() may be called from any thread while running.
+ */
+class ThreadedExecutor {
+public:
+    explicit ThreadedExecutor(Graph& graph) noexcept : graph_(&graph) {}
+    ThreadedExecutor(const ThreadedExecutor&) = delete;
+    ThreadedExecutor& operator=(const ThreadedExecutor&) = delete;
+    ~ThreadedExecutor() noexcept { stop(); }
+
+    Graph& graph() const noexcept { return *graph_; }
+
+    /**
+     * @brief Record worker events to a flight recorder (nullptr to detach)
+     *
+     * Names the recorder's sources after the graph's nodes. Call while stopped.
+     */
+    void set_recorder(FlightRecorder* recorder) noexcept {
+        recorder_ = recorder;
+        if (recorder) {
+            for (NodeId id = 0; id < graph_->size(); ++id) {
+                recorder->name_source(static_cast<std::uint32_t>(id), graph_->options(id).name);
+            }
+        }
+    }
+
+    FlightRecorder* recorder() const noexcept { return recorder_; }
+
+    /**
+     * @brief Start worker threads
+     *
+     * @param workers: number of worker threads
+     * @param owners: initial owner per node (size graph().size()); empty assigns nodes
+     *        round-robin in topological order
+     * @param cpus: CPU to pin each worker to (size workers), e.g. from a PlacementPlan;
+     *        empty leaves workers unpinned. Pinning is best effort (Linux only).
+     * @return std::error_code - empty on success
+     *         - operation_not_permitted if running or the graph is not built
+     *         - invalid_argument if workers is zero, owners or cpus has the wrong size, or an
+     *           owner index is out of range
+     *         - not_enough_memory / resource_unavailable_try_again
+     */
+    std::error_code start(std::size_t workers, std::span<const std::size_t> owners = {},
+                          std::span<const unsigned> cpus = {}) noexcept {
+        if (running() || !graph_->built()) {
+            return std::make_error_code(std::errc::operation_not_permitted);
+        }
+        const std::size_t n = graph_->size();
+        if (workers == 0 || workers >= busy_bit || (!owners.empty() && owners.size() != n) ||
+            (!cpus.empty() && cpus.size() != workers)) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+        for (auto owner : owners) {
+            if (owner >= workers) {
+                return std::make_error_code(std::errc::invalid_argument);
+            }
+        }
+
+        try {
+            nodes_ = std::make_unique<NodeSlot[]>(n);
+            workers_ = std::make_unique<WorkerSlot[]>(workers);
+            threads_.reserve(workers);
+        } catch (...) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        worker_count_ = workers;
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto id = graph_->order()[i];
+            nodes_[id].claim.store(owners.empty() ? i % workers : owners[id], std::memory_order_relaxed);
+        }
+        remaining_.store(n, std::memory_order_relaxed);
+        stop_.store(false, std::memory_order_relaxed);
+        oversubscribed_ = workers > std::max(1u, std::thread::hardware_concurrency());
+        running_.store(true, std::memory_order_release);
+
+        try {
+            for (std::size_t w = 0; w < workers; ++w) {
+                const int cpu = cpus.empty() ? -1 : static_cast<int>(cpus[w]);
+                threads_.emplace_back([this, w, cpu] {
+                    pin(cpu);
+                    run(w);
+                });
+            }
+        } catch (...) {
+            stop();
+            return std::make_error_code(std::errc::resource_unavailable_try_again);
+        }
+        return {};
+    }
+
+    /**
+     * @brief Ask workers to exit at their next step boundary and join them
+     *
+     * Blocks while a worker is inside a step. Idempotent.
+     */
+    void stop() noexcept {
+        stop_.store(true, std::memory_order_release);
+        wait();
+    }
+
+    /// Block until every node is finished or the graph is stopped, then join the workers
+    void wait() noexcept {
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+        threads_.clear();
+        running_.store(false, std::memory_order_release);
+    }
+
+    /// Workers have been started and not yet joined
+    bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+    std::size_t workers() const noexcept { return worker_count_; }
+
+    /// Every node is Done/Isolated or the graph was stopped
+    bool finished() const noexcept {
+        return remaining_.load(std::memory_order_acquire) == 0 || graph_->stopped();
+    }
+
+    /// Current owner worker of a node
+    std::size_t owner(NodeId id) const noexcept {
+        return nodes_[id].claim.load(std::memory_order_relaxed) & ~busy_bit;
+    }
+
+    /// Node has finished (Done/Isolated) and is no longer scheduled
+    bool node_finished(NodeId id) const noexcept { return nodes_[id].finished.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Move a node to another worker at its next step boundary
+     *
+     * @return std::error_code - empty on success
+     *         - operation_not_permitted if never started
+     *         - invalid_argument if id or worker is out of range
+     */
+    std::error_code migrate(NodeId id, std::size_t worker) noexcept {
+        if (!nodes_) {
+            return std::make_error_code(std::errc::operation_not_permitted);
+        }
+        if (id >= graph_->size() || worker >= worker_count_) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+        auto& claim = nodes_[id].claim;
+        auto state = claim.load(std::memory_order_relaxed);
+        while (!claim.compare_exchange_weak(state, (state & busy_bit) | worker, std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+        }
+        if ((state & ~busy_bit) != worker) {
+            migrations_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return {};
+    }
+
+    /// Total ownership changes made by migrate()
+    std::uint64_t migrations() const noexcept { return migrations_.load(std::memory_order_relaxed); }
+
+    /// Steps executed for a node (monotonic; valid after start())
+    std::uint64_t steps(NodeId id) const noexcept { return nodes_[id].steps.load(std::memory_order_relaxed); }
+
+    /// What worker is doing right now (valid after start())
+    WorkerActivity activity(std::size_t worker) const noexcept {
+        const auto& slot = workers_[worker];
+        for (;;) {
+            const auto started = slot.started.load(std::memory_order_acquire);
+            if (started == 0) {
+                return {};
+            }
+            const auto node = slot.node.load(std::memory_order_acquire);
+            // Consistent if the same step is still in flight
+            if (slot.started.load(std::memory_order_acquire) == started) {
+                return {true, node, started};
+            }
+        }
+    }
+
+    /// TickClock ticks spent executing a node (monotonic; valid after start())
+    std::uint64_t node_ticks(NodeId id) const noexcept { return nodes_[id].ticks.load(std::memory_order_relaxed); }
+
+    /// Steps completed by worker (monotonic)
+    std::uint64_t worker_steps(std::size_t worker) const noexcept {
+        return workers_[worker].steps.load(std::memory_order_relaxed);
+    }
+
+    /// TickClock ticks worker spent inside steps (monotonic)
+    std::uint64_t worker_busy_ticks(std::size_t worker) const noexcept {
+        return workers_[worker].busy_ticks.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::size_t busy_bit = std::size_t{1} << (sizeof(std::size_t) * 8 - 1);
+
+    struct alignas(cache_line_size) NodeSlot {
+        std::atomic<std::size_t> claim{0};
+        std::atomic<std::uint64_t> steps{0};
+        std::atomic<std::uint64_t> ticks{0};
+        std::atomic<bool> finished{false};
+    };
+
+    struct alignas(cache_line_size) WorkerSlot {
+        std::atomic<NodeId> node{0};
+        std::atomic<std::uint64_t> started{0};
+        std::atomic<std::uint64_t> steps{0};
+        std::atomic<std::uint64_t> busy_ticks{0};
+    };
+
+    static void pin(int cpu) noexcept {
+#if defined(__linux__)
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+#else
+        (void)cpu;
+#endif
+    }
+
+    // execute_node() wrapped in flight recorder events
+    bool execute_recorded(NodeId id) noexcept {
+        const auto source = static_cast<std::uint32_t>(id);
+        const auto& options = graph_->options(id);
+        if (options.backlog) {
+            recorder_->record(EventType::QueueDepth, source, options.backlog());
+        }
+        const auto failures = graph_->stats(id).failures;
+        const auto status = graph_->status(id);
+        recorder_->record(EventType::ExecuteBegin, source);
+
+        const bool done = graph_->execute_node(id);
+
+        recorder_->record(EventType::ExecuteEnd, source, done);
+        if (graph_->stats(id).failures != failures) {
+            recorder_->record(EventType::Error, source,
+                              static_cast<std::uint64_t>(graph_->stats(id).last_error.value()));
+        }
+        if (graph_->status(id) != status) {
+            recorder_->record(EventType::StateChange, source, static_cast<std::uint64_t>(graph_->status(id)));
+        }
+        return done;
+    }
+
+    static void add(std::atomic<std::uint64_t>& counter, std::uint64_t n) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    void run(std::size_t me) noexcept {
+        auto& self = workers_[me];
+        const auto& order = graph_->order();
+        while (!stop_.load(std::memory_order_acquire) && !finished()) {
+            bool ran = false;
+            for (auto id : order) {
+                auto& slot = nodes_[id];
+                std::size_t expected = me;
+                if (slot.claim.load(std::memory_order_relaxed) != me ||
+                    !slot.claim.compare_exchange_strong(expected, me | busy_bit, std::memory_order_acquire,
+                                                        std::memory_order_relaxed)) {
+                    continue;
+                }
+                if (!slot.finished.load(std::memory_order_relaxed)) {
+                    self.node.store(id, std::memory_order_release);
+                    const auto start = TickClock::now() | 1; // Zero means idle
+                    self.started.store(start, std::memory_order_release);
+
+                    const bool done = recorder_ ? execute_recorded(id) : graph_->execute_node(id);
+
+                    const auto elapsed = TickClock::now() - start;
+                    self.started.store(0, std::memory_order_relaxed);
+                    // Single writer (this worker; the node while claimed): plain stores, no locked RMW
+                    add(self.busy_ticks, elapsed);
+                    add(self.steps, 1);
+                    add(slot.ticks, elapsed);
+                    add(slot.steps, 1);
+                    if (done) {
+                        slot.finished.store(true, std::memory_order_release);
+                        remaining_.fetch_sub(1, std::memory_order_acq_rel);
+                    }
+                    ran = true;
+                }
+                slot.claim.fetch_and(~busy_bit, std::memory_order_release);
+            }
+            if (!ran || oversubscribed_) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    Graph* graph_;
+    FlightRecorder* recorder_ = nullptr;
+    std::unique_ptr<NodeSlot[]> nodes_;
+    std::unique_ptr<WorkerSlot[]> workers_;
+    std::vector<std::thread> threads_;
+    std::size_t worker_count_ = 0;
+    bool oversubscribed_ = false;
+    std::atomic<std::size_t> remaining_{0};
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> running_{false};
+    std::atomic<std::uint64_t> migrations_{0};
+};
+
+} // namespace dspai::comp
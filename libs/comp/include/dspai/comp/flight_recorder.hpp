@@ -0,0 +1,529 @@
+#pragma once
+
+#include <dspai/comp/clock.hpp>
+#include <dspai/comp/spsc_ring.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+
+namespace dspai::comp {
+
+/**
+ * Kinds of flight recorder events
+ *
+ */
+enum class EventType : std::uint8_t {
+    ExecuteBegin, ///< value: 0
+    ExecuteEnd,   ///< value: 1 if the node finished
+    StateChange,  ///< value: new NodeStatus (or component-defined state)
+    QueueDepth,   ///< value: items waiting
+    Error,        ///< value: std::error_code::value()
+    Stall,        ///< value: nanoseconds in the overrunning step
+    Mark          ///< value: user-defined
+};
+
+/**
+ * One decoded event
+ *
+ */
+struct FlightEvent {
+    std::uint64_t tick = 0;    ///< TickClock time
+    std::uint64_t value = 0;   ///< Type-specific payload
+    std::uint32_t source = 0;  ///< Node / component id
+    std::uint16_t thread = 0;  ///< Recording ring (one per thread)
+    EventType type = EventType::Mark;
+};
+
+/**
+ * Always-on recorder of recent pipeline events for post-mortem analysis
+ *
+ * Each thread writes to its own fixed-size ring (claimed on first record(), returned when the
+ * thread exits), overwriting the oldest events; recording is wait-free: a thread_local lookup,
+ * three relaxed stores and a release store of the ring head, all preallocated at construction.
+ * - dump() writes every ring to a binary file with only open/write/close, so it may be
+ *   called from a signal handler (see install_dump_on_signal()) as well as from a watchdog
+ *   or on request. read_flight_dump() and the flight_decode tool rebuild the timeline.
+ * - Events being overwritten while a dump runs are dropped, never torn.
+ * - At most max_threads threads record at once; further threads are not recorded (counted in
+ *   lost_threads()). A returned ring keeps its events and is reused by the next new thread,
+ *   so short-lived threads (e.g. executor restarts) never exhaust the rings; a reused ring's
+ *   events share one thread number in dumps. A thread alternating between more than four
+ *   recorders returns and reclaims a ring on each switch.
+ *
+ * File format (native endianness): FileHeader, `sources` names of name_size bytes, then per
+ * ring a RingHeader followed by `count` records of three uint64 words
+ * (tick, value, source | thread << 32 | type << 48), oldest first.
+ *
+ * Thread Safety: record() from any thread; dump() from any thread or signal handler;
+ * name_source() before recording starts.
+ */
+class FlightRecorder {
+public:
+    static constexpr char magic[8] = {'D', 'S', 'P', 'A', 'I', 'F', 'R', '1'};
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::size_t name_size = 32;
+    static constexpr std::uint64_t invalid_source = 0xffffffffu; ///< Record overwritten during a dump
+
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t rings;
+        double ticks_per_ns;
+        std::uint64_t dump_tick;
+        std::uint32_t sources;
+        std::uint32_t name_size;
+    };
+
+    struct RingHeader {
+        std::uint32_t thread;
+        std::uint32_t count;
+        std::uint64_t overwritten; ///< Events lost to wrap-around
+    };
+
+    /**
+     * @param events_per_thread: ring capacity, rounded up to a power of two
+     * @param max_threads: rings available
+     * @param max_sources: entries in the source name table
+     *
+     * Allocation failure leaves a recorder that records nothing (valid() is false).
+     */
+    explicit FlightRecorder(std::size_t events_per_thread = 4096, std::size_t max_threads = 16,
+                            std::size_t max_sources = 256) noexcept
+        : id_(next_id().fetch_add(1, std::memory_order_relaxed)), ticks_per_ns_(TickClock::ticks_per_ns()) {
+        capacity_ = 1;
+        while (capacity_ < events_per_thread) {
+            capacity_ <<= 1;
+        }
+        try {
+            rings_ = std::shared_ptr<Ring[]>(new Ring[max_threads]);
+            for (std::size_t i = 0; i < max_threads; ++i) {
+                rings_[i].words = std::make_unique<std::atomic<std::uint64_t>[]>(capacity_ * 3);
+                rings_[i].index = static_cast<std::uint32_t>(i);
+            }
+            names_ = std::make_unique<char[]>(max_sources * name_size);
+            std::memset(names_.get(), 0, max_sources * name_size);
+        } catch (...) {
+            rings_.reset();
+            names_.reset();
+            return;
+        }
+        max_threads_ = max_threads;
+        max_sources_ = max_sources;
+    }
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    bool valid() const noexcept { return rings_ != nullptr; }
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    /// Label a source id in dumps (truncated to name_size - 1 bytes)
+    void name_source(std::uint32_t source, std::string_view name) noexcept {
+        if (source < max_sources_) {
+            const auto length = std::min(name.size(), name_size - 1);
+            std::memcpy(&names_[source * name_size], name.data(), length);
+            names_[source * name_size + length] = '\0';
+        }
+    }
+
+    /// Record an event on the calling thread's ring
+    void record(EventType type, std::uint32_t source, std::uint64_t value = 0) noexcept {
+        Ring* ring = this_thread_ring();
+        if (!ring) {
+            return;
+        }
+        const auto head = ring->head.load(std::memory_order_relaxed);
+        auto* slot = &ring->words[(head & (capacity_ - 1)) * 3];
+        // Invalidate the slot first so a concurrent dump never pairs old and new words
+        ring->head.store(head | busy_flag, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot[0].store(TickClock::now(), std::memory_order_relaxed);
+        slot[1].store(value, std::memory_order_relaxed);
+        slot[2].store(source | (std::uint64_t{ring->index} << 32) | (std::uint64_t{static_cast<std::uint8_t>(type)} << 48),
+                      std::memory_order_relaxed);
+        ring->head.store(head + 1, std::memory_order_release);
+    }
+
+    /// Threads that found no free ring
+    std::uint64_t lost_threads() const noexcept { return lost_threads_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Write all rings to a file. Async-signal-safe.
+     *
+     * @return std::error_code - empty on success, the errno of open/write otherwise,
+     *         operation_not_permitted if the recorder is not valid()
+     */
+    std::error_code dump(const char* path) const noexcept {
+        if (!valid()) {
+            return std::make_error_code(std::errc::operation_not_permitted);
+        }
+        const int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            return {errno, std::generic_category()};
+        }
+        const auto rings = std::min<std::size_t>(claimed_.load(std::memory_order_acquire), max_threads_);
+        FileHeader header{};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        header.rings = static_cast<std::uint32_t>(rings);
+        header.ticks_per_ns = ticks_per_ns_;
+        header.dump_tick = TickClock::now();
+        header.sources = static_cast<std::uint32_t>(max_sources_);
+        header.name_size = name_size;
+
+        bool ok = write_all(fd, &header, sizeof(header)) && write_all(fd, names_.get(), max_sources_ * name_size);
+        for (std::size_t r = 0; ok && r < rings; ++r) {
+            ok = dump_ring(fd, rings_[r]);
+        }
+        const int error = errno;
+        ::close(fd);
+        return ok ? std::error_code{} : std::error_code(error, std::generic_category());
+    }
+
+private:
+    static constexpr std::uint64_t busy_flag = std::uint64_t{1} << 63;
+
+    struct alignas(cache_line_size) Ring {
+        std::atomic<std::uint64_t> head{0}; ///< Events written; busy_flag while writing one
+        std::unique_ptr<std::atomic<std::uint64_t>[]> words;
+        std::uint32_t index = 0;            ///< Thread number in dumps
+        std::atomic<bool> in_use{false};    ///< Claimed by a live thread
+    };
+
+    // A thread's claim on one recorder's ring; returned on eviction and at thread exit. The
+    // weak reference lets a thread outliving the recorder skip the return safely.
+    struct Lease {
+        std::uint64_t recorder = 0;
+        Ring* ring = nullptr;
+        std::weak_ptr<Ring[]> rings;
+
+        void release() noexcept {
+            if (ring) {
+                if (const auto alive = rings.lock()) {
+                    ring->in_use.store(false, std::memory_order_release);
+                }
+            }
+            recorder = 0;
+            ring = nullptr;
+            rings.reset();
+        }
+    };
+
+    static std::atomic<std::uint64_t>& next_id() noexcept {
+        static std::atomic<std::uint64_t> id{1};
+        return id;
+    }
+
+    // Ring of the calling thread; a small thread_local cache of leases covers a few recorders
+    // per thread and returns them when the thread exits
+    Ring* this_thread_ring() noexcept {
+        constexpr std::size_t ways = 4;
+        struct Leases {
+            Lease entries[ways];
+            std::size_t victim = 0;
+            ~Leases() {
+                for (auto& entry : entries) {
+                    entry.release();
+                }
+            }
+        };
+        thread_local Leases leases;
+        for (const auto& entry : leases.entries) {
+            if (entry.recorder == id_) {
+                return entry.ring;
+            }
+        }
+        if (!valid()) {
+            return nullptr;
+        }
+        auto& entry = leases.entries[leases.victim++ % ways];
+        entry.release();
+        entry.recorder = id_;
+        entry.ring = claim();
+        entry.rings = rings_;
+        return entry.ring;
+    }
+
+    // First free ring (acquire pairs with the previous owner's release), or nullptr
+    Ring* claim() noexcept {
+        for (std::size_t i = 0; i < max_threads_; ++i) {
+            auto& ring = rings_[i];
+            bool expected = false;
+            if (!ring.in_use.load(std::memory_order_relaxed) &&
+                ring.in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                // dump() covers every ring up to the highest ever claimed
+                auto claimed = claimed_.load(std::memory_order_relaxed);
+                while (claimed < i + 1 && !claimed_.compare_exchange_weak(claimed, i + 1, std::memory_order_acq_rel)) {
+                }
+                return &ring;
+            }
+        }
+        lost_threads_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    static bool write_all(int fd, const void* data, std::size_t bytes) noexcept {
+        const auto* p = static_cast<const char*>(data);
+        while (bytes > 0) {
+            const auto written = ::write(fd, p, bytes);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            p += written;
+            bytes -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+    // Oldest event of the ring the writer may still be overwriting (or has overwritten)
+    std::uint64_t oldest_intact(const Ring& ring) const noexcept {
+        const auto head = ring.head.load(std::memory_order_relaxed);
+        const auto started = (head & ~busy_flag) + ((head & busy_flag) ? 1 : 0);
+        return started > capacity_ ? started - capacity_ : 0;
+    }
+
+    // Write the completed events of one ring, oldest first. Each record is checked after it
+    // is copied; one the writer overwrote meanwhile is replaced by an invalid_source record
+    // so the count in the header stays exact.
+    bool dump_ring(int fd, const Ring& ring) const noexcept {
+        constexpr std::size_t chunk = 64;
+        std::uint64_t buffer[chunk * 3];
+
+        const auto end = ring.head.load(std::memory_order_acquire) & ~busy_flag;
+        const auto begin = std::max(end > capacity_ ? end - capacity_ : 0, oldest_intact(ring));
+        RingHeader header{};
+        header.thread = ring.index;
+        header.count = static_cast<std::uint32_t>(end - std::min(begin, end));
+        header.overwritten = begin;
+        if (!write_all(fd, &header, sizeof(header))) {
+            return false;
+        }
+
+        std::size_t filled = 0;
+        for (auto i = begin; i < end; ++i) {
+            const auto* slot = &ring.words[(i & (capacity_ - 1)) * 3];
+            auto* out = &buffer[filled * 3];
+            out[0] = slot[0].load(std::memory_order_relaxed);
+            out[1] = slot[1].load(std::memory_order_relaxed);
+            out[2] = slot[2].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (i < oldest_intact(ring)) {
+                out[0] = 0;
+                out[1] = 0;
+                out[2] = invalid_source;
+            }
+            if (++filled == chunk) {
+                if (!write_all(fd, buffer, sizeof(buffer))) {
+                    return false;
+                }
+                filled = 0;
+            }
+        }
+        return write_all(fd, buffer, filled * 3 * sizeof(std::uint64_t));
+    }
+
+    std::uint64_t id_;
+    double ticks_per_ns_;
+    std::size_t capacity_ = 1;
+    std::size_t max_threads_ = 0;
+    std::size_t max_sources_ = 0;
+    std::shared_ptr<Ring[]> rings_;
+    std::unique_ptr<char[]> names_;
+    std::atomic<std::size_t> claimed_{0};
+    std::atomic<std::uint64_t> lost_threads_{0};
+};
+
+/**
+ * A flight recorder dump read back into memory
+ *
+ */
+struct FlightDump {
+    double ticks_per_ns = 1.0;
+    std::uint64_t dump_tick = 0;     ///< TickClock time of the dump
+    std::uint32_t threads = 0;       ///< Rings in the dump
+    std::uint64_t overwritten = 0;   ///< Events lost to wrap-around (all rings)
+    std::vector<std::string> names;  ///< Source names by id (empty if unnamed)
+    std::vector<FlightEvent> events; ///< All rings merged, ordered by tick
+
+    std::string_view name(std::uint32_t source) const noexcept {
+        return source < names.size() ? std::string_view(names[source]) : std::string_view{};
+    }
+};
+
+/// Lower-case name of an event type
+inline std::string_view event_type_name(EventType type) noexcept {
+    switch (type) {
+    case EventType::ExecuteBegin:
+        return "execute_begin";
+    case EventType::ExecuteEnd:
+        return "execute_end";
+    case EventType::StateChange:
+        return "state_change";
+    case EventType::QueueDepth:
+        return "queue_depth";
+    case EventType::Error:
+        return "error";
+    case EventType::Stall:
+        return "stall";
+    case EventType::Mark:
+        return "mark";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Read a file written by FlightRecorder::dump()
+ *
+ * @return the dump with events merged across threads, or
+ *         - no_such_file_or_directory / the errno of the failed read
+ *         - illegal_byte_sequence if the file is not a version 1 flight recorder dump or is truncated
+ *         - not_enough_memory
+ */
+inline std::expected<FlightDump, std::error_code> read_flight_dump(const char* path) noexcept {
+    using Header = FlightRecorder::FileHeader;
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        return std::unexpected(std::error_code(errno, std::generic_category()));
+    }
+    struct Closer {
+        std::FILE* file;
+        ~Closer() { std::fclose(file); }
+    } closer{file};
+    const auto corrupt = std::unexpected(std::make_error_code(std::errc::illegal_byte_sequence));
+
+    Header header{};
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        std::memcmp(header.magic, FlightRecorder::magic, sizeof(header.magic)) != 0 ||
+        header.version != FlightRecorder::version || header.name_size == 0) {
+        return corrupt;
+    }
+    try {
+        FlightDump dump;
+        dump.ticks_per_ns = header.ticks_per_ns;
+        dump.dump_tick = header.dump_tick;
+        dump.threads = header.rings;
+
+        std::vector<char> name(header.name_size);
+        dump.names.resize(header.sources);
+        for (auto& entry : dump.names) {
+            if (std::fread(name.data(), 1, name.size(), file) != name.size()) {
+                return corrupt;
+            }
+            entry.assign(name.data(), strnlen(name.data(), name.size()));
+        }
+
+        for (std::uint32_t r = 0; r < header.rings; ++r) {
+            FlightRecorder::RingHeader ring{};
+            if (std::fread(&ring, sizeof(ring), 1, file) != 1) {
+                return corrupt;
+            }
+            dump.overwritten += ring.overwritten;
+            for (std::uint32_t i = 0; i < ring.count; ++i) {
+                std::uint64_t words[3];
+                if (std::fread(words, sizeof(words), 1, file) != 1) {
+                    return corrupt;
+                }
+                if (words[2] == FlightRecorder::invalid_source) {
+                    continue;
+                }
+                FlightEvent event;
+                event.tick = words[0];
+                event.value = words[1];
+                event.source = static_cast<std::uint32_t>(words[2]);
+                event.thread = static_cast<std::uint16_t>(words[2] >> 32);
+                event.type = static_cast<EventType>(static_cast<std::uint8_t>(words[2] >> 48));
+                dump.events.push_back(event);
+            }
+        }
+        std::stable_sort(dump.events.begin(), dump.events.end(),
+                         [](const FlightEvent& a, const FlightEvent& b) { return a.tick < b.tick; });
+        return dump;
+    } catch (...) {
+        return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+    }
+}
+
+namespace detail {
+
+struct SignalDump {
+    std::atomic<const FlightRecorder*> recorder{nullptr};
+    char path[256] = {};
+};
+
+inline SignalDump& signal_dump() noexcept {
+    static SignalDump state;
+    return state;
+}
+
+inline void dump_on_signal(int signal) noexcept {
+    const int saved_errno = errno; // The interrupted code may be about to read errno
+    auto& state = signal_dump();
+    if (const auto* recorder = state.recorder.load(std::memory_order_acquire)) {
+        recorder->dump(state.path);
+    }
+    if (signal != SIGUSR1 && signal != SIGUSR2) {
+        // Fatal signal: continue with the default action (core dump / termination)
+        std::signal(signal, SIG_DFL);
+        std::raise(signal);
+    }
+    errno = saved_errno;
+}
+
+} // namespace detail
+
+/**
+ * @brief Dump a recorder to path when one of the signals is delivered
+ *
+ * SIGUSR1/SIGUSR2 dump and continue (explicit request from outside the process); any other
+ * signal dumps and then re-raises with the default action, so crashes still terminate and
+ * produce a core. Only one recorder/path is active per process; a later call replaces it.
+ *
+ * @return std::error_code - empty on success
+ *         - filename_too_long if path does not fit the preallocated buffer
+ *         - the errno of sigaction()
+ */
+inline std::error_code install_dump_on_signal(const FlightRecorder& recorder, const char* path,
+                                              std::span<const int> signals) noexcept {
+    auto& state = detail::signal_dump();
+    const auto length = std::strlen(path);
+    if (length >= sizeof(state.path)) {
+        return std::make_error_code(std::errc::filename_too_long);
+    }
+    state.recorder.store(nullptr, std::memory_order_release);
+    std::memcpy(state.path, path, length + 1);
+    state.recorder.store(&recorder, std::memory_order_release);
+
+    struct sigaction action {};
+    action.sa_handler = detail::dump_on_signal;
+    sigemptyset(&action.sa_mask);
+    for (auto signal : signals) {
+        if (::sigaction(signal, &action, nullptr) != 0) {
+            return {errno, std::generic_category()};
+        }
+    }
+    return {};
+}
+
+/// Stop dumping on signals (handlers stay installed but do nothing). Call before destroying the recorder.
+inline void uninstall_dump_on_signal() noexcept {
+    detail::signal_dump().recorder.store(nullptr, std::memory_order_release);
+}
+
+} // namespace dspai::comp
@@ -0,0 +1,355 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace dspai::comp {
+
+/**
+ * Instruction-set targets a kernel can be dispatched to
+ *
+ */
+enum class IsaTarget {
+    Scalar, ///< Portable C++; the reference path
+    Avx2,   ///< x86-64 AVX2 + FMA
+    Avx512  ///< x86-64 AVX-512F
+};
+
+inline std::string_view isa_target_name(IsaTarget target) noexcept {
+    switch (target) {
+    case IsaTarget::Scalar:
+        return "scalar";
+    case IsaTarget::Avx2:
+        return "avx2";
+    case IsaTarget::Avx512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+/// True if the running CPU can execute code built for target
+inline bool isa_supported(IsaTarget target) noexcept {
+    switch (target) {
+    case IsaTarget::Scalar:
+        return true;
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    case IsaTarget::Avx2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case IsaTarget::Avx512:
+        return __builtin_cpu_supports("avx512f");
+#else
+    case IsaTarget::Avx2:
+    case IsaTarget::Avx512:
+        return false;
+#endif
+    }
+    return false;
+}
+
+/**
+ * One implementation of a kernel
+ *
+ * Kernels map an input block to an output block of the same length (e.g. a filter over a
+ * block, or a component step wrapped to read/write spans).
+ */
+template <std::floating_point T>
+struct KernelVariant {
+    std::string_view name;  ///< Label in reports, e.g. "fir/avx2"
+    IsaTarget target = IsaTarget::Scalar;
+    void (*kernel)(std::span<const T> in, std::span<T> out) noexcept = nullptr;
+};
+
+/**
+ * Accepted deviation from the golden output
+ *
+ */
+struct GoldenTolerance {
+    std::uint64_t max_ulp = 4;  ///< Per-sample ULP distance; UINT64_MAX disables
+    double abs_floor = 0.0;     ///< Samples within this absolute error pass regardless of ULPs (cancellation)
+    double min_snr_db = 0.0;    ///< Signal-to-error ratio over the block; 0 disables
+};
+
+/**
+ * Golden check configuration
+ *
+ */
+struct GoldenOptions {
+    GoldenTolerance tolerance;
+    std::chrono::nanoseconds min_time = std::chrono::milliseconds(10); ///< Timed repetitions per target; 0 skips timing
+};
+
+/**
+ * Result for one kernel variant
+ *
+ */
+struct GoldenTargetResult {
+    std::string_view name;
+    IsaTarget target = IsaTarget::Scalar;
+    bool supported = false;           ///< Ran on this CPU (unsupported variants pass vacuously)
+    bool passed = false;
+    std::uint64_t max_ulp = 0;        ///< Worst per-sample ULP distance
+    std::size_t worst = 0;            ///< Index of that sample
+    std::size_t failed_samples = 0;   ///< Samples outside max_ulp and abs_floor
+    double snr_db = 0.0;              ///< infinity if bit-exact
+    double samples_per_second = 0.0;  ///< Throughput over the timed repetitions
+};
+
+/**
+ * Results of check_golden(), one per variant in the order given
+ *
+ */
+struct GoldenReport {
+    std::vector<GoldenTargetResult> targets;
+
+    bool passed() const noexcept {
+        return std::all_of(targets.begin(), targets.end(), [](const auto& t) { return t.passed; });
+    }
+};
+
+/// Deterministic input block: uniform in [-1, 1) from a 64-bit xorshift seeded with seed
+template <std::floating_point T>
+std::vector<T> golden_input(std::size_t n, std::uint64_t seed = 1) {
+    std::vector<T> data(n);
+    std::uint64_t state = seed ? seed : 0x9e3779b97f4a7c15ull;
+    for (auto& x : data) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        x = static_cast<T>(static_cast<double>(state >> 11) * 0x1.0p-52 - 1.0);
+    }
+    return data;
+}
+
+/// Distance in units in the last place between two finite values (0 if equal, max if either is NaN)
+template <std::floating_point T>
+std::uint64_t ulp_distance(T a, T b) noexcept {
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    using Bits = std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>;
+    static_assert(sizeof(T) == sizeof(Bits));
+    // Map the sign-magnitude encoding onto a monotonic integer line
+    auto ordered = [](T x) {
+        const auto bits = std::bit_cast<Bits>(x);
+        return static_cast<std::int64_t>(bits < 0 ? std::numeric_limits<Bits>::min() - bits : bits);
+    };
+    const auto ia = ordered(a);
+    const auto ib = ordered(b);
+    return ia > ib ? static_cast<std::uint64_t>(ia) - static_cast<std::uint64_t>(ib)
+                   : static_cast<std::uint64_t>(ib) - static_cast<std::uint64_t>(ia);
+}
+
+/// Signal-to-error ratio of actual against reference in dB (infinity if identical)
+template <std::floating_point T>
+double snr_db(std::span<const T> reference, std::span<const T> actual) noexcept {
+    double signal = 0.0;
+    double noise = 0.0;
+    for (std::size_t i = 0; i < std::min(reference.size(), actual.size()); ++i) {
+        const double r = reference[i];
+        const double e = r - static_cast<double>(actual[i]);
+        signal += r * r;
+        noise += e * e;
+    }
+    if (noise == 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return 10.0 * std::log10(signal / noise);
+}
+
+namespace detail {
+
+inline constexpr char golden_magic[8] = {'D', 'S', 'P', 'A', 'I', 'G', 'V', '1'};
+
+} // namespace detail
+
+/**
+ * @brief Save a golden vector
+ *
+ * Format: 8-byte magic, u32 element size, u64 count, then raw native-endian samples.
+ *
+ * @return std::error_code - empty on success, or the errno of fopen/fwrite
+ */
+template <std::floating_point T>
+std::error_code write_golden(const char* path, std::span<const T> data) noexcept {
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        return {errno, std::generic_category()};
+    }
+    const std::uint32_t size = sizeof(T);
+    const std::uint64_t count = data.size();
+    bool ok = std::fwrite(detail::golden_magic, sizeof(detail::golden_magic), 1, file) == 1 &&
+              std::fwrite(&size, sizeof(size), 1, file) == 1 && std::fwrite(&count, sizeof(count), 1, file) == 1 &&
+              std::fwrite(data.data(), sizeof(T), data.size(), file) == data.size();
+    ok = std::fclose(file) == 0 && ok;
+    return ok ? std::error_code{} : std::make_error_code(std::errc::io_error);
+}
+
+/**
+ * @brief Load a golden vector written by write_golden()
+ *
+ * @return the samples, or
+ *         - the errno of fopen
+ *         - illegal_byte_sequence if the header or element size does not match T
+ *         - io_error if the file is truncated
+ *         - not_enough_memory
+ */
+template <std::floating_point T>
+std::expected<std::vector<T>, std::error_code> read_golden(const char* path) noexcept {
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        return std::unexpected(std::error_code(errno, std::generic_category()));
+    }
+    char magic[sizeof(detail::golden_magic)];
+    std::uint32_t size = 0;
+    std::uint64_t count = 0;
+    std::error_code ec;
+    std::vector<T> data;
+    if (std::fread(magic, sizeof(magic), 1, file) != 1 || std::fread(&size, sizeof(size), 1, file) != 1 ||
+        std::fread(&count, sizeof(count), 1, file) != 1) {
+        ec = std::make_error_code(std::errc::io_error);
+    } else if (std::memcmp(magic, detail::golden_magic, sizeof(magic)) != 0 || size != sizeof(T)) {
+        ec = std::make_error_code(std::errc::illegal_byte_sequence);
+    } else {
+        try {
+            data.resize(static_cast<std::size_t>(count));
+            if (std::fread(data.data(), sizeof(T), data.size(), file) != data.size()) {
+                ec = std::make_error_code(std::errc::io_error);
+            }
+        } catch (...) {
+            ec = std::make_error_code(std::errc::not_enough_memory);
+        }
+    }
+    std::fclose(file);
+    if (ec) {
+        return std::unexpected(ec);
+    }
+    return data;
+}
+
+/**
+ * @brief Run every kernel variant on input, compare with golden and measure throughput
+ *
+ * Correctness and speed come from the same run on the same data, so a faster target cannot
+ * hide a numerical regression (and vice versa).
+ * - Variants whose target isa_supported() is false are reported unsupported and skipped.
+ * - A variant passes if every sample is within max_ulp or abs_floor of golden and the block
+ *   SNR is at least min_snr_db.
+ * - Throughput repeats the kernel until options.min_time has elapsed.
+ *
+ * @return the report, or
+ *         - invalid_argument if golden and input differ in length or a variant has no kernel
+ *         - not_enough_memory
+ */
+template <std::floating_point T>
+std::expected<GoldenReport, std::error_code> check_golden(std::span<const KernelVariant<T>> variants,
+                                                          std::span<const T> input, std::span<const T> golden,
+                                                          const GoldenOptions& options = {}) noexcept {
+    if (input.size() != golden.size()) {
+        return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    for (const auto& variant : variants) {
+        if (!variant.kernel) {
+            return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+        }
+    }
+    GoldenReport report;
+    std::vector<T> output;
+    try {
+        report.targets.resize(variants.size());
+        output.resize(input.size());
+    } catch (...) {
+        return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+    }
+
+    const auto& tolerance = options.tolerance;
+    for (std::size_t v = 0; v < variants.size(); ++v) {
+        const auto& variant = variants[v];
+        auto& result = report.targets[v];
+        result.name = variant.name;
+        result.target = variant.target;
+        result.supported = isa_supported(variant.target);
+        if (!result.supported) {
+            result.passed = true;
+            continue;
+        }
+
+        std::fill(output.begin(), output.end(), std::numeric_limits<T>::quiet_NaN());
+        variant.kernel(input, output);
+        for (std::size_t i = 0; i < output.size(); ++i) {
+            const auto ulp = ulp_distance(golden[i], output[i]);
+            if (ulp > result.max_ulp) {
+                result.max_ulp = ulp;
+                result.worst = i;
+            }
+            const bool within_floor = std::abs(static_cast<double>(golden[i]) - static_cast<double>(output[i])) <=
+                                      tolerance.abs_floor;
+            result.failed_samples += ulp > tolerance.max_ulp && !within_floor;
+        }
+        result.snr_db = snr_db<T>(golden, output);
+        result.passed = result.failed_samples == 0 && (tolerance.min_snr_db <= 0.0 || result.snr_db >= tolerance.min_snr_db);
+
+        if (options.min_time.count() > 0 && !input.empty()) {
+            const auto start = std::chrono::steady_clock::now();
+            std::uint64_t runs = 0;
+            std::chrono::nanoseconds elapsed{0};
+            do {
+                variant.kernel(input, output);
+                runs++;
+                elapsed = std::chrono::steady_clock::now() - start;
+            } while (elapsed < options.min_time);
+            result.samples_per_second = static_cast<double>(runs * input.size()) * 1e9 /
+                                        static_cast<double>(std::max<std::int64_t>(elapsed.count(), 1));
+        }
+    }
+    return report;
+}
+
+/**
+ * @brief One line per variant: verdict, ULP/SNR, throughput and speedup over the first variant
+ *
+ * Empty on allocation failure.
+ */
+inline std::string format_golden_report(const GoldenReport& report) noexcept {
+    try {
+        std::string out;
+        char line[192];
+        std::snprintf(line, sizeof(line), "%-20s %-7s %-6s %10s %8s %9s %12s %8s\n", "variant", "target", "result",
+                      "max ulp", "failed", "snr dB", "Msamples/s", "speedup");
+        out += line;
+        const double base = report.targets.empty() ? 0.0 : report.targets.front().samples_per_second;
+        for (const auto& t : report.targets) {
+            const std::string name(t.name);
+            if (!t.supported) {
+                std::snprintf(line, sizeof(line), "%-20s %-7s %-6s\n", name.c_str(),
+                              std::string(isa_target_name(t.target)).c_str(), "skip");
+            } else {
+                std::snprintf(line, sizeof(line), "%-20s %-7s %-6s %10llu %8zu %9.1f %12.2f %7.2fx\n", name.c_str(),
+                              std::string(isa_target_name(t.target)).c_str(), t.passed ? "pass" : "FAIL",
+                              static_cast<unsigned long long>(t.max_ulp), t.failed_samples, t.snr_db,
+                              t.samples_per_second / 1e6, base > 0.0 ? t.samples_per_second / base : 0.0);
+            }
+            out += line;
+        }
+        return out;
+    } catch (...) {
+        return {};
+    }
+}
+
+} // namespace dspai::comp
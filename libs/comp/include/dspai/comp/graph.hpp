@@ -0,0 +1,404 @@
+#pragma once
+
+#include <dspai/comp/execution.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#if defined(DSPAI_COMP_USDT) && __has_include(<sys/sdt.h>)
+// Opt-in USDT probes dspai:execute_begin(node) / dspai:execute_end(node, done) for perf/bpftrace
+#include <sys/sdt.h>
+#define DSPAI_COMP_PROBE1(name, a) DTRACE_PROBE1(dspai, name, a)
+#define DSPAI_COMP_PROBE2(name, a, b) DTRACE_PROBE2(dspai, name, a, b)
+#else
+#define DSPAI_COMP_PROBE1(name, a) ((void)0)
+#define DSPAI_COMP_PROBE2(name, a, b) ((void)0)
+#endif
+
+namespace dspai::comp {
+
+using NodeId = std::size_t;
+
+/// Replacement for IExecution::execute() on one node, e.g. a named perf trampoline (see PerfMap)
+using ExecuteHook = bool (*)(IExecution*) noexcept;
+
+/**
+ * What the graph does when a node's execute() fails (last_error() set)
+ *
+ */
+enum class FailurePolicy {
+    Stop,    ///< Halt the whole graph and report the error
+    Isolate, ///< Stop executing the node; the rest of the graph keeps running
+    Restart, ///< reset() the node and keep executing it (up to max_restarts, then Isolate)
+    Bypass   ///< Replace the node's step with its bypass function (Isolate if none)
+};
+
+/**
+ * Scheduling status of a graph node
+ *
+ */
+enum class NodeStatus {
+    Active,   ///< Executed every step
+    Done,     ///< Completed normally
+    Isolated, ///< Failed and removed from execution (or its bypass function finished)
+    Bypassed  ///< Failed; bypass function runs instead of execute()
+};
+
+/**
+ * How much a node matters when shedding load (see LoadShedder)
+ *
+ */
+enum class Criticality {
+    Critical, ///< Always runs at full rate
+    Optional, ///< May be skipped under overload
+    Tap       ///< Monitoring tap; decimated first, then skipped
+};
+
+/**
+ * Per-node configuration
+ *
+ */
+struct NodeOptions {
+    std::string name;                         ///< Label for reports
+    FailurePolicy policy = FailurePolicy::Stop;
+    std::uint32_t max_restarts = 3;           ///< Restart budget before falling back to Isolate
+    std::function<bool()> bypass;             ///< Pass-through step for FailurePolicy::Bypass; true when finished
+    Criticality criticality = Criticality::Critical;
+    std::function<std::size_t()> backlog;     ///< Items waiting in the node's input queue
+    std::size_t backlog_capacity = 0;         ///< Capacity of that queue (items)
+    std::function<std::size_t(std::size_t)> drop; ///< Discard up to n oldest input items; returns count
+    std::size_t output_bytes = 0;             ///< Bytes sent to each downstream node per step (cost model)
+};
+
+/**
+ * Per-node failure accounting
+ *
+ */
+struct NodeStats {
+    std::uint64_t failures = 0;       ///< Failed execute() calls
+    std::uint64_t restarts = 0;       ///< reset() calls made by FailurePolicy::Restart
+    std::uint64_t bypassed_steps = 0; ///< Steps served by the bypass function
+    std::uint64_t shed_steps = 0;     ///< Steps skipped by load shedding
+    std::uint64_t dropped = 0;        ///< Input items discarded by load shedding
+    std::error_code last_error;       ///< Most recent failure
+};
+
+/**
+ * Dataflow graph of components with failure isolation
+ *
+ * Nodes reference components owned elsewhere; edges declare producer -> consumer
+ * dependencies (data moves through the rings the components share) and fix the execution
+ * order. A failing node is handled by its FailurePolicy without tearing down the rest of the
+ * graph, so unaffected streams keep flowing at full rate.
+ * - Components are initialized and terminated by their owner (or AsyncInit).
+ * - build() validates edges and computes a topological order; call it after the last
+ *   add()/connect() and before step().
+ * - step() runs one execute() on every Active node in order.
+ * - Load shedding: set_decimation() and set_backlog_limit() throttle a node or discard its
+ *   oldest input at its own step boundaries, so queue drop() runs on the consumer's thread.
+ *
+ * Thread Safety: NOT thread-safe, except that execute_node() may run concurrently for
+ * different nodes (as multi-threaded executors do) and stopped()/error() may be read meanwhile.
+ */
+class Graph {
+public:
+    /**
+     * @brief Add a node for component
+     *
+     * @return the node id, or not_enough_memory
+     */
+    std::expected<NodeId, std::error_code> add(IExecution& component, NodeOptions options = {}) noexcept {
+        try {
+            nodes_.push_back(Node{&component, nullptr, std::move(options), {}, NodeStatus::Active, {}});
+        } catch (...) {
+            return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+        }
+        built_ = false;
+        return nodes_.size() - 1;
+    }
+
+    /**
+     * @brief Declare that `to` consumes data produced by `from`
+     *
+     * @return std::error_code - empty on success
+     *         - invalid_argument if either id is out of range or from == to
+     *         - not_enough_memory
+     */
+    std::error_code connect(NodeId from, NodeId to) noexcept {
+        if (from >= nodes_.size() || to >= nodes_.size() || from == to) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+        try {
+            nodes_[from].downstream.push_back(to);
+        } catch (...) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        built_ = false;
+        return {};
+    }
+
+    /**
+     * @brief Compute the execution order
+     *
+     * @return std::error_code - empty on success
+     *         - invalid_argument if the edges contain a cycle
+     *         - not_enough_memory
+     */
+    std::error_code build() noexcept {
+        std::vector<NodeId> order;
+        std::vector<std::size_t> indegree;
+        try {
+            order.reserve(nodes_.size());
+            indegree.assign(nodes_.size(), 0);
+        } catch (...) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        for (const auto& node : nodes_) {
+            for (auto to : node.downstream) {
+                indegree[to]++;
+            }
+        }
+        // Kahn's algorithm; ties keep insertion order
+        for (NodeId id = 0; id < nodes_.size(); ++id) {
+            if (indegree[id] == 0) {
+                order.push_back(id);
+            }
+        }
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            for (auto to : nodes_[order[i]].downstream) {
+                if (--indegree[to] == 0) {
+                    order.push_back(to);
+                }
+            }
+        }
+        if (order.size() != nodes_.size()) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+        std::unique_ptr<Shedding[]> shedding(new (std::nothrow) Shedding[nodes_.size()]);
+        if (!shedding && !nodes_.empty()) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        order_ = std::move(order);
+        shedding_ = std::move(shedding);
+        built_ = true;
+        return {};
+    }
+
+    bool built() const noexcept { return built_; }
+    std::size_t size() const noexcept { return nodes_.size(); }
+
+    /// Topological execution order (valid after build())
+    const std::vector<NodeId>& order() const noexcept { return order_; }
+
+    IExecution& component(NodeId id) const noexcept { return *nodes_[id].component; }
+    const NodeOptions& options(NodeId id) const noexcept { return nodes_[id].options; }
+    const std::vector<NodeId>& downstream(NodeId id) const noexcept { return nodes_[id].downstream; }
+    NodeStatus status(NodeId id) const noexcept { return nodes_[id].status; }
+    const NodeStats& stats(NodeId id) const noexcept { return nodes_[id].stats; }
+
+    /// Error that halted the graph (FailurePolicy::Stop), empty if running
+    std::error_code error() const noexcept { return stopped() ? error_ : std::error_code{}; }
+    bool stopped() const noexcept { return stopped_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Route a node's execute() through hook instead (nullptr restores the direct call)
+     *
+     * Set while the graph is not executing.
+     */
+    void set_execute_hook(NodeId id, ExecuteHook hook) noexcept { nodes_[id].execute = hook; }
+    ExecuteHook execute_hook(NodeId id) const noexcept { return nodes_[id].execute; }
+
+    /**
+     * @brief Throttle a node: run 1 step in `factor` (1 = full rate, 0 = skip entirely)
+     *
+     * Takes effect at the node's next step; skipped steps count as NodeStats::shed_steps.
+     * Nothing consumes the input of a skipped step, so a node with NodeOptions::drop has its
+     * whole backlog discarded on each one (counted as NodeStats::dropped); its queue then
+     * neither stays full nor back-pressures the producer. Thread-safe; valid after build().
+     */
+    void set_decimation(NodeId id, std::uint32_t factor) noexcept {
+        shedding_[id].decimation.store(factor, std::memory_order_relaxed);
+    }
+
+    std::uint32_t decimation(NodeId id) const noexcept {
+        return shedding_[id].decimation.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Bound a node's input backlog: before each step, drop() the oldest items above limit
+     *
+     * Needs NodeOptions::backlog and NodeOptions::drop; SIZE_MAX disables. Dropped items count as
+     * NodeStats::dropped. Thread-safe; valid after build().
+     */
+    void set_backlog_limit(NodeId id, std::size_t limit) noexcept {
+        shedding_[id].backlog_limit.store(limit, std::memory_order_relaxed);
+    }
+
+    std::size_t backlog_limit(NodeId id) const noexcept {
+        return shedding_[id].backlog_limit.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Run one step of every Active (or Bypassed) node in topological order
+     *
+     * @return true if nothing is left to run: every node is Done or Isolated, or the graph
+     *         was stopped by a failure (see error()). false if not built.
+     */
+    bool step() noexcept {
+        if (!built_) {
+            return false;
+        }
+        bool finished = true;
+        for (auto id : order_) {
+            if (stopped()) {
+                return true;
+            }
+            finished &= execute_node(id);
+        }
+        return finished || stopped();
+    }
+
+    /**
+     * @brief Execute one step of a single node and apply its failure policy
+     *
+     * Building block for executors that distribute nodes over threads. Must not be called
+     * concurrently for the same node.
+     *
+     * @return true if the node has nothing left to run (Done or Isolated)
+     */
+    bool execute_node(NodeId id) noexcept {
+        auto& node = nodes_[id];
+        switch (node.status) {
+        case NodeStatus::Active:
+            break;
+        case NodeStatus::Bypassed:
+            node.stats.bypassed_steps++;
+            if (node.options.bypass()) {
+                node.status = NodeStatus::Isolated; // Pass-through has nothing left to forward
+                return true;
+            }
+            return false;
+        case NodeStatus::Done:
+        case NodeStatus::Isolated:
+            return true;
+        }
+
+        if (shed(id, node)) {
+            return false;
+        }
+        DSPAI_COMP_PROBE1(execute_begin, id);
+        const bool finished = node.execute ? node.execute(node.component) : node.component->execute();
+        DSPAI_COMP_PROBE2(execute_end, id, finished);
+        if (!finished) {
+            return false;
+        }
+        if (auto ec = node.component->last_error()) {
+            return handle_failure(node, ec);
+        }
+        node.status = NodeStatus::Done;
+        return true;
+    }
+
+    /**
+     * @brief Reset every node and resume execution
+     *
+     * Clears node statuses and the stop error; failure statistics are kept.
+     */
+    void reset() noexcept {
+        for (auto& node : nodes_) {
+            node.component->reset();
+            node.status = NodeStatus::Active;
+        }
+        error_ = {};
+        stopping_.store(false, std::memory_order_relaxed);
+        stopped_.store(false, std::memory_order_release);
+    }
+
+private:
+    struct Node {
+        IExecution* component;
+        ExecuteHook execute;
+        NodeOptions options;
+        std::vector<NodeId> downstream;
+        NodeStatus status;
+        NodeStats stats;
+    };
+
+    struct Shedding {
+        std::atomic<std::uint32_t> decimation{1};
+        std::atomic<std::size_t> backlog_limit{~std::size_t{0}};
+        std::uint64_t phase = 0; // Owner thread only
+    };
+
+    // Apply load shedding; returns true if this step is skipped
+    bool shed(NodeId id, Node& node) noexcept {
+        auto& shedding = shedding_[id];
+        const auto factor = shedding.decimation.load(std::memory_order_relaxed);
+        if (factor != 1 && (factor == 0 || shedding.phase++ % factor != 0)) {
+            node.stats.shed_steps++;
+            if (node.options.drop) {
+                const auto depth = node.options.backlog ? node.options.backlog() : ~std::size_t{0};
+                if (depth > 0) {
+                    node.stats.dropped += node.options.drop(depth);
+                }
+            }
+            return true;
+        }
+        const auto limit = shedding.backlog_limit.load(std::memory_order_relaxed);
+        if (limit != ~std::size_t{0} && node.options.backlog && node.options.drop) {
+            const auto depth = node.options.backlog();
+            if (depth > limit) {
+                node.stats.dropped += node.options.drop(depth - limit);
+            }
+        }
+        return false;
+    }
+
+    // Returns true if the node has nothing left to run
+    bool handle_failure(Node& node, std::error_code ec) noexcept {
+        node.stats.failures++;
+        node.stats.last_error = ec;
+
+        switch (node.options.policy) {
+        case FailurePolicy::Stop:
+            node.status = NodeStatus::Isolated;
+            if (!stopping_.exchange(true, std::memory_order_relaxed)) {
+                error_ = ec; // First failure wins; published by stopped_
+                stopped_.store(true, std::memory_order_release);
+            }
+            return true;
+        case FailurePolicy::Restart:
+            if (node.stats.restarts < node.options.max_restarts) {
+                node.stats.restarts++;
+                node.component->reset();
+                return false;
+            }
+            break;
+        case FailurePolicy::Bypass:
+            if (node.options.bypass) {
+                node.status = NodeStatus::Bypassed;
+                return false;
+            }
+            break;
+        case FailurePolicy::Isolate:
+            break;
+        }
+        node.status = NodeStatus::Isolated;
+        return true;
+    }
+
+    std::vector<Node> nodes_;
+    std::vector<NodeId> order_;
+    std::unique_ptr<Shedding[]> shedding_;
+    std::error_code error_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> stopped_{false};
+    bool built_ = false;
+};
+
+} // namespace dspai::comp
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <dspai/comp/clock.hpp>
+#include <dspai/comp/tag.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+
+namespace dspai::comp {
+
+/**
+ * Lock-free latency histogram with power-of-two nanosecond buckets
+ *
+ * Bucket 0 holds [0, 2) ns, bucket i >= 1 holds [2^i, 2^(i+1)) ns, so percentiles are
+ * accurate to within a factor of two. Fixed size, no allocation.
+ *
+ * Thread Safety: record() from any number of threads; readers see a consistent-enough
+ * snapshot (each counter is individually atomic).
+ */
+class LatencyHistogram {
+public:
+    static constexpr std::size_t buckets = 64;
+
+    void record(std::chrono::nanoseconds latency) noexcept {
+        const auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count(), 0));
+        buckets_[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(ns, std::memory_order_relaxed);
+        auto max = max_.load(std::memory_order_relaxed);
+        while (ns > max && !max_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+        }
+        auto min = min_.load(std::memory_order_relaxed);
+        while (ns < min && !min_.compare_exchange_weak(min, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::uint64_t count() const noexcept { return count_.load(std::memory_order_relaxed); }
+    std::uint64_t bucket(std::size_t i) const noexcept { return buckets_[i].load(std::memory_order_relaxed); }
+
+    std::chrono::nanoseconds min() const noexcept {
+        return std::chrono::nanoseconds(count() ? min_.load(std::memory_order_relaxed) : 0);
+    }
+    std::chrono::nanoseconds max() const noexcept {
+        return std::chrono::nanoseconds(max_.load(std::memory_order_relaxed));
+    }
+    std::chrono::nanoseconds mean() const noexcept {
+        const auto n = count();
+        return std::chrono::nanoseconds(n ? sum_.load(std::memory_order_relaxed) / n : 0);
+    }
+
+    /**
+     * @brief Upper bound of the bucket holding the p-th percentile (p in [0, 100]), capped at max()
+     *
+     * @return zero if empty
+     */
+    std::chrono::nanoseconds percentile(double p) const noexcept {
+        const auto n = count();
+        if (n == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+        const auto rank = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(n - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < buckets; ++i) {
+            seen += bucket(i);
+            if (seen >= rank) {
+                const std::uint64_t upper = i >= 63 ? ~std::uint64_t{0} : (std::uint64_t{2} << i) - 1;
+                return std::chrono::nanoseconds(std::min(upper, static_cast<std::uint64_t>(max().count())));
+            }
+        }
+        return max();
+    }
+
+    /// Clear all counters (not concurrently with record())
+    void reset() noexcept {
+        for (auto& b : buckets_) {
+            b.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        min_.store(~std::uint64_t{0}, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    static constexpr std::size_t bucket_of(std::uint64_t ns) noexcept {
+        return ns < 2 ? 0 : static_cast<std::size_t>(std::bit_width(ns) - 1);
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, buckets> buckets_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> min_{~std::uint64_t{0}};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+/**
+ * Sampled end-to-end latency tracing through a graph, carried by TagKey::Latency tags
+ *
+ * Flow of one probe:
+ * - Source: sample() is true every `period` blocks; stamp() returns a Latency tag for the
+ *   block's first sample, to post on the source's TagOutput next to its data.
+ * - Each stage: when its TagInput yields a Latency tag, arrive() records the time the probe
+ *   waited on the edge (queueing); after processing the block, depart() records processing
+ *   time and returns the tag to post downstream (stamped with the new enqueue time).
+ * - Sink: complete() records the end-to-end latency from the source stamp.
+ * Unsampled blocks carry no tag, so the cost is the sample() counter at the source and the
+ * TagInput::take() the components already do.
+ *
+ * Probes are tracked by sequence number in a table of max_in_flight origins; a probe whose
+ * slot was reused by a newer one before it reached the sink is counted as stale().
+ *
+ * Thread Safety: source calls (sample()/stamp()) from one thread; arrive()/depart() for a
+ * stage from the thread running it; complete() and readers from any thread.
+ */
+class LatencyTracer {
+public:
+    LatencyTracer() = default;
+    LatencyTracer(const LatencyTracer&) = delete;
+    LatencyTracer& operator=(const LatencyTracer&) = delete;
+
+    /**
+     * @brief Allocate per-stage histograms and the probe table
+     *
+     * - Discards previous results. No exceptions.
+     *
+     * @param stages: number of instrumented stages (stage ids 0..stages-1)
+     * @param period: stamp one block in period (>= 1)
+     * @param max_in_flight: probes that may be in the graph at once
+     * @return std::error_code - invalid_argument if any argument is zero, not_enough_memory
+     */
+    std::error_code allocate(std::size_t stages, std::uint32_t period, std::size_t max_in_flight = 256) noexcept {
+        if (stages == 0 || period == 0 || max_in_flight == 0) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+        const auto slots = std::bit_ceil(max_in_flight);
+        std::unique_ptr<Stage[]> stage(new (std::nothrow) Stage[stages]);
+        std::unique_ptr<Origin[]> origins(new (std::nothrow) Origin[slots]);
+        if (!stage || !origins) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        stages_ = std::move(stage);
+        origins_ = std::move(origins);
+        stage_count_ = stages;
+        mask_ = slots - 1;
+        period_ = period;
+        countdown_ = 1;
+        sequence_ = 0;
+        end_to_end_.reset();
+        stale_.store(0, std::memory_order_relaxed);
+        return {};
+    }
+
+    std::size_t stages() const noexcept { return stage_count_; }
+
+    /// Label a stage in report() (call before tracing starts)
+    void name_stage(std::size_t stage, std::string name) noexcept {
+        if (stage < stage_count_) {
+            stages_[stage].name = std::move(name);
+        }
+    }
+
+    /// Source: true if the current block should carry a probe
+    bool sample() noexcept {
+        if (--countdown_ != 0) {
+            return false;
+        }
+        countdown_ = period_;
+        return origins_ != nullptr;
+    }
+
+    /// Source: start a probe at offset; post the returned tag with the block
+    Tag stamp(std::uint64_t offset) noexcept {
+        const auto now = TickClock::now();
+        const auto sequence = sequence_++;
+        auto& origin = origins_[sequence & mask_];
+        origin.sequence.store(~std::uint32_t{0}, std::memory_order_relaxed);
+        // Pairs with the acquire fence in complete(): the invalidation is visible before the tick
+        std::atomic_thread_fence(std::memory_order_release);
+        origin.tick.store(now, std::memory_order_relaxed);
+        origin.sequence.store(sequence, std::memory_order_release);
+        return make_tag(offset, TagKey::Latency, now, sequence);
+    }
+
+    /**
+     * @brief Stage: a probe was dequeued; records its queueing time
+     *
+     * @return the arrival tick, to pass to depart()
+     */
+    std::uint64_t arrive(std::size_t stage, const Tag& probe) noexcept {
+        const auto now = TickClock::now();
+        stages_[stage].queueing.record(elapsed(probe.value, now));
+        return now;
+    }
+
+    /// Stage: processing of the probe's block is done; records it and returns the tag to post downstream
+    Tag depart(std::size_t stage, const Tag& probe, std::uint64_t arrived, std::uint64_t out_offset) noexcept {
+        const auto now = TickClock::now();
+        stages_[stage].processing.record(elapsed(arrived, now));
+        Tag next = probe;
+        next.offset = out_offset;
+        next.value = now;
+        return next;
+    }
+
+    /// Sink: the probe reached the end of the graph; records end-to-end latency
+    void complete(const Tag& probe) noexcept {
+        const auto now = TickClock::now();
+        const auto& origin = origins_[probe.aux & mask_];
+        if (origin.sequence.load(std::memory_order_acquire) != probe.aux) {
+            stale_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const auto start = origin.tick.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (origin.sequence.load(std::memory_order_relaxed) != probe.aux) {
+            stale_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        end_to_end_.record(elapsed(start, now));
+    }
+
+    const LatencyHistogram& queueing(std::size_t stage) const noexcept { return stages_[stage].queueing; }
+    const LatencyHistogram& processing(std::size_t stage) const noexcept { return stages_[stage].processing; }
+    const LatencyHistogram& end_to_end() const noexcept { return end_to_end_; }
+
+    /// Probes that completed after their origin slot was reused
+    std::uint64_t stale() const noexcept { return stale_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Per-stage p50/p99 queueing and processing, and end-to-end latency, one line each
+     *
+     * Empty on allocation failure.
+     */
+    std::string report() const noexcept {
+        try {
+            std::string out;
+            char line[160];
+            auto us = [](std::chrono::nanoseconds ns) { return static_cast<double>(ns.count()) / 1e3; };
+            for (std::size_t i = 0; i < stage_count_; ++i) {
+                const auto& stage = stages_[i];
+                const auto label = stage.name.empty() ? "stage" + std::to_string(i) : stage.name;
+                std::snprintf(line, sizeof(line),
+                              "%-20s n=%-8llu queue p50 %.3f us p99 %.3f us | process p50 %.3f us p99 %.3f us\n",
+                              label.c_str(), static_cast<unsigned long long>(stage.processing.count()),
+                              us(stage.queueing.percentile(50)), us(stage.queueing.percentile(99)),
+                              us(stage.processing.percentile(50)), us(stage.processing.percentile(99)));
+                out += line;
+            }
+            std::snprintf(line, sizeof(line), "%-20s n=%-8llu p50 %.3f us p99 %.3f us max %.3f us\n", "end-to-end",
+                          static_cast<unsigned long long>(end_to_end_.count()), us(end_to_end_.percentile(50)),
+                          us(end_to_end_.percentile(99)), us(end_to_end_.max()));
+            out += line;
+            return out;
+        } catch (...) {
+            return {};
+        }
+    }
+
+private:
+    struct Stage {
+        std::string name;
+        LatencyHistogram queueing;
+        LatencyHistogram processing;
+    };
+
+    struct Origin {
+        std::atomic<std::uint32_t> sequence{~std::uint32_t{0}};
+        std::atomic<std::uint64_t> tick{0};
+    };
+
+    static std::chrono::nanoseconds elapsed(std::uint64_t from, std::uint64_t to) noexcept {
+        return to > from ? TickClock::to_duration(to - from) : std::chrono::nanoseconds(0);
+    }
+
+    std::unique_ptr<Stage[]> stages_;
+    std::unique_ptr<Origin[]> origins_;
+    std::size_t stage_count_ = 0;
+    std::size_t mask_ = 0;
+    std::uint32_t period_ = 1;
+    std::uint32_t countdown_ = 1;
+    std::uint32_t sequence_ = 0;
+    LatencyHistogram end_to_end_;
+    std::atomic<std::uint64_t> stale_{0};
+};
+
+} // namespace dspai::comp
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <dspai/comp/graph.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dspai::comp {
+
+/**
+ * Shedding stages, applied cumulatively as overload persists
+ *
+ */
+enum class ShedLevel {
+    None,         ///< Everything at full rate
+    DecimateTaps, ///< Tap nodes run 1 step in tap_decimation
+    SkipOptional, ///< Optional and Tap nodes are skipped
+    DropOldest    ///< Inputs with a drop() hook are bounded to the high watermark
+};
+
+/**
+ * LoadShedder configuration
+ *
+ */
+struct ShedConfig {
+    double high_watermark = 0.75;     ///< Backlog fill fraction that signals overload
+    double low_watermark = 0.25;      ///< Backlog fill fraction that signals recovery
+    std::uint32_t sustain = 3;        ///< Consecutive update() calls before changing level
+    std::uint32_t tap_decimation = 4; ///< Decimation factor at ShedLevel::DecimateTaps
+    ShedLevel max_level = ShedLevel::DropOldest; ///< Highest stage to escalate to
+};
+
+/**
+ * Detects sustained overload from queue backlogs and applies load shedding to a Graph
+ *
+ * Every node with NodeOptions::backlog and backlog_capacity is a probe. update(), called
+ * periodically from a control thread, samples the probes:
+ * - Overloaded: some backlog is at or above high_watermark, or is above low_watermark and
+ *   has grown since the previous update (arrival rate exceeds service rate).
+ * - Recovered: every backlog is at or below low_watermark.
+ * After `sustain` consecutive overloaded updates the level escalates one stage; after
+ * `sustain` recovered updates it de-escalates one stage (hysteresis against flapping).
+ * Critical nodes always run at full rate; DropOldest bounds memory by discarding the oldest
+ * input of any node that provides drop(). Decimated or skipped nodes with drop() discard
+ * their input on every skipped step, so their backlog clears and recovery is detected. What
+ * was shed is accounted per node in
+ * NodeStats::shed_steps / NodeStats::dropped.
+ *
+ * Thread Safety: update() from one control thread; the graph may be running on any executor.
+ */
+class LoadShedder {
+public:
+    LoadShedder(Graph& graph, ShedConfig config = {}) noexcept : graph_(&graph), config_(config) {}
+
+    /**
+     * @brief Sample backlogs and adjust the shedding level
+     *
+     * @return the level now in effect
+     */
+    ShedLevel update() noexcept {
+        if (!graph_->built()) {
+            return level_;
+        }
+        if (last_depth_.size() != graph_->size()) {
+            try {
+                last_depth_.assign(graph_->size(), 0);
+            } catch (...) {
+                return level_;
+            }
+        }
+
+        bool overloaded = false;
+        bool recovered = true;
+        for (NodeId id = 0; id < graph_->size(); ++id) {
+            const auto& options = graph_->options(id);
+            if (!options.backlog || options.backlog_capacity == 0) {
+                continue;
+            }
+            const auto depth = options.backlog();
+            const double fill = static_cast<double>(depth) / static_cast<double>(options.backlog_capacity);
+            const bool growing = depth > last_depth_[id];
+            last_depth_[id] = depth;
+
+            if (fill >= config_.high_watermark || (fill > config_.low_watermark && growing)) {
+                overloaded = true;
+            }
+            if (fill > config_.low_watermark) {
+                recovered = false;
+            }
+        }
+
+        overloaded_updates_ = overloaded ? overloaded_updates_ + 1 : 0;
+        recovered_updates_ = recovered ? recovered_updates_ + 1 : 0;
+        if (overloaded_updates_ >= config_.sustain && level_ < config_.max_level) {
+            apply(static_cast<ShedLevel>(static_cast<int>(level_) + 1));
+            overloaded_updates_ = 0;
+            escalations_++;
+        } else if (recovered_updates_ >= config_.sustain && level_ > ShedLevel::None) {
+            apply(static_cast<ShedLevel>(static_cast<int>(level_) - 1));
+            recovered_updates_ = 0;
+        }
+        return level_;
+    }
+
+    ShedLevel level() const noexcept { return level_; }
+
+    /// Number of times the level was raised
+    std::uint64_t escalations() const noexcept { return escalations_; }
+
+    /// Steps skipped across all nodes (NodeStats; read while the graph is not executing)
+    std::uint64_t shed_steps() const noexcept {
+        std::uint64_t total = 0;
+        for (NodeId id = 0; id < graph_->size(); ++id) {
+            total += graph_->stats(id).shed_steps;
+        }
+        return total;
+    }
+
+    /// Input items dropped across all nodes (NodeStats; read while the graph is not executing)
+    std::uint64_t dropped() const noexcept {
+        std::uint64_t total = 0;
+        for (NodeId id = 0; id < graph_->size(); ++id) {
+            total += graph_->stats(id).dropped;
+        }
+        return total;
+    }
+
+private:
+    void apply(ShedLevel level) noexcept {
+        level_ = level;
+        for (NodeId id = 0; id < graph_->size(); ++id) {
+            const auto& options = graph_->options(id);
+            std::uint32_t factor = 1;
+            if (options.criticality == Criticality::Tap && level >= ShedLevel::DecimateTaps) {
+                factor = level >= ShedLevel::SkipOptional ? 0 : config_.tap_decimation;
+            } else if (options.criticality == Criticality::Optional && level >= ShedLevel::SkipOptional) {
+                factor = 0;
+            }
+            graph_->set_decimation(id, factor);
+
+            std::size_t limit = ~std::size_t{0};
+            if (level >= ShedLevel::DropOldest && options.backlog_capacity > 0) {
+                limit = static_cast<std::size_t>(config_.high_watermark * static_cast<double>(options.backlog_capacity));
+            }
+            graph_->set_backlog_limit(id, limit);
+        }
+    }
+
+    Graph* graph_;
+    ShedConfig config_;
+    ShedLevel level_ = ShedLevel::None;
+    std::uint32_t overloaded_updates_ = 0;
+    std::uint32_t recovered_updates_ = 0;
+    std::uint64_t escalations_ = 0;
+    std::vector<std::size_t> last_depth_;
+};
+
+} // namespace dspai::comp
@@ -0,0 +1,370 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace dspai::comp {
+
+/**
+ * Memory resource that attributes allocations to a named account with an optional budget
+ *
+ * Accounts form a tree (component -> graph -> process): an allocation is charged to the
+ * account and every ancestor, and fails with std::bad_alloc if it would take any of them
+ * past its budget, without charging anything. Memory itself comes from the upstream
+ * resource. Components allocate through Component::memory(), typically with make_array()
+ * or std::pmr containers in doInitialize().
+ * - bytes()/peak() count requested bytes; resident() asks the kernel which of the account's
+ *   pages are actually in RAM (mincore), so untouched allocations show up as not resident.
+ * - Bookkeeping is a per-block header plus a mutex-protected list; intended for
+ *   initialization-time allocation, not for hot paths.
+ *
+ * Thread Safety: allocation/deallocation and counters are thread-safe. Construct and destroy
+ * accounts (which links them into their parent) while no sibling is being created or
+ * destroyed concurrently; destroy children before parents.
+ */
+class MemoryAccount : public std::pmr::memory_resource {
+public:
+    /**
+     * @param budget: maximum live bytes including children; 0 = unlimited
+     * @param upstream: where memory comes from (default: parent's upstream, else new/delete)
+     */
+    explicit MemoryAccount(std::string name, MemoryAccount* parent = nullptr, std::size_t budget = 0,
+                           std::pmr::memory_resource* upstream = nullptr) noexcept
+        : name_(std::move(name)), parent_(parent), budget_(budget),
+          upstream_(upstream ? upstream : parent ? parent->upstream_ : std::pmr::new_delete_resource()) {
+        if (parent_) {
+            next_sibling_ = parent_->first_child_;
+            parent_->first_child_ = this;
+        }
+    }
+    MemoryAccount(const MemoryAccount&) = delete;
+    MemoryAccount& operator=(const MemoryAccount&) = delete;
+
+    /// Live allocations are leaked to upstream (callers must free them first)
+    ~MemoryAccount() noexcept override {
+        if (parent_) {
+            for (auto** link = &parent_->first_child_; *link; link = &(*link)->next_sibling_) {
+                if (*link == this) {
+                    *link = next_sibling_;
+                    break;
+                }
+            }
+        }
+    }
+
+    const std::string& name() const noexcept { return name_; }
+    MemoryAccount* parent() const noexcept { return parent_; }
+    const MemoryAccount* first_child() const noexcept { return first_child_; }
+    const MemoryAccount* next_sibling() const noexcept { return next_sibling_; }
+
+    /// Live bytes, including children
+    std::size_t bytes() const noexcept { return bytes_.load(std::memory_order_relaxed); }
+    /// Highest bytes() seen
+    std::size_t peak() const noexcept { return peak_.load(std::memory_order_relaxed); }
+    /// Allocations made directly through this account
+    std::uint64_t allocations() const noexcept { return allocations_.load(std::memory_order_relaxed); }
+    /// Allocations refused because this account's budget would be exceeded
+    std::uint64_t denied() const noexcept { return denied_.load(std::memory_order_relaxed); }
+
+    std::size_t budget() const noexcept { return budget_.load(std::memory_order_relaxed); }
+    /// Change the budget (0 = unlimited); existing allocations are not affected
+    void set_budget(std::size_t budget) noexcept { budget_.store(budget, std::memory_order_relaxed); }
+
+    /**
+     * @brief Bytes of this account's own blocks (not children) resident in RAM
+     *
+     * Counts whole pages overlapping each block, so small blocks sharing a page are
+     * over-reported. Returns bytes() of own blocks where mincore() is unavailable.
+     */
+    std::size_t resident() const noexcept {
+        std::lock_guard lock(mutex_);
+        std::size_t total = 0;
+        for (const Block* block = blocks_; block; block = block->next) {
+            total += resident_bytes(reinterpret_cast<const char*>(block) + block->header, block->size);
+        }
+        return total;
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        const auto header = header_size(alignment);
+        if (!charge_chain(this, bytes)) {
+            throw std::bad_alloc();
+        }
+
+        void* memory = nullptr;
+        try {
+            memory = upstream_->allocate(header + bytes, std::max(alignment, alignof(Block)));
+        } catch (...) {
+            for (auto* account = this; account; account = account->parent_) {
+                account->bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+            }
+            throw;
+        }
+        auto* block = static_cast<Block*>(memory);
+        block->size = bytes;
+        block->header = header;
+        {
+            std::lock_guard lock(mutex_);
+            block->prev = nullptr;
+            block->next = blocks_;
+            if (blocks_) {
+                blocks_->prev = block;
+            }
+            blocks_ = block;
+        }
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        return static_cast<char*>(memory) + header;
+    }
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override {
+        const auto header = header_size(alignment);
+        auto* block = reinterpret_cast<Block*>(static_cast<char*>(pointer) - header);
+        {
+            std::lock_guard lock(mutex_);
+            (block->prev ? block->prev->next : blocks_) = block->next;
+            if (block->next) {
+                block->next->prev = block->prev;
+            }
+        }
+        for (auto* account = this; account; account = account->parent_) {
+            account->bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+        upstream_->deallocate(block, header + bytes, std::max(alignment, alignof(Block)));
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    struct Block {
+        Block* prev;
+        Block* next;
+        std::size_t size;
+        std::size_t header;
+    };
+
+    static constexpr std::size_t header_size(std::size_t alignment) noexcept {
+        return (sizeof(Block) + alignment - 1) / alignment * alignment;
+    }
+
+    // Charge bytes to account and its ancestors. Peaks are raised only once every budget on
+    // the chain has accepted, so a denied allocation never shows up in a peak.
+    static bool charge_chain(MemoryAccount* account, std::size_t bytes) noexcept {
+        if (!account) {
+            return true;
+        }
+        std::size_t now = 0;
+        if (!account->charge(bytes, now)) {
+            account->denied_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (!charge_chain(account->parent_, bytes)) {
+            account->bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+            return false;
+        }
+        auto peak = account->peak_.load(std::memory_order_relaxed);
+        while (now > peak && !account->peak_.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+        }
+        return true;
+    }
+
+    // Add bytes unless the budget would be exceeded; now receives the new total
+    bool charge(std::size_t bytes, std::size_t& now) noexcept {
+        const auto budget = budget_.load(std::memory_order_relaxed);
+        auto current = bytes_.load(std::memory_order_relaxed);
+        do {
+            if (budget && current + bytes > budget) {
+                return false;
+            }
+        } while (!bytes_.compare_exchange_weak(current, current + bytes, std::memory_order_relaxed));
+        now = current + bytes;
+        return true;
+    }
+
+    static std::size_t resident_bytes(const char* data, std::size_t size) noexcept {
+#if defined(__linux__)
+        if (size == 0) {
+            return 0;
+        }
+        const auto page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+        const auto begin = reinterpret_cast<std::uintptr_t>(data) / page * page;
+        const auto end = (reinterpret_cast<std::uintptr_t>(data) + size + page - 1) / page * page;
+        std::size_t resident = 0;
+        unsigned char status[64];
+        for (auto chunk = begin; chunk < end; chunk += sizeof(status) * page) {
+            const auto length = std::min<std::uintptr_t>(end - chunk, sizeof(status) * page);
+            if (::mincore(reinterpret_cast<void*>(chunk), length, status) != 0) {
+                return size;
+            }
+            for (std::size_t i = 0; i < length / page; ++i) {
+                resident += (status[i] & 1) ? page : 0;
+            }
+        }
+        return resident;
+#else
+        (void)data;
+        return size;
+#endif
+    }
+
+    std::string name_;
+    MemoryAccount* parent_;
+    std::atomic<std::size_t> budget_;
+    std::pmr::memory_resource* upstream_;
+    MemoryAccount* first_child_ = nullptr;
+    MemoryAccount* next_sibling_ = nullptr;
+    std::atomic<std::size_t> bytes_{0};
+    std::atomic<std::size_t> peak_{0};
+    std::atomic<std::uint64_t> allocations_{0};
+    std::atomic<std::uint64_t> denied_{0};
+    mutable std::mutex mutex_;
+    Block* blocks_ = nullptr;
+};
+
+/**
+ * Deleter for arrays allocated from a memory resource by make_array()
+ */
+template <typename T>
+struct ResourceDeleter {
+    std::pmr::memory_resource* resource = nullptr;
+    std::size_t size = 0;
+
+    void operator()(T* data) const noexcept {
+        std::destroy_n(data, size);
+        resource->deallocate(data, size * sizeof(T), alignof(T));
+    }
+};
+
+template <typename T>
+using ResourceArray = std::unique_ptr<T[], ResourceDeleter<T>>;
+
+/**
+ * @brief Allocate n value-initialized T from resource
+ *
+ * Counterpart of `new (std::nothrow) T[n]` for accounted memory.
+ *
+ * @return the array, or nullptr if allocation failed or a budget was exceeded
+ */
+template <typename T>
+ResourceArray<T> make_array(std::pmr::memory_resource* resource, std::size_t n) noexcept {
+    static_assert(std::is_nothrow_default_constructible_v<T>);
+    if (n > std::size_t(-1) / sizeof(T)) {
+        return ResourceArray<T>(nullptr, ResourceDeleter<T>{resource, 0});
+    }
+    T* data = nullptr;
+    try {
+        data = static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+    } catch (...) {
+        return ResourceArray<T>(nullptr, ResourceDeleter<T>{resource, 0});
+    }
+    std::uninitialized_value_construct_n(data, n);
+    return ResourceArray<T>(data, ResourceDeleter<T>{resource, n});
+}
+
+/**
+ * Whole-process memory usage (Linux /proc), for context in footprint reports
+ *
+ */
+struct ProcessMemory {
+    std::size_t resident = 0;        ///< VmRSS
+    std::size_t peak_resident = 0;   ///< VmHWM
+    std::size_t anon_huge_pages = 0; ///< Transparent huge pages (AnonHugePages)
+    std::size_t hugetlb = 0;         ///< Explicit huge pages (HugetlbPages)
+};
+
+/// Read process memory usage; fields stay 0 where unavailable
+inline ProcessMemory read_process_memory() noexcept {
+    ProcessMemory memory;
+    auto scan = [](const char* path, auto&& on_field) {
+        std::FILE* file = std::fopen(path, "r");
+        if (!file) {
+            return;
+        }
+        char line[256];
+        while (std::fgets(line, sizeof(line), file)) {
+            char key[64];
+            unsigned long long kb = 0;
+            if (std::sscanf(line, "%63[^:]: %llu kB", key, &kb) == 2) {
+                on_field(key, static_cast<std::size_t>(kb) * 1024);
+            }
+        }
+        std::fclose(file);
+    };
+    scan("/proc/self/status", [&](const char* key, std::size_t bytes) {
+        if (std::strcmp(key, "VmRSS") == 0) {
+            memory.resident = bytes;
+        } else if (std::strcmp(key, "VmHWM") == 0) {
+            memory.peak_resident = bytes;
+        } else if (std::strcmp(key, "HugetlbPages") == 0) {
+            memory.hugetlb = bytes;
+        }
+    });
+    scan("/proc/self/smaps_rollup", [&](const char* key, std::size_t bytes) {
+        if (std::strcmp(key, "AnonHugePages") == 0) {
+            memory.anon_huge_pages = bytes;
+        }
+    });
+    return memory;
+}
+
+namespace detail {
+
+inline void format_account(std::string& out, const MemoryAccount& account, int depth) {
+    char line[192];
+    char budget[32] = "-";
+    if (account.budget()) {
+        std::snprintf(budget, sizeof(budget), "%zu", account.budget());
+    }
+    std::snprintf(line, sizeof(line), "%*s%-*s %12zu %12zu %12zu %8llu %12s %6llu\n", depth * 2, "",
+                  std::max(1, 24 - depth * 2), account.name().c_str(), account.bytes(), account.peak(),
+                  account.resident(), static_cast<unsigned long long>(account.allocations()), budget,
+                  static_cast<unsigned long long>(account.denied()));
+    out += line;
+    for (auto* child = account.first_child(); child; child = child->next_sibling()) {
+        format_account(out, *child, depth + 1);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Footprint report of an account tree plus process totals
+ *
+ * One line per account (indented by depth): live bytes and peak including children, own
+ * resident bytes, allocation count, budget and denied allocations. Empty on allocation failure.
+ */
+inline std::string format_memory_report(const MemoryAccount& root) noexcept {
+    try {
+        std::string out;
+        char line[192];
+        std::snprintf(line, sizeof(line), "%-24s %12s %12s %12s %8s %12s %6s\n", "account", "bytes", "peak",
+                      "resident", "allocs", "budget", "denied");
+        out += line;
+        detail::format_account(out, root, 0);
+        const auto process = read_process_memory();
+        std::snprintf(line, sizeof(line), "process: rss %zu, peak rss %zu, thp %zu, hugetlb %zu\n", process.resident,
+                      process.peak_resident, process.anon_huge_pages, process.hugetlb);
+        out += line;
+        return out;
+    } catch (...) {
+        return {};
+    }
+}
+
+} // namespace dspai::comp
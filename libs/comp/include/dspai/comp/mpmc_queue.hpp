@@ -0,0 +1,192 @@
+#pragma once
+
+#include <dspai/comp/spsc_ring.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <system_error>
+#include <type_traits>
+
+namespace dspai::comp {
+
+/**
+ * Bounded multi-producer multi-consumer queue (Vyukov sequence-number design)
+ *
+ * For fan-in of events from many producer components into one or more consumers.
+ * - Lock-free. Storage is allocated once by allocate(), normally from doInitialize();
+ *   push/pop never allocate.
+ * - Every slot sits on its own cache line, so producers writing neighbouring slots do not
+ *   false-share.
+ * - push_batch()/pop_batch() claim up to N consecutive slots with one CAS, amortizing
+ *   contention on the shared enqueue/dequeue positions.
+ * - push_retries()/pop_retries() count failed enqueue/dequeue position CASes, a direct
+ *   measure of producer and consumer contention.
+ *
+ * Thread Safety: all push/pop methods are safe from any number of threads.
+ * allocate() requires external synchronization (no concurrent access).
+ */
+template <typename T>
+class MpmcQueue {
+    static_assert(std::is_trivially_copyable_v<T>, "MpmcQueue requires trivially copyable elements");
+    static_assert(std::is_default_constructible_v<T>, "MpmcQueue requires default constructible elements");
+
+public:
+    MpmcQueue() = default;
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * @brief Allocate storage for at least capacity elements
+     *
+     * - Capacity is rounded up to a power of two (minimum 2).
+     * - Discards any previous contents.
+     *
+     * @return std::error_code - invalid_argument for zero capacity, not_enough_memory on failure
+     */
+    std::error_code allocate(std::size_t capacity) noexcept {
+        if (capacity == 0 || capacity > (std::size_t{1} << 40)) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+        const std::size_t size = std::bit_ceil(std::max<std::size_t>(capacity, 2));
+        std::unique_ptr<Slot[]> slots(new (std::nothrow) Slot[size]);
+        if (!slots) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        slots_ = std::move(slots);
+        mask_ = size - 1;
+        enqueue_.value.store(0, std::memory_order_relaxed);
+        dequeue_.value.store(0, std::memory_order_relaxed);
+        push_retries_.value.store(0, std::memory_order_relaxed);
+        pop_retries_.value.store(0, std::memory_order_relaxed);
+        return {};
+    }
+
+    std::size_t capacity() const noexcept { return slots_ ? mask_ + 1 : 0; }
+
+    /// Approximate number of queued elements
+    std::size_t size() const noexcept {
+        const auto tail = dequeue_.value.load(std::memory_order_relaxed);
+        const auto head = enqueue_.value.load(std::memory_order_relaxed);
+        return head > tail ? static_cast<std::size_t>(head - tail) : 0;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    /// Push one element; returns false if the queue is full
+    bool try_push(const T& value) noexcept { return push_batch(std::span<const T>(&value, 1)) == 1; }
+
+    /// Pop one element; returns false if the queue is empty
+    bool try_pop(T& value) noexcept { return pop_batch(std::span<T>(&value, 1)) == 1; }
+
+    /**
+     * @brief Push up to values.size() elements as one contiguous claim
+     *
+     * Elements pushed by one call are dequeued in order relative to each other.
+     *
+     * @return number of elements pushed (0 if the queue is full)
+     */
+    std::size_t push_batch(std::span<const T> values) noexcept {
+        if (!slots_ || values.empty()) {
+            return 0;
+        }
+        auto pos = enqueue_.value.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::size_t n = claimable(pos, values.size(), 0);
+            if (n == 0) {
+                // Either full, or another producer moved the position: re-check
+                const auto current = enqueue_.value.load(std::memory_order_relaxed);
+                if (current == pos) {
+                    return 0;
+                }
+                pos = current;
+                continue;
+            }
+            if (enqueue_.value.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    auto& slot = slots_[(pos + i) & mask_];
+                    slot.value = values[i];
+                    slot.sequence.store(pos + i + 1, std::memory_order_release);
+                }
+                return n;
+            }
+            push_retries_.value.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Pop up to values.size() elements as one contiguous claim
+     *
+     * @return number of elements popped (0 if the queue is empty)
+     */
+    std::size_t pop_batch(std::span<T> values) noexcept {
+        if (!slots_ || values.empty()) {
+            return 0;
+        }
+        auto pos = dequeue_.value.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::size_t n = claimable(pos, values.size(), 1);
+            if (n == 0) {
+                const auto current = dequeue_.value.load(std::memory_order_relaxed);
+                if (current == pos) {
+                    return 0;
+                }
+                pos = current;
+                continue;
+            }
+            if (dequeue_.value.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    auto& slot = slots_[(pos + i) & mask_];
+                    values[i] = slot.value;
+                    slot.sequence.store(pos + i + mask_ + 1, std::memory_order_release);
+                }
+                return n;
+            }
+            pop_retries_.value.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// Number of failed enqueue position CASes since allocate()
+    std::uint64_t push_retries() const noexcept { return push_retries_.value.load(std::memory_order_relaxed); }
+
+    /// Number of failed dequeue position CASes since allocate()
+    std::uint64_t pop_retries() const noexcept { return pop_retries_.value.load(std::memory_order_relaxed); }
+
+    /// Number of failed enqueue/dequeue position CASes since allocate()
+    std::uint64_t cas_retries() const noexcept { return push_retries() + pop_retries(); }
+
+private:
+    struct alignas(cache_line_size) Slot {
+        std::atomic<std::uint64_t> sequence{0};
+        T value{};
+    };
+    struct alignas(cache_line_size) Position {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    // Number of consecutive slots from pos (at most max) whose sequence equals index + lag
+    std::size_t claimable(std::uint64_t pos, std::size_t max, std::uint64_t lag) const noexcept {
+        std::size_t n = 0;
+        const std::size_t limit = std::min(max, mask_ + 1);
+        while (n < limit && slots_[(pos + n) & mask_].sequence.load(std::memory_order_acquire) == pos + n + lag) {
+            ++n;
+        }
+        return n;
+    }
+
+    Position enqueue_;
+    Position dequeue_;
+    Position push_retries_;
+    Position pop_retries_;
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_ = 0;
+};
+
+} // namespace dspai::comp
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <dspai/comp/clock.hpp>
+#include <dspai/comp/executor.hpp>
+#include <dspai/comp/graph.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace dspai::comp {
+
+/**
+ * Partitioner configuration
+ *
+ */
+struct PartitionConfig {
+    std::size_t parts = 1;           ///< Number of worker threads to partition across
+    double traffic_cost = 0.1;       ///< Cost units (ns for profile_costs()) per byte crossing partitions
+    std::uint32_t refine_passes = 16; ///< Upper bound on local-search passes
+};
+
+/**
+ * Node-to-worker assignment computed by partition()
+ *
+ */
+struct Partition {
+    std::vector<std::size_t> owners; ///< Worker per node; pass to ThreadedExecutor::start()
+    std::vector<double> load;        ///< Sum of node costs per worker
+    double max_load = 0.0;           ///< Largest worker load
+    double cut_bytes = 0.0;          ///< Bytes per step crossing workers (NodeOptions::output_bytes)
+
+    std::size_t parts() const noexcept { return load.size(); }
+};
+
+/**
+ * @brief Measure per-step cost of every node by running the graph on the calling thread
+ *
+ * Runs up to `steps` graph steps, timing each execute_node() that runs its component (not
+ * finished, isolated, bypassed or shed steps), then reset()s the graph so it starts from a
+ * clean state. Components must be initialized. Use representative input: cost
+ * models are only as good as the warm-up that produced them.
+ *
+ * @return mean nanoseconds per executed step for each node (0 for nodes that never ran), or
+ *         - operation_not_permitted if the graph is not built
+ *         - not_enough_memory
+ */
+inline std::expected<std::vector<double>, std::error_code> profile_costs(Graph& graph, std::uint32_t steps) noexcept {
+    if (!graph.built()) {
+        return std::unexpected(std::make_error_code(std::errc::operation_not_permitted));
+    }
+    std::vector<std::uint64_t> ticks;
+    std::vector<std::uint64_t> count;
+    std::vector<double> costs;
+    try {
+        ticks.assign(graph.size(), 0);
+        count.assign(graph.size(), 0);
+        costs.assign(graph.size(), 0.0);
+    } catch (...) {
+        return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+    }
+
+    for (std::uint32_t step = 0; step < steps && !graph.stopped(); ++step) {
+        bool finished = true;
+        for (auto id : graph.order()) {
+            // Only steps that ran the component count: finished, isolated, bypassed and shed
+            // steps return almost at once and would dilute the mean
+            const bool active = graph.status(id) == NodeStatus::Active;
+            const auto shed = graph.stats(id).shed_steps;
+            const auto start = TickClock::now();
+            finished &= graph.execute_node(id);
+            const auto elapsed = TickClock::now() - start;
+            if (active && graph.stats(id).shed_steps == shed) {
+                ticks[id] += elapsed;
+                count[id]++;
+            }
+        }
+        if (finished) {
+            break;
+        }
+    }
+    graph.reset();
+
+    for (NodeId id = 0; id < graph.size(); ++id) {
+        if (count[id]) {
+            const auto ns = TickClock::to_duration(ticks[id]).count();
+            costs[id] = static_cast<double>(ns) / static_cast<double>(count[id]);
+        }
+    }
+    return costs;
+}
+
+namespace detail {
+
+// Bytes per step on each edge leaving from
+inline double edge_bytes(const Graph& graph, NodeId from) noexcept {
+    return static_cast<double>(graph.options(from).output_bytes);
+}
+
+// Bytes per step between id and its neighbours owned by part
+inline double traffic_to(const Graph& graph, const std::vector<std::vector<NodeId>>& upstream,
+                         const std::vector<std::size_t>& owners, NodeId id, std::size_t part) noexcept {
+    double bytes = 0.0;
+    for (auto to : graph.downstream(id)) {
+        bytes += owners[to] == part ? edge_bytes(graph, id) : 0.0;
+    }
+    for (auto from : upstream[id]) {
+        bytes += owners[from] == part ? edge_bytes(graph, from) : 0.0;
+    }
+    return bytes;
+}
+
+// Bytes per step on all of id's edges
+inline double node_traffic(const Graph& graph, const std::vector<std::vector<NodeId>>& upstream, NodeId id) noexcept {
+    double bytes = static_cast<double>(graph.downstream(id).size()) * edge_bytes(graph, id);
+    for (auto from : upstream[id]) {
+        bytes += edge_bytes(graph, from);
+    }
+    return bytes;
+}
+
+} // namespace detail
+
+/**
+ * @brief Partition graph nodes across worker threads
+ *
+ * Minimizes max_load + traffic_cost * cut_bytes, i.e. the slowest worker's per-step time
+ * plus the cost of moving data between workers (edge bandwidth is the producer's
+ * NodeOptions::output_bytes).
+ * - Seed: nodes in topological order, each placed where the objective grows least, so
+ *   producer/consumer chains stay together unless splitting them balances load.
+ * - Refine: single-node moves that lower the objective (ties broken by a more even load
+ *   spread), until no move helps or refine_passes is reached.
+ * Heuristic, not optimal; cost is O(passes * nodes * (parts + degree) * parts).
+ *
+ * @param costs: per-node cost, e.g. from profile_costs(); empty = unit costs
+ * @return the partition, or
+ *         - invalid_argument if parts is zero, costs has the wrong size, or the graph is not built
+ *         - not_enough_memory
+ */
+inline std::expected<Partition, std::error_code> partition(const Graph& graph, std::span<const double> costs,
+                                                           PartitionConfig config = {}) noexcept {
+    const std::size_t n = graph.size();
+    const std::size_t parts = config.parts;
+    if (parts == 0 || !graph.built() || (!costs.empty() && costs.size() != n)) {
+        return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    try {
+        auto cost = [&](NodeId id) { return costs.empty() ? 1.0 : costs[id]; };
+        std::vector<std::vector<NodeId>> upstream(n);
+        for (NodeId from = 0; from < n; ++from) {
+            for (auto to : graph.downstream(from)) {
+                upstream[to].push_back(from);
+            }
+        }
+
+        Partition result;
+        result.owners.assign(n, parts); // parts = unassigned
+        result.load.assign(parts, 0.0);
+        double cut = 0.0;
+        auto max_load = [&] { return *std::max_element(result.load.begin(), result.load.end()); };
+
+        // Seed in topological order
+        for (auto id : graph.order()) {
+            double assigned = 0.0; // Traffic to already-placed neighbours
+            for (std::size_t p = 0; p < parts; ++p) {
+                assigned += detail::traffic_to(graph, upstream, result.owners, id, p);
+            }
+            const double current = max_load();
+            std::size_t best = 0;
+            double best_score = 0.0;
+            for (std::size_t p = 0; p < parts; ++p) {
+                const double added_cut = assigned - detail::traffic_to(graph, upstream, result.owners, id, p);
+                const double score = std::max(current, result.load[p] + cost(id)) + config.traffic_cost * added_cut;
+                if (p == 0 || score < best_score || (score == best_score && result.load[p] < result.load[best])) {
+                    best = p;
+                    best_score = score;
+                }
+            }
+            cut += assigned - detail::traffic_to(graph, upstream, result.owners, id, best);
+            result.owners[id] = best;
+            result.load[best] += cost(id);
+        }
+
+        // Refine with single-node moves
+        for (std::uint32_t pass = 0; pass < config.refine_passes; ++pass) {
+            bool improved = false;
+            for (auto id : graph.order()) {
+                const auto from = result.owners[id];
+                const double total = detail::node_traffic(graph, upstream, id);
+                const double local = detail::traffic_to(graph, upstream, result.owners, id, from);
+                const double objective = max_load() + config.traffic_cost * cut;
+
+                for (std::size_t to = 0; to < parts; ++to) {
+                    if (to == from) {
+                        continue;
+                    }
+                    const double remote = detail::traffic_to(graph, upstream, result.owners, id, to);
+                    const double new_cut = cut - (total - local) + (total - remote);
+                    result.load[from] -= cost(id);
+                    result.load[to] += cost(id);
+                    const double new_objective = max_load() + config.traffic_cost * new_cut;
+                    // Equal objective: accept if it narrows the gap between the two loads
+                    const double spread_before = std::abs((result.load[from] + cost(id)) - (result.load[to] - cost(id)));
+                    const double spread_after = std::abs(result.load[from] - result.load[to]);
+                    if (new_objective < objective ||
+                        (new_objective == objective && spread_after < spread_before)) {
+                        result.owners[id] = to;
+                        cut = new_cut;
+                        improved = true;
+                        break;
+                    }
+                    result.load[from] += cost(id);
+                    result.load[to] -= cost(id);
+                }
+            }
+            if (!improved) {
+                break;
+            }
+        }
+
+        result.max_load = max_load();
+        result.cut_bytes = cut;
+        return result;
+    } catch (...) {
+        return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+    }
+}
+
+/**
+ * @brief Run a partition on an executor
+ *
+ * Starts the executor with the partition's owners if it is stopped; if it is running,
+ * migrates every node at its next step boundary (see ThreadedExecutor::migrate()).
+ *
+ * @param cpus: CPU per worker for pinning when starting (see PlacementPlan); empty = unpinned
+ * @return std::error_code - empty on success, or the error from start()/migrate();
+ *         invalid_argument if a running executor has a different worker count
+ */
+inline std::error_code apply_partition(ThreadedExecutor& executor, const Partition& partition,
+                                       std::span<const unsigned> cpus = {}) noexcept {
+    if (!executor.running()) {
+        return executor.start(partition.parts(), partition.owners, cpus);
+    }
+    if (executor.workers() != partition.parts() || partition.owners.size() != executor.graph().size()) {
+        return std::make_error_code(std::errc::invalid_argument);
+    }
+    for (NodeId id = 0; id < partition.owners.size(); ++id) {
+        if (auto ec = executor.migrate(id, partition.owners[id])) {
+            return ec;
+        }
+    }
+    return {};
+}
+
+} // namespace dspai::comp
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <dspai/comp/execution.hpp>
+#include <dspai/comp/graph.hpp>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define DSPAI_COMP_HAS_PERF_TRAMPOLINES 1
+#endif
+
+namespace dspai::comp {
+
+namespace detail {
+
+// Common target of every trampoline
+inline bool execute_component(IExecution* component) noexcept { return component->execute(); }
+
+#if defined(DSPAI_COMP_HAS_PERF_TRAMPOLINES)
+inline constexpr std::size_t trampoline_stride = 32;
+
+// Frame-building stub that calls the 8-byte absolute address stored at offset 16 (x86-64)
+// or 24 (AArch64), so it shows up as its own frame in frame-pointer call graphs
+inline void write_trampoline(unsigned char* code, ExecuteHook target) noexcept {
+    std::memset(code, 0, trampoline_stride);
+    const auto address = reinterpret_cast<std::uintptr_t>(target);
+#if defined(__x86_64__)
+    static constexpr unsigned char stub[] = {
+        0x55,                               // push rbp
+        0x48, 0x89, 0xe5,                   // mov rbp, rsp
+        0xff, 0x15, 0x06, 0x00, 0x00, 0x00, // call [rip + 6]
+        0x5d,                               // pop rbp
+        0xc3,                               // ret
+        0xcc, 0xcc, 0xcc, 0xcc,             // int3 padding
+    };
+    std::memcpy(code, stub, sizeof(stub));
+    std::memcpy(code + 16, &address, sizeof(address));
+#else
+    static constexpr std::uint32_t stub[] = {
+        0xa9bf7bfd, // stp x29, x30, [sp, #-16]!
+        0x910003fd, // mov x29, sp
+        0x58000090, // ldr x16, #16
+        0xd63f0200, // blr x16
+        0xa8c17bfd, // ldp x29, x30, [sp], #16
+        0xd65f03c0, // ret
+    };
+    std::memcpy(code, stub, sizeof(stub));
+    std::memcpy(code + 24, &address, sizeof(address));
+#endif
+}
+#endif
+
+} // namespace detail
+
+/**
+ * Named per-instance entry points so profilers attribute samples to component instances
+ *
+ * Without help, perf shows every component as Component::execute() -> doExecute(). PerfMap
+ * generates one tiny trampoline per node (JIT-style, as language runtimes do) that builds a
+ * stack frame and calls IExecution::execute(), and registers it in /tmp/perf-<pid>.map under
+ * the node's name. With frame-pointer call graphs (`perf record -g` / `--call-graph fp`),
+ * each component's samples then sit under a frame such as `dspai::fir0` in reports and
+ * flamegraphs.
+ * - Overhead: one extra predictable indirect call and frame per step.
+ * - annotate() installs the trampolines as Graph execute hooks; uninstall() removes them.
+ * - x86-64 and AArch64 Linux only (DSPAI_COMP_HAS_PERF_TRAMPOLINES); elsewhere annotate()
+ *   returns operation_not_supported and the graph is untouched.
+ * - Building with DSPAI_COMP_USDT and <sys/sdt.h> available additionally emits
+ *   dspai:execute_begin / dspai:execute_end USDT probes from Graph::execute_node().
+ *
+ * Trampolines live until the PerfMap is destroyed: uninstall() or stop executing the graph
+ * first. The map file is left in place for `perf report`.
+ *
+ * Thread Safety: NOT thread-safe; annotate while the graph is not executing.
+ */
+class PerfMap {
+public:
+    PerfMap() noexcept = default;
+    PerfMap(const PerfMap&) = delete;
+    PerfMap& operator=(const PerfMap&) = delete;
+    ~PerfMap() noexcept {
+#if defined(DSPAI_COMP_HAS_PERF_TRAMPOLINES)
+        for (auto [memory, bytes] : regions_) {
+            ::munmap(memory, bytes);
+        }
+#endif
+    }
+
+    static constexpr bool supported() noexcept {
+#if defined(DSPAI_COMP_HAS_PERF_TRAMPOLINES)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /// Map file perf reads for this process
+    static std::string path() {
+#if defined(DSPAI_COMP_HAS_PERF_TRAMPOLINES)
+        return "/tmp/perf-" + std::to_string(::getpid()) + ".map";
+#else
+        return {};
+#endif
+    }
+
+    /**
+     * @brief Create one named trampoline per name
+     *
+     * @return entry points in the order of names, or
+     *         - operation_not_supported on unsupported platforms
+     *         - the errno of mmap/mprotect or of writing the map file
+     *         - not_enough_memory
+     */
+    std::expected<std::vector<ExecuteHook>, std::error_code> make_trampolines(std::span<const std::string> names) noexcept {
+#if defined(DSPAI_COMP_HAS_PERF_TRAMPOLINES)
+        if (names.empty()) {
+            return std::vector<ExecuteHook>{};
+        }
+        const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const auto bytes = (names.size() * detail::trampoline_stride + page - 1) / page * page;
+        try {
+            regions_.reserve(regions_.size() + 1);
+            std::vector<ExecuteHook> hooks;
+            hooks.reserve(names.size());
+            std::string lines;
+
+            void* memory = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED) {
+                return std::unexpected(std::error_code(errno, std::generic_category()));
+            }
+            regions_.emplace_back(memory, bytes);
+
+            auto* code = static_cast<unsigned char*>(memory);
+            char address[48];
+            for (std::size_t i = 0; i < names.size(); ++i) {
+                auto* entry = code + i * detail::trampoline_stride;
+                detail::write_trampoline(entry, &detail::execute_component);
+                hooks.push_back(reinterpret_cast<ExecuteHook>(entry));
+                std::snprintf(address, sizeof(address), "%llx %zx ",
+                              static_cast<unsigned long long>(reinterpret_cast<std::uintptr_t>(entry)),
+                              detail::trampoline_stride);
+                lines += address;
+                lines += names[i];
+                lines += '\n';
+            }
+            if (::mprotect(memory, bytes, PROT_READ | PROT_EXEC) != 0) {
+                return std::unexpected(std::error_code(errno, std::generic_category()));
+            }
+            __builtin___clear_cache(static_cast<char*>(memory), static_cast<char*>(memory) + bytes);
+
+            if (auto ec = append_map(lines)) {
+                return std::unexpected(ec);
+            }
+            count_ += names.size();
+            return hooks;
+        } catch (...) {
+            return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+        }
+#else
+        (void)names;
+        return std::unexpected(std::make_error_code(std::errc::operation_not_supported));
+#endif
+    }
+
+    /**
+     * @brief Give every node of graph a named trampoline
+     *
+     * Symbols are prefix + NodeOptions::name, or prefix + "node<id>" for unnamed nodes.
+     *
+     * @return std::error_code - empty on success, or the error of make_trampolines()
+     */
+    std::error_code annotate(Graph& graph, std::string_view prefix = "dspai::") noexcept {
+        std::vector<std::string> names;
+        try {
+            names.reserve(graph.size());
+            for (NodeId id = 0; id < graph.size(); ++id) {
+                const auto& name = graph.options(id).name;
+                names.push_back(std::string(prefix) + (name.empty() ? "node" + std::to_string(id) : name));
+            }
+        } catch (...) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        auto hooks = make_trampolines(names);
+        if (!hooks) {
+            return hooks.error();
+        }
+        for (NodeId id = 0; id < graph.size(); ++id) {
+            graph.set_execute_hook(id, (*hooks)[id]);
+        }
+        return {};
+    }
+
+    /// Restore direct execute() calls on every node of graph
+    static void uninstall(Graph& graph) noexcept {
+        for (NodeId id = 0; id < graph.size(); ++id) {
+            graph.set_execute_hook(id, nullptr);
+        }
+    }
+
+    /// Trampolines created
+    std::size_t size() const noexcept { return count_; }
+
+private:
+#if defined(DSPAI_COMP_HAS_PERF_TRAMPOLINES)
+    static std::error_code append_map(const std::string& lines) noexcept {
+        std::string file;
+        try {
+            file = path();
+        } catch (...) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        const int fd = ::open(file.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0) {
+            return {errno, std::generic_category()};
+        }
+        // One write keeps the lines of this batch together (O_APPEND)
+        const auto written = ::write(fd, lines.data(), lines.size());
+        const int error = errno;
+        ::close(fd);
+        if (written != static_cast<ssize_t>(lines.size())) {
+            return written < 0 ? std::error_code(error, std::generic_category())
+                               : std::make_error_code(std::errc::io_error);
+        }
+        return {};
+    }
+#endif
+
+    std::vector<std::pair<void*, std::size_t>> regions_;
+    std::size_t count_ = 0;
+};
+
+} // namespace dspai::comp
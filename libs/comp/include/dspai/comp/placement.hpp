@@ -0,0 +1,348 @@
+#pragma once
+
+#include <dspai/comp/executor.hpp>
+#include <dspai/comp/graph.hpp>
+#include <dspai/comp/topology.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <expected>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace dspai::comp {
+
+/**
+ * Placement constraints
+ *
+ */
+struct PlacementOptions {
+    std::size_t max_workers = 0; ///< Upper bound on worker threads; 0 = one per usable CPU
+    bool use_smt = false;        ///< Also place workers on SMT siblings of used cores
+};
+
+/**
+ * Result of place(): which worker runs each node and which CPU each worker is pinned to
+ *
+ * owners and cpus plug straight into ThreadedExecutor::start().
+ */
+struct PlacementPlan {
+    std::vector<std::size_t> owners; ///< Worker per node
+    std::vector<unsigned> cpus;      ///< CPU per worker
+    std::vector<unsigned> worker_l3; ///< L3 domain per worker
+    std::vector<double> worker_load; ///< Sum of node costs per worker
+    std::size_t cross_l3_edges = 0;     ///< Edges whose endpoints sit in different L3 domains
+    std::size_t cross_worker_edges = 0; ///< Edges whose endpoints run on different workers
+
+    std::size_t workers() const noexcept { return cpus.size(); }
+};
+
+/**
+ * @brief Measured cost per step of every node (TickClock ticks) from a running or finished executor
+ *
+ * Nodes that have not run yet get cost 0. Empty on allocation failure.
+ */
+inline std::vector<double> measured_costs(const ThreadedExecutor& executor) noexcept {
+    std::vector<double> costs;
+    try {
+        costs.resize(executor.graph().size());
+    } catch (...) {
+        return {};
+    }
+    for (NodeId id = 0; id < costs.size(); ++id) {
+        const auto steps = executor.steps(id);
+        costs[id] = steps ? static_cast<double>(executor.node_ticks(id)) / static_cast<double>(steps) : 0.0;
+    }
+    return costs;
+}
+
+namespace detail {
+
+inline std::size_t find_root(std::vector<std::size_t>& parent, std::size_t x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+// Edge counts of an assignment; fills cross_l3_edges / cross_worker_edges
+inline void count_cut_edges(const Graph& graph, PlacementPlan& plan) {
+    plan.cross_l3_edges = 0;
+    plan.cross_worker_edges = 0;
+    for (NodeId from = 0; from < graph.size(); ++from) {
+        for (auto to : graph.downstream(from)) {
+            const auto a = plan.owners[from];
+            const auto b = plan.owners[to];
+            plan.cross_worker_edges += a != b;
+            plan.cross_l3_edges += plan.worker_l3[a] != plan.worker_l3[b];
+        }
+    }
+}
+
+// Split connected group in two at the edge whose removal disconnects it with the least traffic
+// (NodeOptions::output_bytes of the producer), ties broken by the more even cost split.
+// Returns false if no single edge disconnects the group.
+template <typename Cost>
+bool split_group(const Graph& graph, const std::vector<NodeId>& group, Cost&& cost, std::vector<NodeId>& first,
+                 std::vector<NodeId>& second) {
+    std::vector<std::size_t> parent(graph.size());
+    std::vector<char> member(graph.size(), 0);
+    double total = 0.0;
+    for (auto id : group) {
+        member[id] = 1;
+        total += cost(id);
+    }
+    // Components of the group without edge cut_from -> cut_to
+    auto components = [&](NodeId cut_from, NodeId cut_to) {
+        for (auto id : group) {
+            parent[id] = id;
+        }
+        for (auto from : group) {
+            for (auto to : graph.downstream(from)) {
+                if (member[to] && !(from == cut_from && to == cut_to)) {
+                    parent[find_root(parent, from)] = find_root(parent, to);
+                }
+            }
+        }
+    };
+
+    bool found = false;
+    NodeId best_from = 0;
+    NodeId best_to = 0;
+    std::size_t best_bytes = 0;
+    double best_imbalance = 0.0;
+    for (auto from : group) {
+        for (auto to : graph.downstream(from)) {
+            if (!member[to]) {
+                continue;
+            }
+            components(from, to);
+            const auto side = find_root(parent, from);
+            if (side == find_root(parent, to)) {
+                continue; // Still connected
+            }
+            double part = 0.0;
+            for (auto id : group) {
+                part += find_root(parent, id) == side ? cost(id) : 0.0;
+            }
+            const auto bytes = graph.options(from).output_bytes;
+            const double imbalance = std::abs(total - 2.0 * part);
+            if (!found || bytes < best_bytes || (bytes == best_bytes && imbalance < best_imbalance)) {
+                found = true;
+                best_from = from;
+                best_to = to;
+                best_bytes = bytes;
+                best_imbalance = imbalance;
+            }
+        }
+    }
+    if (!found) {
+        return false;
+    }
+    components(best_from, best_to);
+    const auto side = find_root(parent, best_from);
+    first.clear();
+    second.clear();
+    for (auto id : group) {
+        (find_root(parent, id) == side ? first : second).push_back(id);
+    }
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Assign graph nodes to cores, keeping connected stages within one L3 domain
+ *
+ * - Workers: one per physical core (first hardware thread only unless use_smt), filling one
+ *   L3 domain before the next, capped by max_workers.
+ * - Connected subgraphs (producer/consumer chains) are kept whole where possible. With more
+ *   than one L3 domain, a subgraph costing more than the largest domain's fair share of the
+ *   total is cut at its lowest-traffic edge (NodeOptions::output_bytes; ties go to the most
+ *   even split), repeatedly, so a single pipeline still uses every domain.
+ * - Subgraphs are assigned to L3 domains by longest-processing-time first, weighted by each
+ *   domain's worker count, so edges only cross cache domains where a subgraph was cut.
+ * - Within a domain, nodes are spread over its workers by longest-processing-time first.
+ *
+ * @param costs: per-node cost (any unit, e.g. measured_costs()); empty = unit costs
+ * @return the plan, or
+ *         - invalid_argument if costs has the wrong size, the graph is empty, or no CPU is usable
+ *         - not_enough_memory
+ */
+inline std::expected<PlacementPlan, std::error_code> place(const Graph& graph, const CpuTopology& topology,
+                                                           std::span<const double> costs = {},
+                                                           PlacementOptions options = {}) noexcept {
+    const std::size_t n = graph.size();
+    if (n == 0 || (!costs.empty() && costs.size() != n)) {
+        return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    try {
+        auto cost = [&](NodeId id) { return costs.empty() ? 1.0 : costs[id]; };
+
+        // Usable CPUs grouped by L3 domain
+        std::vector<LogicalCpu> usable;
+        for (const auto& cpu : topology.cpus) {
+            if (options.use_smt || cpu.smt == 0) {
+                usable.push_back(cpu);
+            }
+        }
+        std::stable_sort(usable.begin(), usable.end(), [](const LogicalCpu& a, const LogicalCpu& b) {
+            return a.l3 != b.l3 ? a.l3 < b.l3 : (a.smt != b.smt ? a.smt < b.smt : a.core < b.core);
+        });
+        if (options.max_workers && usable.size() > options.max_workers) {
+            usable.resize(options.max_workers);
+        }
+        if (usable.empty()) {
+            return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+        }
+
+        PlacementPlan plan;
+        plan.owners.assign(n, 0);
+        plan.worker_load.assign(usable.size(), 0.0);
+        std::vector<unsigned> domains; // Distinct L3 domains in use
+        std::vector<std::vector<std::size_t>> domain_workers;
+        for (std::size_t w = 0; w < usable.size(); ++w) {
+            plan.cpus.push_back(usable[w].id);
+            plan.worker_l3.push_back(usable[w].l3);
+            if (domains.empty() || domains.back() != usable[w].l3) {
+                domains.push_back(usable[w].l3);
+                domain_workers.emplace_back();
+            }
+            domain_workers.back().push_back(w);
+        }
+
+        // Weakly connected subgraphs
+        std::vector<std::size_t> parent(n);
+        std::iota(parent.begin(), parent.end(), std::size_t{0});
+        for (NodeId from = 0; from < n; ++from) {
+            for (auto to : graph.downstream(from)) {
+                parent[detail::find_root(parent, from)] = detail::find_root(parent, to);
+            }
+        }
+        std::vector<std::vector<NodeId>> groups;
+        std::vector<std::size_t> group_of_root(n, n);
+        for (NodeId id = 0; id < n; ++id) {
+            const auto root = detail::find_root(parent, id);
+            if (group_of_root[root] == n) {
+                group_of_root[root] = groups.size();
+                groups.emplace_back();
+            }
+            groups[group_of_root[root]].push_back(id);
+        }
+        auto group_sum = [&](const std::vector<NodeId>& group) {
+            double sum = 0.0;
+            for (auto id : group) {
+                sum += cost(id);
+            }
+            return sum;
+        };
+        std::vector<double> group_cost;
+        double total_cost = 0.0;
+        for (const auto& group : groups) {
+            group_cost.push_back(group_sum(group));
+            total_cost += group_cost.back();
+        }
+
+        // Cut subgraphs too large for any one domain
+        if (domains.size() > 1) {
+            std::size_t largest = 0;
+            for (const auto& workers : domain_workers) {
+                largest = std::max(largest, workers.size());
+            }
+            const double share = total_cost * static_cast<double>(largest) / static_cast<double>(usable.size());
+            std::vector<NodeId> first;
+            std::vector<NodeId> second;
+            for (std::size_t g = 0; g < groups.size();) {
+                if (group_cost[g] > share && detail::split_group(graph, groups[g], cost, first, second)) {
+                    groups[g] = std::move(first);
+                    group_cost[g] = group_sum(groups[g]);
+                    groups.push_back(std::move(second));
+                    group_cost.push_back(group_sum(groups.back()));
+                    continue; // Re-check the remaining part
+                }
+                ++g;
+            }
+        }
+
+        // Subgraphs -> L3 domains (LPT on per-worker load)
+        std::vector<std::size_t> group_order(groups.size());
+        std::iota(group_order.begin(), group_order.end(), std::size_t{0});
+        std::stable_sort(group_order.begin(), group_order.end(),
+                         [&](std::size_t a, std::size_t b) { return group_cost[a] > group_cost[b]; });
+        std::vector<double> domain_load(domains.size(), 0.0);
+        std::vector<std::vector<NodeId>> domain_nodes(domains.size());
+        for (auto g : group_order) {
+            std::size_t best = 0;
+            double best_load = 0.0;
+            for (std::size_t d = 0; d < domains.size(); ++d) {
+                const double load = (domain_load[d] + group_cost[g]) / static_cast<double>(domain_workers[d].size());
+                if (d == 0 || load < best_load) {
+                    best = d;
+                    best_load = load;
+                }
+            }
+            domain_load[best] += group_cost[g];
+            domain_nodes[best].insert(domain_nodes[best].end(), groups[g].begin(), groups[g].end());
+        }
+
+        // Nodes -> workers within each domain (LPT)
+        for (std::size_t d = 0; d < domains.size(); ++d) {
+            auto& nodes = domain_nodes[d];
+            std::stable_sort(nodes.begin(), nodes.end(), [&](NodeId a, NodeId b) { return cost(a) > cost(b); });
+            for (auto id : nodes) {
+                std::size_t best = domain_workers[d].front();
+                for (auto w : domain_workers[d]) {
+                    if (plan.worker_load[w] < plan.worker_load[best]) {
+                        best = w;
+                    }
+                }
+                plan.owners[id] = best;
+                plan.worker_load[best] += cost(id);
+            }
+        }
+
+        detail::count_cut_edges(graph, plan);
+        return plan;
+    } catch (...) {
+        return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+    }
+}
+
+/**
+ * @brief Human-readable placement plan for review
+ *
+ * One line per worker (CPU, L3 domain, load, nodes by name or id), then the cut-edge counts.
+ * Empty on allocation failure.
+ */
+inline std::string format_plan(const PlacementPlan& plan, const Graph& graph) noexcept {
+    try {
+        std::string out;
+        char buffer[96];
+        for (std::size_t w = 0; w < plan.workers(); ++w) {
+            std::snprintf(buffer, sizeof(buffer), "worker %zu: cpu %u l3 %u load %.3g:", w, plan.cpus[w],
+                          plan.worker_l3[w], plan.worker_load[w]);
+            out += buffer;
+            for (NodeId id = 0; id < plan.owners.size(); ++id) {
+                if (plan.owners[id] != w) {
+                    continue;
+                }
+                const auto& name = graph.options(id).name;
+                out += ' ';
+                out += name.empty() ? "#" + std::to_string(id) : name;
+            }
+            out += '\n';
+        }
+        std::snprintf(buffer, sizeof(buffer), "cross-l3 edges: %zu, cross-worker edges: %zu\n", plan.cross_l3_edges,
+                      plan.cross_worker_edges);
+        out += buffer;
+        return out;
+    } catch (...) {
+        return {};
+    }
+}
+
+} // namespace dspai::comp
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace dspai::comp {
+
+/// Stride used to touch memory; the smallest page size on supported targets
+inline constexpr std::size_t prefault_stride = 4096;
+
+/**
+ * @brief Fault in every page of a buffer without changing its contents
+ *
+ * Reads and writes back one byte per page so both the mapping and the copy-on-write fault
+ * happen now instead of on the first real execute().
+ * - Buffer must not be accessed concurrently.
+ */
+inline void prefault(void* data, std::size_t bytes) noexcept {
+    if (data == nullptr || bytes == 0) {
+        return;
+    }
+    auto* p = static_cast<volatile unsigned char*>(data);
+    for (std::size_t i = 0; i < bytes; i += prefault_stride) {
+        p[i] = p[i];
+    }
+    p[bytes - 1] = p[bytes - 1];
+}
+
+template <typename T>
+    requires(!std::is_const_v<T>)
+void prefault(std::span<T> data) noexcept {
+    prefault(static_cast<void*>(data.data()), data.size_bytes());
+}
+
+} // namespace dspai::comp
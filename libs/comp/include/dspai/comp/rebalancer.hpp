@@ -0,0 +1,223 @@
+#pragma once
+
+#include <dspai/comp/clock.hpp>
+#include <dspai/comp/executor.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace dspai::comp {
+
+/**
+ * Rebalancer configuration
+ *
+ */
+struct RebalanceConfig {
+    double imbalance = 0.25;      ///< Busiest minus idlest worker utilization (0..1) that triggers a move
+    std::uint32_t sustain = 3;    ///< Consecutive imbalanced update() calls before moving a node
+    std::uint32_t cooldown = 3;   ///< update() calls after a move before the next can happen
+};
+
+/**
+ * A node moved by the rebalancer
+ *
+ */
+struct Migration {
+    NodeId node = 0;
+    std::size_t from = 0;  ///< Busiest worker
+    std::size_t to = 0;    ///< Idlest worker
+    double gap = 0.0;      ///< Utilization gap that triggered the move
+    double load = 0.0;     ///< Utilization the node contributed on its old worker
+};
+
+/**
+ * Moves nodes between ThreadedExecutor workers as their load shifts
+ *
+ * update(), called periodically from a control thread, measures each worker's utilization
+ * (busy ticks / elapsed ticks) and each node's share since the previous update. When the gap
+ * between the busiest and idlest worker exceeds `imbalance` for `sustain` consecutive
+ * updates, the node on the busiest worker whose load best halves the gap is migrated to the
+ * idlest worker. A move is made only if it narrows the gap by at least imbalance / 2, so a
+ * single dominant node is never bounced between workers; after a move, `cooldown` updates pass before the next so
+ * the new utilization can be measured (hysteresis against thrashing).
+ * - Migration goes through ThreadedExecutor::migrate(), which hands the node over at a step
+ *   boundary, so a component never runs on two threads at once.
+ * - Moves are counted in migrations() and reported through the optional callback.
+ * - update(now, worker_busy_ticks, node_ticks) takes the counters from the caller instead of
+ *   the executor and TickClock (replayed traces, deterministic tests).
+ *
+ * Thread Safety: update() from one control thread; not concurrently with Watchdog::check().
+ */
+class Rebalancer {
+public:
+    using Callback = std::function<void(const Migration&)>;
+
+    Rebalancer(ThreadedExecutor& executor, RebalanceConfig config = {}, Callback on_migrate = {}) noexcept
+        : executor_(&executor), config_(config), on_migrate_(std::move(on_migrate)) {}
+
+    /**
+     * @brief Sample utilization and migrate at most one node
+     *
+     * The first call (and the first after the executor's worker count changes) only records
+     * a baseline.
+     *
+     * @return true if a node was migrated
+     */
+    bool update() noexcept {
+        if (!executor_->running()) {
+            return false;
+        }
+        try {
+            busy_.resize(executor_->workers());
+            ticks_.resize(executor_->graph().size());
+        } catch (...) {
+            return false;
+        }
+        for (std::size_t w = 0; w < busy_.size(); ++w) {
+            busy_[w] = executor_->worker_busy_ticks(w);
+        }
+        for (NodeId id = 0; id < ticks_.size(); ++id) {
+            ticks_[id] = executor_->node_ticks(id);
+        }
+        return update(TickClock::now(), busy_, ticks_);
+    }
+
+    /**
+     * @brief Same as update(), with the time and the monotonic busy-tick counters supplied
+     *
+     * @param now: current time in the counters' tick unit
+     * @param worker_busy_ticks: ticks each worker spent in steps (one per worker)
+     * @param node_ticks: ticks spent executing each node (one per graph node)
+     * @return true if a node was migrated; false also if the spans have the wrong sizes
+     */
+    bool update(std::uint64_t now, std::span<const std::uint64_t> worker_busy_ticks,
+                std::span<const std::uint64_t> node_ticks) noexcept {
+        if (!executor_->running()) {
+            return false;
+        }
+        const auto nodes = executor_->graph().size();
+        const auto workers = executor_->workers();
+        if (worker_busy_ticks.size() != workers || node_ticks.size() != nodes) {
+            return false;
+        }
+        if (worker_ticks_.size() != workers || node_ticks_.size() != nodes) {
+            try {
+                worker_ticks_.assign(workers, 0);
+                utilization_.assign(workers, 0.0);
+                node_ticks_.assign(nodes, 0);
+                node_load_.assign(nodes, 0.0);
+            } catch (...) {
+                worker_ticks_.clear();
+                return false;
+            }
+            sample(now, worker_busy_ticks, node_ticks);
+            imbalanced_updates_ = 0;
+            cooldown_ = 0;
+            return false;
+        }
+        if (now <= last_) {
+            return false;
+        }
+        const double elapsed = static_cast<double>(now - last_);
+        sample(now, worker_busy_ticks, node_ticks, elapsed);
+
+        std::size_t busiest = 0;
+        std::size_t idlest = 0;
+        for (std::size_t w = 1; w < workers; ++w) {
+            busiest = utilization_[w] > utilization_[busiest] ? w : busiest;
+            idlest = utilization_[w] < utilization_[idlest] ? w : idlest;
+        }
+        const double gap = utilization_[busiest] - utilization_[idlest];
+
+        if (cooldown_ > 0) {
+            cooldown_--;
+            return false;
+        }
+        imbalanced_updates_ = gap > config_.imbalance ? imbalanced_updates_ + 1 : 0;
+        if (imbalanced_updates_ < config_.sustain) {
+            return false;
+        }
+
+        // Node whose move leaves the smallest gap, |gap - 2 * load|, if that narrows it by at
+        // least half the threshold (measurement noise must not justify a move)
+        NodeId best = nodes;
+        double best_gap = gap - config_.imbalance / 2.0;
+        for (NodeId id = 0; id < nodes; ++id) {
+            if (executor_->owner(id) != busiest || executor_->node_finished(id)) {
+                continue;
+            }
+            const double remaining = std::abs(gap - 2.0 * node_load_[id]);
+            if (remaining < best_gap) {
+                best = id;
+                best_gap = remaining;
+            }
+        }
+        imbalanced_updates_ = 0;
+        if (best == nodes || executor_->migrate(best, idlest)) {
+            return false;
+        }
+
+        migrations_++;
+        cooldown_ = config_.cooldown;
+        if (on_migrate_) {
+            Migration migration;
+            migration.node = best;
+            migration.from = busiest;
+            migration.to = idlest;
+            migration.gap = gap;
+            migration.load = node_load_[best];
+            on_migrate_(migration);
+        }
+        return true;
+    }
+
+    /// Utilization (0..1) of a worker over the last update interval
+    double utilization(std::size_t worker) const noexcept {
+        return worker < utilization_.size() ? utilization_[worker] : 0.0;
+    }
+
+    /// Nodes moved by this rebalancer
+    std::uint64_t migrations() const noexcept { return migrations_; }
+
+private:
+    // Counters restart from zero when the executor is restarted
+    static std::uint64_t delta(std::uint64_t now, std::uint64_t before) noexcept {
+        return now >= before ? now - before : now;
+    }
+
+    // Record counters at `now`; with elapsed > 0 also compute utilization since the last sample
+    void sample(std::uint64_t now, std::span<const std::uint64_t> worker_busy_ticks,
+                std::span<const std::uint64_t> node_ticks, double elapsed = 0.0) noexcept {
+        for (std::size_t w = 0; w < worker_ticks_.size(); ++w) {
+            const auto ticks = worker_busy_ticks[w];
+            utilization_[w] = elapsed > 0.0 ? static_cast<double>(delta(ticks, worker_ticks_[w])) / elapsed : 0.0;
+            worker_ticks_[w] = ticks;
+        }
+        for (NodeId id = 0; id < node_ticks_.size(); ++id) {
+            const auto ticks = node_ticks[id];
+            node_load_[id] = elapsed > 0.0 ? static_cast<double>(delta(ticks, node_ticks_[id])) / elapsed : 0.0;
+            node_ticks_[id] = ticks;
+        }
+        last_ = now;
+    }
+
+    ThreadedExecutor* executor_;
+    RebalanceConfig config_;
+    Callback on_migrate_;
+    std::vector<std::uint64_t> worker_ticks_;
+    std::vector<double> utilization_;
+    std::vector<std::uint64_t> node_ticks_;
+    std::vector<double> node_load_;
+    std::vector<std::uint64_t> busy_;  // Scratch for update()
+    std::vector<std::uint64_t> ticks_; // Scratch for update()
+    std::uint64_t last_ = 0;
+    std::uint32_t imbalanced_updates_ = 0;
+    std::uint32_t cooldown_ = 0;
+    std::uint64_t migrations_ = 0;
+};
+
+} // namespace dspai::comp
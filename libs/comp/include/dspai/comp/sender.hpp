@@ -0,0 +1,317 @@
+#pragma once
+
+#include <dspai/comp/execution.hpp>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#if __has_include(<version>)
+#include <version>
+#endif
+#if defined(__cpp_lib_senders)
+#include <execution>
+#endif
+
+/**
+ * Sender/receiver (P2300) adapters for the component lifecycle
+ *
+ * Exposes initialize(), repeated execute() until Done, reset() and terminate() as senders
+ * that compose with any P2300 scheduler (thread pool, event loop, inline), so graphs can be
+ * driven from an async runtime without dedicated threads or blocking waits.
+ *
+ * The adapters use the member-function customization form of P2300R10 (connect(), start(),
+ * set_value()/set_error()/set_stopped() on rvalue receivers, schedule() on schedulers).
+ * When the standard library provides std::execution the standard tag types are used;
+ * otherwise equivalent local tags are defined so the adapters work stand-alone.
+ *
+ * Thread Safety: a component must only be driven by one operation at a time.
+ */
+namespace dspai::comp::exec {
+
+#if defined(__cpp_lib_senders)
+using std::execution::completion_signatures;
+using std::execution::operation_state_t;
+using std::execution::receiver_t;
+using std::execution::scheduler_t;
+using std::execution::sender_t;
+using std::execution::set_error_t;
+using std::execution::set_stopped_t;
+using std::execution::set_value_t;
+#else
+struct sender_t {};
+struct receiver_t {};
+struct scheduler_t {};
+struct operation_state_t {};
+struct set_value_t {};
+struct set_error_t {};
+struct set_stopped_t {};
+template <typename... Signatures>
+struct completion_signatures {};
+#endif
+
+/**
+ * Scheduler that runs work immediately on the thread that starts it
+ */
+class InlineScheduler {
+public:
+    using scheduler_concept = scheduler_t;
+
+    class Sender {
+    public:
+        using sender_concept = sender_t;
+        using completion_signatures = exec::completion_signatures<set_value_t()>;
+
+        template <typename Receiver>
+        struct Operation {
+            using operation_state_concept = operation_state_t;
+            Receiver receiver;
+            void start() & noexcept { std::move(receiver).set_value(); }
+        };
+
+        template <typename Receiver>
+        Operation<std::remove_cvref_t<Receiver>> connect(Receiver&& receiver) const {
+            return {std::forward<Receiver>(receiver)};
+        }
+    };
+
+    Sender schedule() const noexcept { return {}; }
+    bool operator==(const InlineScheduler&) const noexcept = default;
+};
+
+/**
+ * Lifecycle step performed by a LifecycleSender
+ */
+enum class LifecycleOp { Initialize, Reset, Terminate };
+
+/**
+ * Sender performing one lifecycle step inline on the context that starts it
+ *
+ * Completes with set_value() on success or set_error(std::error_code) if initialize() fails.
+ * Combine with starts_on()/continues_on() to choose the execution context.
+ */
+template <LifecycleOp Op>
+class LifecycleSender {
+public:
+    using sender_concept = sender_t;
+    using completion_signatures = exec::completion_signatures<set_value_t(), set_error_t(std::error_code)>;
+
+    explicit LifecycleSender(IExecution& component) noexcept : component_(&component) {}
+
+    template <typename Receiver>
+    struct Operation {
+        using operation_state_concept = operation_state_t;
+        IExecution* component;
+        Receiver receiver;
+
+        void start() & noexcept {
+            if constexpr (Op == LifecycleOp::Initialize) {
+                if (auto ec = component->initialize()) {
+                    std::move(receiver).set_error(ec);
+                    return;
+                }
+            } else if constexpr (Op == LifecycleOp::Reset) {
+                component->reset();
+            } else {
+                component->terminate();
+            }
+            std::move(receiver).set_value();
+        }
+    };
+
+    template <typename Receiver>
+    Operation<std::remove_cvref_t<Receiver>> connect(Receiver&& receiver) const {
+        return {component_, std::forward<Receiver>(receiver)};
+    }
+
+private:
+    IExecution* component_;
+};
+
+inline LifecycleSender<LifecycleOp::Initialize> initialize(IExecution& component) noexcept {
+    return LifecycleSender<LifecycleOp::Initialize>(component);
+}
+
+inline LifecycleSender<LifecycleOp::Reset> reset(IExecution& component) noexcept {
+    return LifecycleSender<LifecycleOp::Reset>(component);
+}
+
+inline LifecycleSender<LifecycleOp::Terminate> terminate(IExecution& component) noexcept {
+    return LifecycleSender<LifecycleOp::Terminate>(component);
+}
+
+/**
+ * Sender running execute() until the component is Done
+ *
+ * Each slice of at most steps_per_slice execute() calls is scheduled separately on the
+ * scheduler, so long-running components yield the execution context between slices.
+ * - Completes with set_value(count()) once execute() reports done.
+ * - Completes with set_error(last_error()) if the component failed a step.
+ * - Completes with set_error(operation_not_permitted) if the component is not Initialized.
+ * - Forwards set_stopped() and maps scheduler errors to set_error(std::error_code).
+ * - Slices that complete inline (e.g. InlineScheduler) are looped, not recursed, so stack
+ *   depth stays bounded.
+ * - Every slice completion, including stopped and error, goes through the same handoff, and
+ *   the downstream receiver is completed last, so it may destroy the operation state.
+ */
+template <typename Scheduler>
+class RunSender {
+public:
+    using sender_concept = sender_t;
+    using completion_signatures =
+        exec::completion_signatures<set_value_t(std::uint64_t), set_error_t(std::error_code), set_stopped_t()>;
+
+    RunSender(IExecution& component, Scheduler scheduler, std::uint64_t steps_per_slice) noexcept
+        : component_(&component), scheduler_(std::move(scheduler)), steps_per_slice_(steps_per_slice ? steps_per_slice : 1) {}
+
+    template <typename Receiver>
+    class Operation {
+    public:
+        using operation_state_concept = operation_state_t;
+
+        Operation(IExecution* component, Scheduler scheduler, std::uint64_t steps_per_slice, Receiver receiver)
+            : component_(component), scheduler_(std::move(scheduler)), steps_per_slice_(steps_per_slice),
+              receiver_(std::move(receiver)) {}
+
+        Operation(const Operation&) = delete;
+        Operation& operator=(const Operation&) = delete;
+
+        void start() & noexcept {
+            if (component_->lifecycle_state() != LifecycleState::Initialized) {
+                std::move(receiver_).set_error(std::make_error_code(std::errc::operation_not_permitted));
+                return;
+            }
+            schedule_slices();
+        }
+
+    private:
+        struct SliceReceiver {
+            using receiver_concept = receiver_t;
+            Operation* self;
+
+            void set_value() && noexcept { self->on_slice(Outcome::Value); }
+
+            template <typename Error>
+            void set_error(Error&& error) && noexcept {
+                if constexpr (std::is_convertible_v<Error, std::error_code>) {
+                    self->error_ = error;
+                } else {
+                    self->error_ = std::make_error_code(std::errc::io_error);
+                }
+                self->on_slice(Outcome::Error);
+            }
+
+            void set_stopped() && noexcept { self->on_slice(Outcome::Stopped); }
+        };
+
+        using ScheduleSender = decltype(std::declval<Scheduler&>().schedule());
+        using SliceOperation = decltype(std::declval<ScheduleSender>().connect(std::declval<SliceReceiver>()));
+
+        // Constructs the slice operation in place (operation states are not movable)
+        struct Connect {
+            Operation* self;
+            operator SliceOperation() const { return self->scheduler_.schedule().connect(SliceReceiver{self}); }
+        };
+
+        enum : int { Starting, Waiting, Completed };
+        enum class Outcome { Value, Error, Stopped };
+
+        // Trampoline: keep scheduling slices; inline completions loop here instead of recursing
+        void schedule_slices() noexcept {
+            for (;;) {
+                state_.store(Starting, std::memory_order_relaxed);
+                slice_.emplace(Connect{this});
+                slice_->start();
+                if (state_.exchange(Waiting, std::memory_order_acq_rel) != Completed) {
+                    return; // Completes asynchronously; on_slice() continues
+                }
+                if (after_slice()) {
+                    return;
+                }
+            }
+        }
+
+        void on_slice(Outcome outcome) noexcept {
+            outcome_ = outcome;
+            if (state_.exchange(Completed, std::memory_order_acq_rel) == Starting) {
+                return; // Completed inline; schedule_slices() continues
+            }
+            if (!after_slice()) {
+                schedule_slices();
+            }
+        }
+
+        // Act on the scheduled slice's outcome; returns true if the operation completed (the
+        // operation may already be destroyed, so callers must not touch members afterwards)
+        bool after_slice() noexcept {
+            switch (outcome_) {
+            case Outcome::Stopped:
+                std::move(receiver_).set_stopped();
+                return true;
+            case Outcome::Error:
+                complete_error(error_);
+                return true;
+            case Outcome::Value:
+                break;
+            }
+            return run_slice();
+        }
+
+        // Run one slice; returns true if the operation completed
+        bool run_slice() noexcept {
+            for (std::uint64_t i = 0; i < steps_per_slice_; ++i) {
+                if (component_->execute()) {
+                    if (component_->lifecycle_state() != LifecycleState::Initialized) {
+                        complete_error(std::make_error_code(std::errc::operation_not_permitted));
+                    } else if (auto ec = component_->last_error()) {
+                        complete_error(ec);
+                    } else {
+                        std::move(receiver_).set_value(component_->count());
+                    }
+                    return true;
+                }
+                if (component_->lifecycle_state() != LifecycleState::Initialized) {
+                    complete_error(std::make_error_code(std::errc::operation_not_permitted));
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void complete_error(std::error_code ec) noexcept { std::move(receiver_).set_error(ec); }
+
+        IExecution* component_;
+        Scheduler scheduler_;
+        std::uint64_t steps_per_slice_;
+        Receiver receiver_;
+        std::atomic<int> state_{Starting};
+        Outcome outcome_ = Outcome::Value;
+        std::error_code error_;
+        std::optional<SliceOperation> slice_;
+    };
+
+    template <typename Receiver>
+    Operation<std::remove_cvref_t<Receiver>> connect(Receiver&& receiver) const {
+        return Operation<std::remove_cvref_t<Receiver>>(component_, scheduler_, steps_per_slice_,
+                                                        std::forward<Receiver>(receiver));
+    }
+
+private:
+    IExecution* component_;
+    Scheduler scheduler_;
+    std::uint64_t steps_per_slice_;
+};
+
+/**
+ * @brief Sender that executes component on scheduler until Done
+ *
+ * @param steps_per_slice: execute() calls per scheduled slice (granularity of yielding)
+ */
+template <typename Scheduler>
+RunSender<std::remove_cvref_t<Scheduler>> run(IExecution& component, Scheduler&& scheduler,
+                                              std::uint64_t steps_per_slice = 1) noexcept {
+    return RunSender<std::remove_cvref_t<Scheduler>>(component, std::forward<Scheduler>(scheduler), steps_per_slice);
+}
+
+} // namespace dspai::comp::exec
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <system_error>
+#include <type_traits>
+
+namespace dspai::comp {
+
+/// Cache line size used to isolate producer and consumer state
+inline constexpr std::size_t cache_line_size = 64;
+
+/**
+ * Bounded single-producer single-consumer ring buffer
+ *
+ * - Lock-free and wait-free; one producer thread and one consumer thread.
+ * - Storage is allocated once by allocate(), normally from a component's doInitialize().
+ *   push/pop never allocate.
+ * - Capacity is rounded up to a power of two.
+ * - Producer and consumer indices live on separate cache lines; each side caches the
+ *   other side's index so a polling consumer on an empty ring only reads a shared line.
+ *
+ * Thread Safety: push-side methods from one thread, pop-side methods from one thread.
+ * allocate() and clear() require external synchronization (no concurrent access).
+ */
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable_v<T>, "SpscRing requires trivially copyable elements");
+    static_assert(std::is_default_constructible_v<T>, "SpscRing requires default constructible elements");
+
+public:
+    SpscRing() = default;
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief Allocate storage for at least capacity elements
+     *
+     * - Discards any previous contents.
+     * - No exceptions.
+     *
+     * @return std::error_code - invalid_argument for zero capacity, not_enough_memory on failure
+     */
+    std::error_code allocate(std::size_t capacity) noexcept {
+        if (capacity == 0 || capacity > (std::size_t{1} << 62)) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+        const std::size_t size = std::bit_ceil(capacity);
+        std::unique_ptr<T[]> buffer(new (std::nothrow) T[size]);
+        if (!buffer) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        buffer_ = std::move(buffer);
+        mask_ = size - 1;
+        clear();
+        return {};
+    }
+
+    /// Release storage
+    void deallocate() noexcept {
+        buffer_.reset();
+        mask_ = 0;
+        clear();
+    }
+
+    /// Discard contents (not thread-safe)
+    void clear() noexcept {
+        producer_.head.store(0, std::memory_order_relaxed);
+        consumer_.tail.store(0, std::memory_order_relaxed);
+        producer_.cached_tail = 0;
+        consumer_.cached_head = 0;
+    }
+
+    bool allocated() const noexcept { return buffer_ != nullptr; }
+
+    std::size_t capacity() const noexcept { return buffer_ ? mask_ + 1 : 0; }
+
+    /// Approximate number of readable elements (exact when called from either side)
+    std::size_t size() const noexcept {
+        const auto head = producer_.head.load(std::memory_order_acquire);
+        const auto tail = consumer_.tail.load(std::memory_order_acquire);
+        return static_cast<std::size_t>(head - tail);
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    // Producer side
+
+    /// Push one element; returns false if the ring is full
+    bool try_push(const T& value) noexcept {
+        if (!buffer_) {
+            return false;
+        }
+        const auto head = producer_.head.load(std::memory_order_relaxed);
+        if (head - producer_.cached_tail > mask_) {
+            producer_.cached_tail = consumer_.tail.load(std::memory_order_acquire);
+            if (head - producer_.cached_tail > mask_) {
+                return false;
+            }
+        }
+        buffer_[head & mask_] = value;
+        producer_.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Push as many elements as fit; returns the number pushed
+    std::size_t write(std::span<const T> values) noexcept {
+        auto region = writable();
+        std::size_t n = std::min(values.size(), region.size());
+        std::copy_n(values.data(), n, region.data());
+        if (n < values.size()) {
+            // Wrapped: the remainder may fit at the start of the buffer
+            commit(n);
+            region = writable();
+            const std::size_t m = std::min(values.size() - n, region.size());
+            std::copy_n(values.data() + n, m, region.data());
+            commit(m);
+            return n + m;
+        }
+        commit(n);
+        return n;
+    }
+
+    /// Contiguous free region for zero-copy writes; publish with commit()
+    std::span<T> writable() noexcept {
+        if (!buffer_) {
+            return {};
+        }
+        const auto head = producer_.head.load(std::memory_order_relaxed);
+        producer_.cached_tail = consumer_.tail.load(std::memory_order_acquire);
+        const std::size_t free = mask_ + 1 - static_cast<std::size_t>(head - producer_.cached_tail);
+        const std::size_t index = static_cast<std::size_t>(head & mask_);
+        return {buffer_.get() + index, std::min(free, mask_ + 1 - index)};
+    }
+
+    /// Publish n elements written into writable()
+    void commit(std::size_t n) noexcept {
+        producer_.head.store(producer_.head.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    // Consumer side
+
+    /// Oldest element, or nullptr if empty
+    const T* front() noexcept {
+        const auto tail = consumer_.tail.load(std::memory_order_relaxed);
+        if (tail == consumer_.cached_head) {
+            consumer_.cached_head = producer_.head.load(std::memory_order_acquire);
+            if (tail == consumer_.cached_head) {
+                return nullptr;
+            }
+        }
+        return &buffer_[tail & mask_];
+    }
+
+    /// Pop one element; returns false if the ring is empty
+    bool try_pop(T& value) noexcept {
+        const T* item = front();
+        if (!item) {
+            return false;
+        }
+        value = *item;
+        consume(1);
+        return true;
+    }
+
+    /// Pop up to values.size() elements; returns the number popped
+    std::size_t read(std::span<T> values) noexcept {
+        std::size_t total = 0;
+        for (int pass = 0; pass < 2 && total < values.size(); ++pass) {
+            auto region = readable();
+            const std::size_t n = std::min(values.size() - total, region.size());
+            std::copy_n(region.data(), n, values.data() + total);
+            consume(n);
+            total += n;
+        }
+        return total;
+    }
+
+    /// Contiguous readable region for zero-copy reads; release with consume()
+    std::span<const T> readable() noexcept {
+        if (!buffer_) {
+            return {};
+        }
+        const auto tail = consumer_.tail.load(std::memory_order_relaxed);
+        consumer_.cached_head = producer_.head.load(std::memory_order_acquire);
+        const std::size_t used = static_cast<std::size_t>(consumer_.cached_head - tail);
+        const std::size_t index = static_cast<std::size_t>(tail & mask_);
+        return {buffer_.get() + index, std::min(used, mask_ + 1 - index)};
+    }
+
+    /// Release n elements obtained from front() or readable()
+    void consume(std::size_t n) noexcept {
+        consumer_.tail.store(consumer_.tail.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+private:
+    struct alignas(cache_line_size) ProducerState {
+        std::atomic<std::uint64_t> head{0};
+        std::uint64_t cached_tail = 0;
+    };
+    struct alignas(cache_line_size) ConsumerState {
+        std::atomic<std::uint64_t> tail{0};
+        std::uint64_t cached_head = 0;
+    };
+
+    ProducerState producer_;
+    ConsumerState consumer_;
+    std::unique_ptr<T[]> buffer_;
+    std::size_t mask_ = 0;
+};
+
+} // namespace dspai::comp
@@ -0,0 +1,378 @@
+#pragma once
+
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/tag.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace dspai::comp {
+
+/**
+ * Output layout of a StreamAligner block
+ */
+enum class MergeLayout {
+    Planar,     ///< One contiguous block per stream (zero-copy when possible)
+    Interleaved ///< Sample-major: out[sample * num_streams + stream]
+};
+
+/**
+ * One input stream of a StreamAligner: samples plus their timestamp tags
+ *
+ * Timestamp tags (TagKey::Timestamp) give the common-clock time, in samples, of the tagged
+ * sample: time(k) = tag.value + (k - tag.offset) until the next timestamp tag.
+ */
+template <typename T>
+struct AlignerInput {
+    SpscRing<T>* samples = nullptr;
+    TagRing* tags = nullptr;
+};
+
+/**
+ * Per-stream alignment statistics
+ */
+struct AlignerStreamStats {
+    std::uint64_t padded = 0;  ///< Samples inserted because the stream had no data for that time
+    std::uint64_t dropped = 0; ///< Samples discarded because they were older than the common clock
+};
+
+/**
+ * Multi-stream time-alignment and merge component
+ *
+ * Aligns N input streams with different latencies to a common sample clock using their
+ * timestamp tags and emits one block of block_size samples per stream per execute().
+ * - Streams that are ahead (data for later times) are padded with T{} at the front.
+ * - Streams that are behind (data for earlier times) have their stale samples dropped.
+ * - A stream without data yet holds the block back; after stall_limit steps its missing
+ *   samples are padded so one dead stream cannot stall the others (0 = wait forever). It
+ *   stays stalled out, padded without waiting, until it has data covering a whole block.
+ * - Output starts once every stream has received a timestamp, at start_time or, if unset,
+ *   the latest first timestamp of all streams. With a stall_limit, streams still without a
+ *   timestamp after stall_limit steps are left out of the start; their samples are dropped
+ *   and their blocks padded until a timestamp arrives. After reset() output restarts from
+ *   the streams' current timing (start_time only applies to the first start).
+ * - Planar blocks that are contiguous and fully covered by one stream's ring are returned
+ *   as views into that ring (zero-copy) and released on the next execute()/reset().
+ * - Per-stream state and scratch are allocated in doInitialize() from memory() (charged to
+ *   the component's MemoryAccount); doExecute() does not allocate.
+ *
+ * doExecute() never completes on its own (streaming); check has_output() after execute().
+ */
+template <typename T>
+class StreamAligner : public Component {
+public:
+    struct Config {
+        std::size_t block_size = 1024;
+        MergeLayout layout = MergeLayout::Planar;
+        std::size_t stall_limit = 0;
+        std::optional<std::uint64_t> start_time;
+    };
+
+    StreamAligner(std::vector<AlignerInput<T>> inputs, Config config)
+        : inputs_(std::move(inputs)), config_(config) {}
+
+    std::size_t num_streams() const noexcept { return inputs_.size(); }
+    const Config& config() const noexcept { return config_; }
+
+    /// True if the last execute() produced an output block
+    bool has_output() const noexcept { return has_output_; }
+
+    /// Common-clock time of the first sample of the current output block
+    std::uint64_t block_time() const noexcept { return block_time_; }
+
+    /// Number of blocks produced since initialize() or reset()
+    std::uint64_t blocks() const noexcept { return blocks_; }
+
+    /// Current block of one stream (MergeLayout::Planar)
+    std::span<const T> planar(std::size_t stream) const noexcept {
+        if (!has_output_ || config_.layout != MergeLayout::Planar || stream >= streams_.size()) {
+            return {};
+        }
+        const T* data = streams_[stream].view ? streams_[stream].view : scratch_.get() + stream * config_.block_size;
+        return {data, config_.block_size};
+    }
+
+    /// Current block of all streams (MergeLayout::Interleaved)
+    std::span<const T> interleaved() const noexcept {
+        if (!has_output_ || config_.layout != MergeLayout::Interleaved) {
+            return {};
+        }
+        return {scratch_.get(), config_.block_size * streams_.size()};
+    }
+
+    /// True if the current planar block of stream points directly into its input ring
+    bool is_zero_copy(std::size_t stream) const noexcept {
+        return has_output_ && stream < streams_.size() && streams_[stream].view != nullptr;
+    }
+
+    AlignerStreamStats stats(std::size_t stream) const noexcept {
+        return stream < streams_.size() ? streams_[stream].stats : AlignerStreamStats{};
+    }
+
+protected:
+    std::error_code doInitialize() noexcept override {
+        if (inputs_.empty() || config_.block_size == 0) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+        for (const auto& input : inputs_) {
+            if (!input.samples || !input.tags) {
+                return std::make_error_code(std::errc::invalid_argument);
+            }
+        }
+
+        std::pmr::vector<StreamState> streams(memory());
+        try {
+            streams.resize(inputs_.size());
+        } catch (...) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        auto scratch = make_array<T>(memory(), config_.block_size * inputs_.size());
+        if (!scratch) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+
+        // Rebuild in place: pmr assignment keeps the old resource instead of memory()'s
+        std::destroy_at(&streams_);
+        std::construct_at(&streams_, std::move(streams));
+        scratch_ = std::move(scratch);
+        blocks_total_ = 0;
+        restart();
+        return {};
+    }
+
+    void doTerminate() noexcept override {
+        streams_.clear();
+        streams_.shrink_to_fit();
+        scratch_.reset();
+    }
+
+    void doPrefault() noexcept override {
+        prefault(std::span<T>(scratch_.get(), config_.block_size * inputs_.size()));
+    }
+
+    void doReset() noexcept override {
+        release_views();
+        // Stream positions and timing belong to the inputs and survive a reset
+        for (auto& stream : streams_) {
+            stream.stalled = 0;
+            stream.stats = {};
+        }
+        restart();
+    }
+
+    bool doExecute() noexcept override {
+        release_views();
+        has_output_ = false;
+
+        for (std::size_t s = 0; s < streams_.size(); ++s) {
+            absorb_tags(s);
+        }
+
+        if (!started_) {
+            // Wait for every stream's first timestamp, or for untimed streams to stall out
+            std::uint64_t start = 0;
+            bool timed = false;
+            bool waiting = false;
+            for (auto& stream : streams_) {
+                if (stream.timed) {
+                    start = std::max(start, stream.next_time);
+                    timed = true;
+                } else if (config_.stall_limit == 0 || ++stream.stalled <= config_.stall_limit) {
+                    waiting = true;
+                }
+            }
+            if (waiting || !timed) {
+                return false;
+            }
+            clock_ = blocks_total_ == 0 ? config_.start_time.value_or(start) : start;
+            started_ = true;
+        }
+
+        // Every stream must have data up to the end of the block (or be stalled out). A
+        // stalled-out stream stays so, padded on every block, until it covers a block again.
+        bool ready = true;
+        const std::size_t block = config_.block_size;
+        for (std::size_t s = 0; s < streams_.size(); ++s) {
+            auto& stream = streams_[s];
+            if (stream.timed && stream.next_time + inputs_[s].samples->size() >= clock_ + block) {
+                stream.stalled = 0;
+            } else if (config_.stall_limit == 0 || stream.stalled <= config_.stall_limit) {
+                if (config_.stall_limit == 0 || ++stream.stalled <= config_.stall_limit) {
+                    ready = false;
+                }
+            }
+        }
+        if (!ready) {
+            return false;
+        }
+
+        for (std::size_t s = 0; s < streams_.size(); ++s) {
+            auto& stream = streams_[s];
+            auto& ring = *inputs_[s].samples;
+            if (config_.layout == MergeLayout::Planar && stream.next_time == clock_ && segment(s) >= block &&
+                ring.readable().size() >= block) {
+                stream.view = ring.readable().data();
+                stream.pending_release = block;
+                stream.consumed += block;
+                stream.next_time += block;
+            } else if (config_.layout == MergeLayout::Planar) {
+                fill(s, scratch_.get() + s * block, 1);
+            } else {
+                fill(s, scratch_.get() + s, streams_.size());
+            }
+        }
+
+        block_time_ = clock_;
+        clock_ += block;
+        blocks_++;
+        blocks_total_++;
+        has_output_ = true;
+        return false;
+    }
+
+private:
+    struct StreamState {
+        std::uint64_t consumed = 0;  ///< Stream index of the next unread sample
+        std::uint64_t next_time = 0; ///< Common-clock time of the next unread sample
+        bool timed = false;
+        std::size_t stalled = 0;
+        std::size_t pending_release = 0;
+        const T* view = nullptr;
+        AlignerStreamStats stats;
+    };
+
+    void restart() noexcept {
+        started_ = false;
+        has_output_ = false;
+        clock_ = 0;
+        block_time_ = 0;
+        blocks_ = 0;
+    }
+
+    void release_views() noexcept {
+        for (std::size_t s = 0; s < streams_.size(); ++s) {
+            auto& stream = streams_[s];
+            if (stream.pending_release) {
+                inputs_[s].samples->consume(stream.pending_release);
+                stream.pending_release = 0;
+                stream.view = nullptr;
+            }
+        }
+    }
+
+    // Apply timestamp tags at or before the next unread sample; other tags are discarded
+    void absorb_tags(std::size_t s) noexcept {
+        auto& stream = streams_[s];
+        auto& tags = *inputs_[s].tags;
+        for (const Tag* tag = tags.front(); tag && tag->offset <= stream.consumed; tag = tags.front()) {
+            if (tag->key == TagKey::Timestamp) {
+                stream.next_time = tag->value + (stream.consumed - tag->offset);
+                stream.timed = true;
+            }
+            tags.consume(1);
+        }
+    }
+
+    // Readable samples before the next tag (a possible timing discontinuity)
+    std::size_t segment(std::size_t s) noexcept {
+        std::size_t n = inputs_[s].samples->size();
+        if (const Tag* tag = inputs_[s].tags->front()) {
+            n = static_cast<std::size_t>(std::min<std::uint64_t>(n, tag->offset - streams_[s].consumed));
+        }
+        return n;
+    }
+
+    // Drop the next n samples of stream s
+    void discard(std::size_t s, std::size_t n) noexcept {
+        auto& stream = streams_[s];
+        auto& ring = *inputs_[s].samples;
+        for (std::size_t left = n; left;) {
+            const std::size_t chunk = std::min(left, ring.readable().size());
+            ring.consume(chunk);
+            left -= chunk;
+        }
+        stream.consumed += n;
+        stream.next_time += n;
+        stream.stats.dropped += n;
+    }
+
+    // Fill one stream's block at out[i * stride], padding and dropping to follow the clock
+    void fill(std::size_t s, T* out, std::size_t stride) noexcept {
+        auto& stream = streams_[s];
+        auto& ring = *inputs_[s].samples;
+        const std::size_t block = config_.block_size;
+        std::size_t pos = 0;
+
+        while (pos < block) {
+            absorb_tags(s);
+            if (!stream.timed) {
+                // Stalled out before its first timestamp: samples have no place on the clock
+                const std::size_t available = segment(s);
+                if (available == 0) {
+                    break;
+                }
+                discard(s, available);
+                continue;
+            }
+            const std::uint64_t now = clock_ + pos;
+            if (stream.next_time > now) {
+                // Stream starts later: pad up to its first sample
+                const auto n = static_cast<std::size_t>(std::min<std::uint64_t>(stream.next_time - now, block - pos));
+                for (std::size_t i = pos; i < pos + n; ++i) {
+                    out[i * stride] = T{};
+                }
+                stream.stats.padded += n;
+                pos += n;
+                continue;
+            }
+
+            const std::size_t available = segment(s);
+            if (available == 0) {
+                break;
+            }
+            if (stream.next_time < now) {
+                // Stream is behind: drop samples older than the clock
+                discard(s, static_cast<std::size_t>(std::min<std::uint64_t>(now - stream.next_time, available)));
+                continue;
+            }
+
+            const std::size_t n = std::min(block - pos, available);
+            for (std::size_t left = n; left;) {
+                auto region = ring.readable();
+                const std::size_t chunk = std::min(left, region.size());
+                for (std::size_t i = 0; i < chunk; ++i) {
+                    out[(pos + i) * stride] = region[i];
+                }
+                ring.consume(chunk);
+                pos += chunk;
+                left -= chunk;
+            }
+            stream.consumed += n;
+            stream.next_time += n;
+        }
+
+        // Stream stalled out: pad the rest of the block
+        for (std::size_t i = pos; i < block; ++i) {
+            out[i * stride] = T{};
+        }
+        stream.stats.padded += block - pos;
+    }
+
+    std::vector<AlignerInput<T>> inputs_;
+    Config config_;
+    std::pmr::vector<StreamState> streams_;
+    ResourceArray<T> scratch_;
+    bool started_ = false;
+    bool has_output_ = false;
+    std::uint64_t clock_ = 0;
+    std::uint64_t block_time_ = 0;
+    std::uint64_t blocks_ = 0;
+    std::uint64_t blocks_total_ = 0;
+};
+
+} // namespace dspai::comp
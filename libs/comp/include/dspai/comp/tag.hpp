@@ -0,0 +1,169 @@
+#pragma once
+
+#include <dspai/comp/spsc_ring.hpp>
+#include <bit>
+#include <cstdint>
+
+namespace dspai::comp {
+
+/**
+ * Well-known tag keys
+ *
+ * Values from User upward are free for application-defined tags.
+ */
+enum class TagKey : std::uint32_t {
+    None = 0,
+    Timestamp,   ///< value: time of the tagged sample (application-defined units)
+    Frequency,   ///< value: new center/tuning frequency as double
+    BurstStart,  ///< first sample of a burst
+    BurstEnd,    ///< last sample of a burst
+    Latency,     ///< value: TickClock time the probe entered the edge; aux: probe sequence (see LatencyTracer)
+    User = 0x1000
+};
+
+/**
+ * Sample-aligned metadata item
+ *
+ * - offset is the absolute index of the tagged sample in its stream.
+ * - Payload is a single 64-bit word plus a 32-bit auxiliary field; doubles are stored
+ *   bit-cast (see make_tag() / Tag::as_double()).
+ * - Trivially copyable and 24 bytes so tags move through rings without allocations.
+ */
+struct Tag {
+    std::uint64_t offset = 0;
+    TagKey key = TagKey::None;
+    std::uint32_t aux = 0;
+    std::uint64_t value = 0;
+
+    double as_double() const noexcept { return std::bit_cast<double>(value); }
+};
+
+inline constexpr Tag make_tag(std::uint64_t offset, TagKey key, std::uint64_t value = 0,
+                              std::uint32_t aux = 0) noexcept {
+    return Tag{offset, key, aux, value};
+}
+
+inline constexpr Tag make_tag(std::uint64_t offset, TagKey key, double value,
+                              std::uint32_t aux = 0) noexcept {
+    return Tag{offset, key, aux, std::bit_cast<std::uint64_t>(value)};
+}
+
+/**
+ * Sample rate ratio of a component (output rate = input rate * interpolation / decimation)
+ */
+struct RateRatio {
+    std::uint32_t interpolation = 1;
+    std::uint32_t decimation = 1;
+
+    /// Map an input sample offset to the corresponding output sample offset (rounded down)
+    constexpr std::uint64_t rescale(std::uint64_t offset) const noexcept {
+        // Split to avoid overflowing offset * interpolation for large offsets
+        return (offset / decimation) * interpolation + (offset % decimation) * interpolation / decimation;
+    }
+};
+
+/**
+ * Per-edge tag storage: preallocated SPSC ring of tags in non-decreasing offset order
+ */
+using TagRing = SpscRing<Tag>;
+
+/**
+ * Producer end of a tag edge
+ *
+ * Bound to a TagRing owned by the edge. Posting to an unbound output is a no-op.
+ * Tags that do not fit are dropped and counted rather than blocking the stream.
+ */
+class TagOutput {
+public:
+    TagOutput() = default;
+    explicit TagOutput(TagRing& ring) noexcept : ring_(&ring) {}
+
+    void bind(TagRing* ring) noexcept { ring_ = ring; }
+    bool bound() const noexcept { return ring_ != nullptr; }
+
+    /// Post a tag; offsets must be non-decreasing. Returns false if dropped.
+    bool post(const Tag& tag) noexcept {
+        if (!ring_) {
+            return false;
+        }
+        if (!ring_->try_push(tag)) {
+            dropped_++;
+            return false;
+        }
+        return true;
+    }
+
+    /// Number of tags dropped because the ring was full
+    std::uint64_t dropped() const noexcept { return dropped_; }
+
+private:
+    TagRing* ring_ = nullptr;
+    std::uint64_t dropped_ = 0;
+};
+
+/**
+ * Consumer end of a tag edge
+ *
+ * Components call take() or propagate() once per block with the absolute offset one past
+ * the last input sample consumed. When no tags are pending this is a single load.
+ *
+ * Propagation is explicit by design: Graph and the executors never move tags, because only
+ * the component knows how many samples a step consumed and how its rate changes offsets.
+ * A component that neither reads nor rewrites tags forwards them with one propagate() call
+ * per step. If a component never drains its TagInput, the ring fills and the upstream
+ * TagOutput drops further tags (counted in dropped()).
+ */
+class TagInput {
+public:
+    TagInput() = default;
+    explicit TagInput(TagRing& ring) noexcept : ring_(&ring) {}
+
+    void bind(TagRing* ring) noexcept { ring_ = ring; }
+    bool bound() const noexcept { return ring_ != nullptr; }
+
+    /// Oldest pending tag, or nullptr
+    const Tag* peek() noexcept { return ring_ ? ring_->front() : nullptr; }
+
+    /**
+     * @brief Consume all tags with offset < end, calling fn(const Tag&) for each
+     *
+     * @return number of tags consumed
+     */
+    template <typename Fn>
+    std::size_t take(std::uint64_t end, Fn&& fn) noexcept {
+        if (!ring_) {
+            return 0;
+        }
+        std::size_t n = 0;
+        for (const Tag* tag = ring_->front(); tag && tag->offset < end; tag = ring_->front()) {
+            fn(*tag);
+            ring_->consume(1);
+            n++;
+        }
+        return n;
+    }
+
+    /**
+     * @brief Forward all tags with offset < end to out, rescaling offsets by ratio
+     *
+     * Used by rate-changing components so downstream tags stay sample-aligned:
+     * out offset = ratio.rescale(in offset - input_origin) + output_origin.
+     * input_origin/output_origin align the two sample counters when they do not start at 0.
+     *
+     * @return number of tags forwarded (including any dropped by out)
+     */
+    std::size_t propagate(std::uint64_t end, TagOutput& out, RateRatio ratio = {},
+                          std::uint64_t input_origin = 0, std::uint64_t output_origin = 0) noexcept {
+        return take(end, [&](const Tag& tag) {
+            Tag moved = tag;
+            const std::uint64_t relative = tag.offset > input_origin ? tag.offset - input_origin : 0;
+            moved.offset = ratio.rescale(relative) + output_origin;
+            out.post(moved);
+        });
+    }
+
+private:
+    TagRing* ring_ = nullptr;
+};
+
+} // namespace dspai::comp
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace dspai::comp {
+
+/**
+ * Fixed-size pool of worker threads for background (non real-time) work
+ *
+ * Intended for setup work such as asynchronous initialize(); uses a mutex-protected queue
+ * and is not meant for the streaming hot path.
+ * - start() spawns the workers; stop() drains queued work and joins them.
+ * - The destructor calls stop().
+ * - Tasks must not throw.
+ *
+ * Thread Safety: submit() is thread-safe. start()/stop() must not race with each other.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    ThreadPool() = default;
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool() noexcept { stop(); }
+
+    /**
+     * @brief Spawn worker threads
+     *
+     * @return std::error_code - empty on success
+     *         - invalid_argument if threads is zero
+     *         - operation_not_permitted if already started
+     *         - resource_unavailable_try_again if a thread cannot be created
+     */
+    std::error_code start(std::size_t threads) noexcept {
+        if (threads == 0) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+        if (!workers_.empty()) {
+            return std::make_error_code(std::errc::operation_not_permitted);
+        }
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = false;
+            accepting_ = true;
+        }
+        try {
+            workers_.reserve(threads);
+            for (std::size_t i = 0; i < threads; ++i) {
+                workers_.emplace_back([this] { loop(); });
+            }
+        } catch (...) {
+            stop();
+            return std::make_error_code(std::errc::resource_unavailable_try_again);
+        }
+        return {};
+    }
+
+    /**
+     * @brief Run remaining queued tasks and join the workers
+     *
+     * Idempotent.
+     */
+    void stop() noexcept {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+            accepting_ = false;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        workers_.clear();
+    }
+
+    /// Number of worker threads
+    std::size_t size() const noexcept { return workers_.size(); }
+
+    /**
+     * @brief Queue a task for execution on a worker thread
+     *
+     * @return std::error_code - empty on success
+     *         - operation_not_permitted if the pool is not running
+     *         - not_enough_memory if the task cannot be queued
+     */
+    std::error_code submit(Task task) noexcept {
+        {
+            std::lock_guard lock(mutex_);
+            if (!accepting_) {
+                return std::make_error_code(std::errc::operation_not_permitted);
+            }
+            try {
+                tasks_.push_back(std::move(task));
+            } catch (...) {
+                return std::make_error_code(std::errc::not_enough_memory);
+            }
+        }
+        cv_.notify_one();
+        return {};
+    }
+
+private:
+    void loop() noexcept {
+        for (;;) {
+            Task task;
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Task> tasks_;
+    std::vector<std::thread> workers_;
+    bool stopping_ = false;
+    bool accepting_ = false;
+};
+
+} // namespace dspai::comp
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <dspai/comp/spsc_ring.hpp>
+#include <cstdint>
+
+namespace dspai::comp {
+
+/**
+ * Command scheduled to take effect at an absolute sample index
+ */
+template <typename Command>
+struct TimedCommand {
+    std::uint64_t at = 0; ///< Absolute sample index of the first sample the command applies to
+    Command command{};
+};
+
+/**
+ * Sample-accurate timed command queue
+ *
+ * Lets a control thread schedule commands (frequency hops, gain changes, ...) against a
+ * component's absolute sample counter. Inside doExecute() the component hands its block to
+ * run(), which splits the block at every command boundary so the command takes effect on
+ * exactly the requested sample:
+ *
+ *     bool doExecute() noexcept override {
+ *         commands_.run(block_size_,
+ *             [&](const Gain& g) { gain_ = g.value; },
+ *             [&](std::size_t offset, std::size_t count) { scale(in_ + offset, out_ + offset, count); });
+ *         ...
+ *     }
+ *
+ * - schedule() is lock-free and allocation-free (SPSC ring sized by allocate() in doInitialize()).
+ * - Commands must be scheduled in non-decreasing sample order. A command whose sample has
+ *   already passed is applied at the start of the next block.
+ * - The sample counter starts at zero and is returned to zero by reset().
+ *
+ * Thread Safety: schedule() from one control thread; all other methods from the thread
+ * executing the component.
+ */
+template <typename Command>
+class TimedCommandQueue {
+public:
+    /// Allocate room for capacity pending commands (call from doInitialize())
+    std::error_code allocate(std::size_t capacity) noexcept {
+        position_ = 0;
+        return ring_.allocate(capacity);
+    }
+
+    /// Release storage (call from doTerminate())
+    void deallocate() noexcept { ring_.deallocate(); }
+
+    /**
+     * @brief Schedule command to take effect at absolute sample index at
+     *
+     * @return false if the queue is full (command not scheduled)
+     */
+    bool schedule(std::uint64_t at, const Command& command) noexcept {
+        return ring_.try_push(TimedCommand<Command>{at, command});
+    }
+
+    /// Absolute index of the next sample to be processed
+    std::uint64_t position() const noexcept { return position_; }
+
+    /// Number of pending commands
+    std::size_t pending() const noexcept { return ring_.size(); }
+
+    /**
+     * @brief Process a block of n samples starting at position()
+     *
+     * Calls process(offset, count) for each sub-block between command boundaries and
+     * apply(const Command&) for each command before the first sample it applies to.
+     * Advances position() by n.
+     *
+     * @return number of commands applied
+     */
+    template <typename Apply, typename Process>
+    std::size_t run(std::size_t n, Apply&& apply, Process&& process) noexcept {
+        const std::uint64_t end = position_ + n;
+        std::uint64_t cursor = position_;
+        std::size_t applied = 0;
+
+        for (const auto* next = ring_.front(); next && next->at < end; next = ring_.front()) {
+            if (next->at > cursor) {
+                process(static_cast<std::size_t>(cursor - position_), static_cast<std::size_t>(next->at - cursor));
+                cursor = next->at;
+            }
+            apply(next->command);
+            ring_.consume(1);
+            applied++;
+        }
+
+        if (cursor < end) {
+            process(static_cast<std::size_t>(cursor - position_), static_cast<std::size_t>(end - cursor));
+        }
+        position_ = end;
+        return applied;
+    }
+
+    /**
+     * @brief Drop pending commands and return the sample counter to zero
+     *
+     * Call from doReset(). Commands scheduled concurrently with reset() may survive it.
+     */
+    void reset() noexcept {
+        ring_.consume(ring_.readable().size());
+        ring_.consume(ring_.readable().size());
+        position_ = 0;
+    }
+
+private:
+    SpscRing<TimedCommand<Command>> ring_;
+    std::uint64_t position_ = 0;
+};
+
+} // namespace dspai::comp
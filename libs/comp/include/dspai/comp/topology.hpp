@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace dspai::comp {
+
+/**
+ * One logical CPU (hardware thread) and where it sits in the machine
+ *
+ * All indices except id are dense (0..count-1) across the whole machine.
+ */
+struct LogicalCpu {
+    unsigned id = 0;      ///< OS CPU number
+    unsigned package = 0; ///< Socket
+    unsigned core = 0;    ///< Physical core
+    unsigned smt = 0;     ///< Position among the core's hardware threads (0 = first)
+    unsigned l3 = 0;      ///< Last-level (L3) cache domain
+    unsigned numa = 0;    ///< NUMA node
+};
+
+/**
+ * CPU topology of the machine
+ *
+ */
+struct CpuTopology {
+    std::vector<LogicalCpu> cpus; ///< Online CPUs in id order
+    unsigned packages = 0;
+    unsigned cores = 0;
+    unsigned l3_domains = 0;
+    unsigned numa_nodes = 0;
+
+    const LogicalCpu* find(unsigned id) const noexcept {
+        for (const auto& cpu : cpus) {
+            if (cpu.id == id) {
+                return &cpu;
+            }
+        }
+        return nullptr;
+    }
+};
+
+namespace detail {
+
+// Parse a kernel CPU list such as "0-3,8,10-11"
+inline bool parse_cpu_list(const std::string& text, std::vector<unsigned>& out) {
+    out.clear();
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        const auto end = std::min(text.find(',', pos), text.size());
+        const auto item = text.substr(pos, end - pos);
+        pos = end + 1;
+        if (item.empty() || item == "\n") {
+            continue;
+        }
+        const auto dash = item.find('-');
+        try {
+            const unsigned first = static_cast<unsigned>(std::stoul(item.substr(0, dash)));
+            const unsigned last = dash == std::string::npos ? first : static_cast<unsigned>(std::stoul(item.substr(dash + 1)));
+            for (unsigned cpu = first; cpu <= last; ++cpu) {
+                out.push_back(cpu);
+            }
+        } catch (const std::logic_error&) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool read_line(const std::filesystem::path& path, std::string& line) {
+    std::ifstream file(path);
+    return file && std::getline(file, line);
+}
+
+inline bool read_unsigned(const std::filesystem::path& path, unsigned& value) {
+    std::string line;
+    if (!read_line(path, line)) {
+        return false;
+    }
+    try {
+        value = static_cast<unsigned>(std::stoul(line));
+    } catch (const std::logic_error&) {
+        return false;
+    }
+    return true;
+}
+
+// Map arbitrary keys to dense indices in first-seen order
+template <typename Key>
+unsigned dense_index(std::map<Key, unsigned>& ids, const Key& key) {
+    return ids.try_emplace(key, static_cast<unsigned>(ids.size())).first->second;
+}
+
+} // namespace detail
+
+/**
+ * @brief Discover sockets, cores, SMT siblings, L3 domains and NUMA nodes from sysfs
+ *
+ * Reads devices/system/cpu/{online,cpuN/topology,cpuN/cache} and devices/system/node under
+ * sysfs_root (configurable so tests can supply a fake tree). Missing cache or NUMA
+ * information degrades gracefully: L3 falls back to the package, NUMA to node 0.
+ *
+ * @return the topology, or
+ *         - no_such_file_or_directory if the online CPU list or per-CPU topology is missing
+ *         - invalid_argument if sysfs contents cannot be parsed
+ *         - not_enough_memory
+ */
+inline std::expected<CpuTopology, std::error_code> discover_topology(const std::string& sysfs_root = "/sys") noexcept {
+    namespace fs = std::filesystem;
+    try {
+        const fs::path cpu_root = fs::path(sysfs_root) / "devices/system/cpu";
+        const fs::path node_root = fs::path(sysfs_root) / "devices/system/node";
+
+        std::string line;
+        std::vector<unsigned> online;
+        if (!detail::read_line(cpu_root / "online", line)) {
+            return std::unexpected(std::make_error_code(std::errc::no_such_file_or_directory));
+        }
+        if (!detail::parse_cpu_list(line, online) || online.empty()) {
+            return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+        }
+
+        // NUMA node of each CPU
+        std::map<unsigned, unsigned> numa_of;
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(node_root, ec)) {
+            const auto name = entry.path().filename().string();
+            if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+                name.find_first_not_of("0123456789", 4) != std::string::npos) {
+                continue;
+            }
+            std::vector<unsigned> cpus;
+            if (detail::read_line(entry.path() / "cpulist", line) && detail::parse_cpu_list(line, cpus)) {
+                const auto node = static_cast<unsigned>(std::stoul(name.substr(4)));
+                for (auto cpu : cpus) {
+                    numa_of[cpu] = node;
+                }
+            }
+        }
+
+        CpuTopology topology;
+        std::map<unsigned, unsigned> package_ids;
+        std::map<std::pair<unsigned, unsigned>, unsigned> core_ids;
+        std::map<unsigned, unsigned> l3_ids;
+        std::map<unsigned, unsigned> numa_ids;
+        std::map<unsigned, unsigned> threads_per_core;
+
+        for (auto id : online) {
+            const fs::path dir = cpu_root / ("cpu" + std::to_string(id));
+            unsigned package = 0;
+            unsigned core = 0;
+            if (!detail::read_unsigned(dir / "topology/physical_package_id", package) ||
+                !detail::read_unsigned(dir / "topology/core_id", core)) {
+                return std::unexpected(std::make_error_code(std::errc::no_such_file_or_directory));
+            }
+
+            LogicalCpu cpu;
+            cpu.id = id;
+            cpu.package = detail::dense_index(package_ids, package);
+            cpu.core = detail::dense_index(core_ids, std::pair{package, core});
+            cpu.smt = threads_per_core[cpu.core]++;
+
+            // L3 domain keyed by the lowest CPU sharing it; fall back to the package
+            unsigned l3_key = 0x80000000u + package;
+            for (const auto& entry : fs::directory_iterator(dir / "cache", ec)) {
+                unsigned level = 0;
+                std::vector<unsigned> shared;
+                if (entry.path().filename().string().rfind("index", 0) == 0 &&
+                    detail::read_unsigned(entry.path() / "level", level) && level == 3 &&
+                    detail::read_line(entry.path() / "shared_cpu_list", line) &&
+                    detail::parse_cpu_list(line, shared) && !shared.empty()) {
+                    l3_key = *std::min_element(shared.begin(), shared.end());
+                }
+            }
+            cpu.l3 = detail::dense_index(l3_ids, l3_key);
+
+            const auto numa = numa_of.find(id);
+            cpu.numa = detail::dense_index(numa_ids, numa == numa_of.end() ? 0u : numa->second);
+            topology.cpus.push_back(cpu);
+        }
+
+        topology.packages = static_cast<unsigned>(package_ids.size());
+        topology.cores = static_cast<unsigned>(core_ids.size());
+        topology.l3_domains = static_cast<unsigned>(l3_ids.size());
+        topology.numa_nodes = static_cast<unsigned>(numa_ids.size());
+        return topology;
+    } catch (const std::bad_alloc&) {
+        return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+    } catch (...) {
+        return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+}
+
+} // namespace dspai::comp
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <dspai/comp/clock.hpp>
+#include <dspai/comp/executor.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace dspai::comp {
+
+/**
+ * Watchdog configuration
+ *
+ */
+struct WatchdogConfig {
+    std::chrono::nanoseconds budget = std::chrono::milliseconds(10); ///< Default per-step budget
+    std::chrono::nanoseconds period = std::chrono::milliseconds(1);  ///< Poll interval of start()
+    bool migrate = true; ///< Move the stalled worker's other nodes to healthy workers
+    std::string dump_path; ///< Dump the executor's FlightRecorder here on each stall (empty = no dump)
+};
+
+/**
+ * A step that overran its budget
+ *
+ */
+struct StallReport {
+    NodeId node = 0;                   ///< Offending node
+    std::string_view name;             ///< NodeOptions::name of the node
+    std::size_t worker = 0;            ///< Worker stuck in the step
+    std::chrono::nanoseconds elapsed{}; ///< Time in the step when detected
+    std::size_t migrated = 0;          ///< Other nodes moved off the worker
+};
+
+/**
+ * Detects components stuck or overrunning inside execute() on a ThreadedExecutor
+ *
+ * Polls each worker's in-flight step (ThreadedExecutor::activity()); a step running longer
+ * than its node's budget is reported once through the callback, and, if configured, every
+ * other node owned by that worker is migrated to the least-loaded healthy worker so they
+ * keep running while the offending node holds its thread. The offending node itself cannot
+ * be preempted and stays on its worker.
+ * - Overhead on the workers is the executor's per-step bookkeeping; all checks run here.
+ * - check() performs one poll and can be called directly instead of start().
+ * - If the executor has a FlightRecorder, each stall is recorded as a Stall event and the
+ *   recorder is dumped to dump_path, capturing what led up to the stall.
+ *
+ * Thread Safety: start()/stop()/set_budget() from one control thread; set budgets before
+ * start(). check() must not run concurrently with the polling thread. Stop the watchdog
+ * before restarting the executor. The callback runs on the polling thread.
+ */
+class Watchdog {
+public:
+    using Callback = std::function<void(const StallReport&)>;
+
+    Watchdog(ThreadedExecutor& executor, WatchdogConfig config = {}, Callback on_stall = {}) noexcept
+        : executor_(&executor), config_(std::move(config)), on_stall_(std::move(on_stall)) {}
+    Watchdog(const Watchdog&) = delete;
+    Watchdog& operator=(const Watchdog&) = delete;
+    ~Watchdog() noexcept { stop(); }
+
+    /**
+     * @brief Override the step budget of one node
+     *
+     * @return std::error_code - empty on success, invalid_argument if id is out of range,
+     *         not_enough_memory
+     */
+    std::error_code set_budget(NodeId id, std::chrono::nanoseconds budget) noexcept {
+        if (id >= executor_->graph().size()) {
+            return std::make_error_code(std::errc::invalid_argument);
+        }
+        if (auto ec = prepare()) {
+            return ec;
+        }
+        budgets_[id] = TickClock::to_ticks(budget);
+        return {};
+    }
+
+    /**
+     * @brief Start the polling thread
+     *
+     * @return std::error_code - empty on success
+     *         - operation_not_permitted if already started
+     *         - not_enough_memory / resource_unavailable_try_again
+     */
+    std::error_code start() noexcept {
+        if (thread_.joinable()) {
+            return std::make_error_code(std::errc::operation_not_permitted);
+        }
+        if (auto ec = prepare()) {
+            return ec;
+        }
+        stop_ = false;
+        try {
+            thread_ = std::thread([this] { loop(); });
+        } catch (...) {
+            return std::make_error_code(std::errc::resource_unavailable_try_again);
+        }
+        return {};
+    }
+
+    /// Stop the polling thread. Idempotent.
+    void stop() noexcept {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_one();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    /**
+     * @brief Poll every worker once
+     *
+     * @return number of new stalls detected
+     */
+    std::size_t check() noexcept {
+        if (prepare() || !executor_->running()) {
+            return 0;
+        }
+        const auto now = TickClock::now();
+        const auto workers = executor_->workers();
+
+        // Flag every stalled worker first so evacuation never targets one
+        for (std::size_t w = 0; w < workers; ++w) {
+            activity_[w] = executor_->activity(w);
+            const auto& activity = activity_[w];
+            stalled_[w] = activity.busy && now > activity.started &&
+                          now - activity.started > budgets_[activity.node];
+        }
+
+        std::size_t detected = 0;
+        for (std::size_t w = 0; w < workers; ++w) {
+            const auto& activity = activity_[w];
+            if (!stalled_[w] || reported_[w] == activity.started) {
+                continue; // Healthy, or this step was already reported
+            }
+            reported_[w] = activity.started;
+            detected++;
+            stalls_.fetch_add(1, std::memory_order_relaxed);
+
+            StallReport report;
+            report.node = activity.node;
+            report.name = executor_->graph().options(activity.node).name;
+            report.worker = w;
+            report.elapsed = TickClock::to_duration(now - activity.started);
+            if (config_.migrate) {
+                report.migrated = evacuate(w, activity.node);
+            }
+            if (auto* recorder = executor_->recorder()) {
+                recorder->record(EventType::Stall, static_cast<std::uint32_t>(activity.node),
+                                 static_cast<std::uint64_t>(report.elapsed.count()));
+                if (!config_.dump_path.empty()) {
+                    recorder->dump(config_.dump_path.c_str());
+                }
+            }
+            if (on_stall_) {
+                on_stall_(report);
+            }
+        }
+        return detected;
+    }
+
+    /// Total stalls detected
+    std::uint64_t stalls() const noexcept { return stalls_.load(std::memory_order_relaxed); }
+
+private:
+    // Size the per-node/per-worker tables for the executor's current configuration
+    std::error_code prepare() noexcept {
+        const auto nodes = executor_->graph().size();
+        const auto workers = executor_->workers();
+        try {
+            if (budgets_.size() != nodes) {
+                budgets_.assign(nodes, TickClock::to_ticks(config_.budget));
+            }
+            if (reported_.size() != workers) {
+                reported_.assign(workers, 0);
+                stalled_.assign(workers, false);
+                activity_.assign(workers, WorkerActivity{});
+            }
+        } catch (...) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        return {};
+    }
+
+    // Move every unfinished node except `stuck` off `worker`; returns the number moved
+    std::size_t evacuate(std::size_t worker, NodeId stuck) noexcept {
+        const auto workers = executor_->workers();
+        const auto nodes = executor_->graph().size();
+        std::size_t moved = 0;
+        for (NodeId id = 0; id < nodes; ++id) {
+            if (id == stuck || executor_->owner(id) != worker || executor_->node_finished(id)) {
+                continue;
+            }
+            // Least-loaded healthy worker
+            std::size_t target = workers;
+            std::size_t target_load = ~std::size_t{0};
+            for (std::size_t w = 0; w < workers; ++w) {
+                if (w == worker || stalled_[w]) {
+                    continue;
+                }
+                std::size_t load = 0;
+                for (NodeId other = 0; other < nodes; ++other) {
+                    load += executor_->owner(other) == w && !executor_->node_finished(other);
+                }
+                if (load < target_load) {
+                    target = w;
+                    target_load = load;
+                }
+            }
+            if (target == workers) {
+                break; // No healthy worker
+            }
+            executor_->migrate(id, target);
+            moved++;
+        }
+        return moved;
+    }
+
+    void loop() noexcept {
+        std::unique_lock lock(mutex_);
+        while (!stop_) {
+            lock.unlock();
+            check();
+            lock.lock();
+            cv_.wait_for(lock, config_.period, [this] { return stop_; });
+        }
+    }
+
+    ThreadedExecutor* executor_;
+    WatchdogConfig config_;
+    Callback on_stall_;
+    std::vector<std::uint64_t> budgets_;
+    std::vector<std::uint64_t> reported_;
+    std::vector<bool> stalled_;
+    std::vector<WorkerActivity> activity_;
+    std::atomic<std::uint64_t> stalls_{0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool stop_ = false;
+};
+
+} // namespace dspai::comp
@@ -0,0 +1,221 @@
+#include <dspai/comp/async_init.hpp>
+#include <dspai/comp/component.hpp>
+#include "test_macros.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace dspai::comp;
+using namespace std::chrono_literals;
+
+// Component with a slow, optionally failing initialize()
+class SlowInitComponent : public Component {
+public:
+    explicit SlowInitComponent(std::chrono::milliseconds init_time = 0ms, bool fail = false)
+        : init_time_(init_time), fail_(fail) {}
+
+    std::thread::id init_thread() const { return init_thread_; }
+    const std::vector<float>& table() const { return table_; }
+    void set_fail(bool fail) { fail_ = fail; }
+
+protected:
+    std::error_code doInitialize() noexcept override {
+        std::this_thread::sleep_for(init_time_);
+        init_thread_ = std::this_thread::get_id();
+        if (fail_) {
+            return std::make_error_code(std::errc::io_error);
+        }
+        table_.assign(1024, 1.0f); // Written on the init thread, read by the owner
+        return {};
+    }
+    void doTerminate() noexcept override { table_.clear(); }
+    void doReset() noexcept override {}
+    bool doExecute() noexcept override { return table_.size() != 1024; }
+
+private:
+    std::chrono::milliseconds init_time_;
+    bool fail_;
+    std::thread::id init_thread_;
+    std::vector<float> table_;
+};
+
+// Test eager mode behaves like a direct initialize()
+TEST(eager_init) {
+    SlowInitComponent component;
+    AsyncInit wrapper(component, InitMode::Eager);
+    ASSERT_FALSE(wrapper.ready().valid());
+    ASSERT_FALSE(wrapper.initialize());
+    ASSERT_EQ_ENUM(LifecycleState::Initialized, wrapper.lifecycle_state());
+    ASSERT_TRUE(wrapper.ready().valid());
+    ASSERT_FALSE(wrapper.ready().get());
+    ASSERT_TRUE(wrapper.initialize() == std::errc::operation_not_permitted);
+    ASSERT_EQ(std::this_thread::get_id(), component.init_thread());
+}
+
+// Test async mode: graph streams while a slow component initializes
+TEST(async_init_overlaps_streaming) {
+    ThreadPool pool;
+    ASSERT_FALSE(pool.start(1));
+
+    SlowInitComponent fast;
+    SlowInitComponent slow(50ms);
+    AsyncInit fast_node(fast, InitMode::Eager);
+    AsyncInit slow_node(slow, InitMode::Async, &pool);
+    ASSERT_FALSE(fast_node.initialize());
+    ASSERT_FALSE(slow_node.initialize());
+
+    // The slow node is pending and behaves as Uninitialized
+    ASSERT_TRUE(slow_node.pending());
+    ASSERT_EQ_ENUM(LifecycleState::Uninitialized, slow_node.lifecycle_state());
+    ASSERT_FALSE(slow_node.execute());
+    ASSERT_EQ(0u, slow_node.count());
+    ASSERT_TRUE(slow_node.initialize() == std::errc::operation_not_permitted);
+
+    // Fast node processes meanwhile
+    int fast_steps = 0;
+    while (slow_node.lifecycle_state() != LifecycleState::Initialized) {
+        fast_node.execute();
+        fast_node.reset();
+        fast_steps++;
+        std::this_thread::sleep_for(1ms);
+    }
+    ASSERT_TRUE(fast_steps > 0);
+
+    ASSERT_FALSE(slow_node.ready().get());
+    ASSERT_TRUE(slow.init_thread() != std::this_thread::get_id());
+    ASSERT_EQ(1024u, slow.table().size());
+    ASSERT_FALSE(slow_node.execute());
+    ASSERT_EQ(1u, slow_node.count());
+}
+
+// Test failed async initialization can be retried
+TEST(async_init_failure) {
+    ThreadPool pool;
+    pool.start(1);
+
+    SlowInitComponent component(1ms, true);
+    AsyncInit wrapper(component, InitMode::Async, &pool);
+    ASSERT_FALSE(wrapper.initialize());
+    ASSERT_TRUE(wrapper.ready().get() == std::errc::io_error);
+    ASSERT_EQ_ENUM(LifecycleState::Uninitialized, wrapper.lifecycle_state());
+    ASSERT_FALSE(wrapper.pending());
+
+    component.set_fail(false);
+    ASSERT_FALSE(wrapper.initialize());
+    ASSERT_FALSE(wrapper.ready().get());
+    ASSERT_EQ_ENUM(LifecycleState::Initialized, wrapper.lifecycle_state());
+}
+
+// Test async mode argument checks
+TEST(async_init_requires_pool) {
+    SlowInitComponent component;
+    AsyncInit no_pool(component, InitMode::Async);
+    ASSERT_TRUE(no_pool.initialize() == std::errc::invalid_argument);
+
+    ThreadPool stopped;
+    AsyncInit not_running(component, InitMode::Async, &stopped);
+    ASSERT_TRUE(not_running.initialize() == std::errc::operation_not_permitted);
+    ASSERT_EQ_ENUM(LifecycleState::Uninitialized, not_running.lifecycle_state());
+}
+
+// Test lazy mode initializes inline on first execute()
+TEST(lazy_init_inline) {
+    SlowInitComponent component;
+    AsyncInit wrapper(component, InitMode::Lazy);
+    ASSERT_FALSE(wrapper.initialize());
+    ASSERT_TRUE(wrapper.pending());
+    ASSERT_EQ_ENUM(LifecycleState::Uninitialized, wrapper.lifecycle_state());
+    ASSERT_EQ(0u, component.table().size());
+
+    ASSERT_FALSE(wrapper.execute()); // Initializes, then runs the first step
+    ASSERT_EQ_ENUM(LifecycleState::Initialized, wrapper.lifecycle_state());
+    ASSERT_EQ(1u, wrapper.count());
+    ASSERT_FALSE(wrapper.ready().get());
+}
+
+// Test lazy mode with a pool: first execute() starts background initialization
+TEST(lazy_init_on_pool) {
+    ThreadPool pool;
+    pool.start(1);
+
+    SlowInitComponent component(5ms);
+    AsyncInit wrapper(component, InitMode::Lazy, &pool);
+    ASSERT_FALSE(wrapper.initialize());
+    ASSERT_FALSE(wrapper.execute());
+    ASSERT_EQ(0u, wrapper.count());
+
+    std::array<AsyncInit*, 1> critical{&wrapper};
+    ASSERT_FALSE(wait_ready(critical));
+    ASSERT_EQ_ENUM(LifecycleState::Initialized, wrapper.lifecycle_state());
+    wrapper.execute();
+    ASSERT_EQ(1u, wrapper.count());
+}
+
+// Test wait_ready() reports the first failure and skips deferred components
+TEST(wait_ready_critical_path) {
+    ThreadPool pool;
+    pool.start(2);
+
+    SlowInitComponent a(5ms);
+    SlowInitComponent b(5ms, true);
+    SlowInitComponent c;
+    AsyncInit na(a, InitMode::Async, &pool);
+    AsyncInit nb(b, InitMode::Async, &pool);
+    AsyncInit nc(c, InitMode::Lazy);
+    na.initialize();
+    nb.initialize();
+    nc.initialize();
+
+    std::array<AsyncInit*, 3> nodes{&na, &nb, &nc};
+    ASSERT_TRUE(wait_ready(nodes) == std::errc::io_error);
+    ASSERT_EQ_ENUM(LifecycleState::Initialized, na.lifecycle_state());
+    ASSERT_TRUE(nc.pending());
+}
+
+// Test terminate() while initialization is pending or deferred
+TEST(terminate_pending) {
+    ThreadPool pool;
+    pool.start(1);
+
+    SlowInitComponent component(10ms);
+    AsyncInit wrapper(component, InitMode::Async, &pool);
+    wrapper.initialize();
+    wrapper.terminate(); // Waits for the pending initialize()
+    ASSERT_EQ_ENUM(LifecycleState::Terminated, wrapper.lifecycle_state());
+    ASSERT_EQ_ENUM(LifecycleState::Terminated, component.lifecycle_state());
+    ASSERT_EQ_ENUM(ExecutionState::Done, wrapper.execution_state());
+    ASSERT_FALSE(wrapper.execute());
+
+    SlowInitComponent lazy_component;
+    AsyncInit lazy(lazy_component, InitMode::Lazy);
+    lazy.initialize();
+    lazy.terminate();
+    ASSERT_TRUE(lazy.ready().get() == std::errc::operation_canceled);
+    ASSERT_EQ_ENUM(LifecycleState::Terminated, lazy.lifecycle_state());
+}
+
+// Test destroying a wrapper with initialization still in flight
+TEST(destroy_pending) {
+    ThreadPool pool;
+    pool.start(1);
+
+    SlowInitComponent component(5ms);
+    {
+        AsyncInit wrapper(component, InitMode::Async, &pool);
+        wrapper.initialize();
+    }
+    ASSERT_EQ_ENUM(LifecycleState::Initialized, component.lifecycle_state());
+}
+
+int main() {
+    std::cout << "Running Async Init Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
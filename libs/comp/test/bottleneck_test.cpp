@@ -0,0 +1,130 @@
+#include <dspai/comp/bottleneck.hpp>
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/executor.hpp>
+#include "test_macros.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+
+using namespace dspai::comp;
+
+// Item count standing in for a ring between two stages
+struct Queue {
+    std::atomic<std::size_t> depth{0};
+    std::size_t capacity = 64;
+};
+
+// Moves up to `burst` items per step from in (nullptr: unlimited source) to out (nullptr:
+// sink), spending `work` per item
+class Stage : public Component {
+public:
+    Stage(Queue* in, Queue* out, std::size_t burst, std::chrono::nanoseconds work)
+        : in_(in), out_(out), burst_(burst), work_(work) {}
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override {}
+    bool doExecute() noexcept override {
+        for (std::size_t i = 0; i < burst_; ++i) {
+            if ((in_ && in_->depth.load() == 0) || (out_ && out_->depth.load() >= out_->capacity)) {
+                break;
+            }
+            const auto until = std::chrono::steady_clock::now() + work_;
+            while (std::chrono::steady_clock::now() < until) {
+            }
+            if (in_) {
+                in_->depth.fetch_sub(1);
+            }
+            if (out_) {
+                out_->depth.fetch_add(1);
+            }
+        }
+        return false;
+    }
+
+private:
+    Queue* in_;
+    Queue* out_;
+    std::size_t burst_;
+    std::chrono::nanoseconds work_;
+};
+
+static NodeOptions probe(const char* name, Queue* queue) {
+    NodeOptions options;
+    options.name = name;
+    if (queue) {
+        options.backlog = [queue] { return queue->depth.load(); };
+        options.backlog_capacity = queue->capacity;
+    }
+    return options;
+}
+
+// Test the slow middle stage of a pipeline is found critical, with upstream blocked and
+// downstream starved
+TEST(bottleneck_pipeline) {
+    Queue a;
+    Queue b;
+    Stage source(nullptr, &a, 4, std::chrono::nanoseconds(0));
+    Stage filter(&a, &b, 1, std::chrono::microseconds(20));
+    Stage sink(&b, nullptr, 4, std::chrono::nanoseconds(0));
+    source.initialize();
+    filter.initialize();
+    sink.initialize();
+
+    Graph graph;
+    graph.add(source, probe("source", nullptr));
+    graph.add(filter, probe("filter", &a));
+    graph.add(sink, probe("sink", &b));
+    graph.connect(0, 1);
+    graph.connect(1, 2);
+    graph.build();
+
+    ThreadedExecutor executor(graph);
+    BottleneckAnalyzer analyzer(executor);
+    ASSERT_EQ(analyzer.sample(), std::make_error_code(std::errc::operation_not_permitted));
+    ASSERT_FALSE(executor.start(1));
+    ASSERT_EQ(analyzer.analyze().error(), std::make_error_code(std::errc::resource_unavailable_try_again));
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_FALSE(analyzer.sample());
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    auto report = analyzer.analyze();
+    executor.stop();
+    ASSERT_TRUE(report.has_value());
+    ASSERT_EQ(report->samples, 50u);
+    ASSERT_EQ(report->stages.size(), 3u);
+
+    const auto& up = report->stages[0];
+    const auto& mid = report->stages[1];
+    const auto& down = report->stages[2];
+    ASSERT_EQ(report->critical, 1u);
+    ASSERT_TRUE(mid.limiting);
+    ASSERT_FALSE(down.limiting);
+    ASSERT_TRUE(up.blocked > 0.8);
+    ASSERT_TRUE(mid.fill > 0.8);
+    ASSERT_TRUE(down.starved > 0.5);
+    ASSERT_TRUE(mid.utilization > up.utilization);
+    ASSERT_TRUE(mid.speedup > 1.3);
+    ASSERT_TRUE(down.speedup < 1.1);
+
+    const auto text = format_bottleneck_report(*report, graph);
+    ASSERT_TRUE(text.find("* filter") != std::string::npos);
+    ASSERT_TRUE(text.find("samples") != std::string::npos);
+
+    analyzer.restart();
+    ASSERT_EQ(analyzer.samples(), 0u);
+}
+
+int main() {
+    std::cout << "Running Bottleneck Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <dspai/comp/broadcast_ring.hpp>
+#include "test_macros.hpp"
+#include <array>
+#include <thread>
+#include <vector>
+
+using namespace dspai::comp;
+
+// Test every consumer sees every element
+TEST(broadcast_basics) {
+    BroadcastRing<int> ring;
+    ASSERT_TRUE(ring.allocate(0, 1) == std::errc::invalid_argument);
+    ASSERT_FALSE(ring.allocate(8, 2));
+    ASSERT_EQ(8u, ring.capacity());
+
+    auto a = ring.attach();
+    auto b = ring.attach();
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+    ASSERT_FALSE(ring.attach().has_value()); // No free slots
+
+    std::array<int, 5> values{1, 2, 3, 4, 5};
+    ASSERT_EQ(5u, ring.write(values));
+    ASSERT_EQ(5u, ring.size(*a));
+    ASSERT_EQ(5u, ring.size(*b));
+
+    // Zero-copy read by one consumer does not affect the other
+    auto region = ring.readable(*a);
+    ASSERT_EQ(5u, region.size());
+    ASSERT_EQ(1, region[0]);
+    ASSERT_TRUE(ring.consume(*a, 5));
+    ASSERT_EQ(0u, ring.size(*a));
+    ASSERT_EQ(5u, ring.size(*b));
+}
+
+// Test the slowest throttling consumer bounds the producer
+TEST(broadcast_throttle) {
+    BroadcastRing<int> ring;
+    ring.allocate(4, 2);
+    auto fast = *ring.attach();
+    auto slow = *ring.attach();
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_push(i));
+    }
+    std::array<int, 4> out{};
+    ASSERT_EQ(4u, ring.read(fast, out));
+    ASSERT_FALSE(ring.try_push(4)); // slow still holds all slots
+
+    ASSERT_EQ(2u, ring.read(slow, std::span<int>(out.data(), 2)));
+    ASSERT_TRUE(ring.try_push(4));
+    ASSERT_TRUE(ring.try_push(5));
+    ASSERT_FALSE(ring.try_push(6));
+
+    // Detached consumers no longer throttle
+    ring.detach(slow);
+    ASSERT_TRUE(ring.try_push(6));
+    ASSERT_EQ(3u, ring.read(fast, out));
+    ASSERT_EQ(6, out[2]);
+}
+
+// Test lossy consumers never block the producer
+TEST(broadcast_lossy) {
+    BroadcastRing<int> ring;
+    ring.allocate(4, 2);
+    auto tap = *ring.attach(BroadcastPolicy::Lossy);
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(ring.try_push(i));
+    }
+    std::array<int, 8> out{};
+    const auto n = ring.read(tap, out);
+    ASSERT_TRUE(n >= 3 && n <= 4);
+    ASSERT_EQ(9, out[n - 1]);
+    ASSERT_EQ(10u - n, ring.dropped(tap));
+
+    // A throttling consumer attached alongside keeps its guarantee
+    ASSERT_TRUE(ring.attach().has_value());
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_push(i));
+    }
+    ASSERT_FALSE(ring.try_push(4));
+}
+
+// Test fan-out to several consumer threads
+TEST(broadcast_threads) {
+    constexpr std::size_t consumers = 4;
+    constexpr std::uint64_t count = 50000;
+    BroadcastRing<std::uint64_t> ring;
+    ring.allocate(256, consumers);
+    std::vector<std::size_t> ids;
+    for (std::size_t c = 0; c < consumers; ++c) {
+        ids.push_back(*ring.attach());
+    }
+
+    std::vector<std::uint64_t> sums(consumers, 0);
+    std::vector<char> ordered(consumers, 1);
+    std::vector<std::thread> threads;
+    for (std::size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            std::uint64_t expected = 0;
+            std::array<std::uint64_t, 64> block{};
+            while (expected < count) {
+                const auto n = ring.read(ids[c], block);
+                for (std::size_t i = 0; i < n; ++i) {
+                    ordered[c] = ordered[c] && block[i] == expected;
+                    sums[c] += block[i];
+                    ++expected;
+                }
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (std::uint64_t i = 0; i < count;) {
+        if (ring.try_push(i)) {
+            ++i;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (std::size_t c = 0; c < consumers; ++c) {
+        ASSERT_TRUE(ordered[c]);
+        ASSERT_EQ(count * (count - 1) / 2, sums[c]);
+    }
+}
+
+int main() {
+    std::cout << "Running Broadcast Ring Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
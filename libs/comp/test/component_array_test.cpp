@@ -0,0 +1,213 @@
+#include <dspai/comp/component_array.hpp>
+#include "test_macros.hpp"
+#include <array>
+
+using namespace dspai::comp;
+
+// Multi-lane test component: each lane accumulates its gain until it reaches its limit
+class TestArray : public ComponentArray<8> {
+public:
+    TestArray() {
+        for (std::size_t i = 0; i < lanes; ++i) {
+            gain_[i] = static_cast<float>(i + 1);
+            limit_[i] = static_cast<float>(3 * (i + 1)); // every lane finishes in 3 steps
+        }
+    }
+
+    float acc(std::size_t lane) const { return acc_[lane]; }
+    void set_limit(std::size_t lane, float limit) { limit_[lane] = limit; }
+    Mask last_reset() const { return last_reset_; }
+    Mask last_active() const { return last_active_; }
+    int execute_calls() const { return execute_calls_; }
+
+protected:
+    std::error_code doInitialize() noexcept override {
+        acc_.fill(0.0f);
+        return {};
+    }
+
+    void doTerminate() noexcept override {}
+
+    Mask doExecute(const Mask& active) noexcept override {
+        execute_calls_++;
+        last_active_ = active;
+        Mask done;
+        for (std::size_t i = 0; i < lanes; ++i) {
+            acc_[i] += active[i] ? gain_[i] : 0.0f;
+            done[i] = acc_[i] >= limit_[i];
+        }
+        return done;
+    }
+
+    void doReset(const Mask& lanes_to_reset) noexcept override {
+        last_reset_ = lanes_to_reset;
+        for (std::size_t i = 0; i < lanes; ++i) {
+            acc_[i] = lanes_to_reset[i] ? 0.0f : acc_[i];
+        }
+    }
+
+private:
+    std::array<float, lanes> gain_{};
+    std::array<float, lanes> limit_{};
+    std::array<float, lanes> acc_{};
+    Mask last_reset_{};
+    Mask last_active_{};
+    int execute_calls_ = 0;
+};
+
+// Test initial state
+TEST(initial_state) {
+    TestArray array;
+    ASSERT_EQ_ENUM(LifecycleState::Uninitialized, array.lifecycle_state());
+    ASSERT_EQ_ENUM(ExecutionState::Reset, array.execution_state());
+    ASSERT_EQ_ENUM(ExecutionState::Reset, array.execution_state(3));
+    ASSERT_EQ(0u, array.count());
+    ASSERT_FALSE(array.is_ready());
+    ASSERT_FALSE(array.execute());
+    ASSERT_EQ(0, array.execute_calls());
+}
+
+// Test all lanes processed by one execute()
+TEST(execute_all_lanes) {
+    TestArray array;
+    ASSERT_FALSE(array.initialize());
+    ASSERT_EQ_ENUM(ExecutionState::Reset, array.execution_state());
+    ASSERT_TRUE(array.is_ready());
+
+    ASSERT_FALSE(array.execute());
+    ASSERT_EQ(1, array.execute_calls());
+    ASSERT_TRUE(array.last_active().all());
+    ASSERT_EQ_ENUM(ExecutionState::Running, array.execution_state());
+    ASSERT_EQ(1u, array.count());
+    for (std::size_t i = 0; i < TestArray::lanes; ++i) {
+        ASSERT_EQ_ENUM(ExecutionState::Running, array.execution_state(i));
+        ASSERT_EQ(1u, array.count(i));
+        ASSERT_EQ(static_cast<float>(i + 1), array.acc(i));
+    }
+
+    ASSERT_FALSE(array.execute());
+    ASSERT_TRUE(array.execute());
+    ASSERT_EQ_ENUM(ExecutionState::Done, array.execution_state());
+    ASSERT_TRUE(array.done_lanes().all());
+    ASSERT_FALSE(array.is_ready());
+
+    // Execute when done - no-op
+    ASSERT_TRUE(array.execute());
+    ASSERT_EQ(3, array.execute_calls());
+    ASSERT_EQ(3u, array.count());
+}
+
+// Test lanes completing independently
+TEST(lanes_finish_independently) {
+    TestArray array;
+    array.set_limit(2, 1.0f);  // lane 2 finishes after one step
+    array.set_limit(5, 60.0f); // lane 5 finishes after ten steps
+    array.initialize();
+
+    array.execute();
+    ASSERT_EQ_ENUM(ExecutionState::Done, array.execution_state(2));
+    ASSERT_EQ_ENUM(ExecutionState::Running, array.execution_state(5));
+    ASSERT_TRUE(array.done_lanes()[2]);
+    ASSERT_FALSE(array.running_lanes()[2]);
+
+    // Done lanes are masked out of subsequent steps
+    array.execute();
+    ASSERT_FALSE(array.last_active()[2]);
+    ASSERT_EQ(3.0f, array.acc(2));
+    ASSERT_EQ(1u, array.count(2));
+
+    array.execute();
+    ASSERT_EQ_ENUM(ExecutionState::Running, array.execution_state());
+    ASSERT_EQ(1u, array.running_lanes().count());
+
+    bool done = false;
+    while (!done) {
+        done = array.execute();
+    }
+    ASSERT_EQ(10u, array.count());
+    ASSERT_EQ(10u, array.count(5));
+    ASSERT_EQ(3u, array.count(0));
+}
+
+// Test per-lane reset
+TEST(reset_single_lane) {
+    TestArray array;
+    array.initialize();
+
+    // Reset while all lanes are Reset is a no-op
+    array.reset_lane(1);
+    ASSERT_TRUE(array.last_reset().none());
+
+    array.execute();
+    array.reset_lane(1);
+    ASSERT_EQ(1u, array.last_reset().count());
+    ASSERT_TRUE(array.last_reset()[1]);
+    ASSERT_EQ_ENUM(ExecutionState::Reset, array.execution_state(1));
+    ASSERT_EQ(0u, array.count(1));
+    ASSERT_EQ(0.0f, array.acc(1));
+    ASSERT_EQ(1.0f, array.acc(0)); // Other lanes untouched
+    ASSERT_EQ_ENUM(ExecutionState::Running, array.execution_state());
+    ASSERT_EQ(1u, array.count());
+
+    // Out-of-range lanes are ignored
+    array.reset_lane(TestArray::lanes);
+    ASSERT_TRUE(array.last_reset()[1]);
+
+    // Reset lane rejoins on the next step
+    array.execute();
+    ASSERT_EQ_ENUM(ExecutionState::Running, array.execution_state(1));
+    ASSERT_EQ(1u, array.count(1));
+    ASSERT_EQ(2u, array.count(0));
+}
+
+// Test aggregate reset
+TEST(reset_all_lanes) {
+    TestArray array;
+    array.initialize();
+    while (!array.execute()) {
+    }
+
+    TestArray::Mask subset;
+    subset.set(0).set(7);
+    array.reset(subset);
+    ASSERT_EQ(subset, array.last_reset());
+    ASSERT_EQ_ENUM(ExecutionState::Running, array.execution_state());
+    ASSERT_EQ(3u, array.count());
+
+    array.reset();
+    ASSERT_EQ(6u, array.last_reset().count()); // Lanes 0 and 7 were already Reset
+    ASSERT_EQ_ENUM(ExecutionState::Reset, array.execution_state());
+    ASSERT_EQ(0u, array.count());
+    ASSERT_TRUE(array.reset_lanes().all());
+
+    // Resetting the remaining lanes individually also returns count() to zero
+    array.execute();
+    array.reset(array.running_lanes());
+    ASSERT_EQ(0u, array.count());
+}
+
+// Test terminate
+TEST(terminate_states) {
+    TestArray array;
+    array.initialize();
+    array.execute();
+    array.terminate();
+    ASSERT_EQ_ENUM(LifecycleState::Terminated, array.lifecycle_state());
+    ASSERT_EQ_ENUM(ExecutionState::Done, array.execution_state());
+    ASSERT_EQ_ENUM(ExecutionState::Done, array.execution_state(4));
+    ASSERT_EQ(0u, array.count());
+    ASSERT_EQ(0u, array.count(4));
+    ASSERT_FALSE(array.execute());
+    ASSERT_TRUE(array.initialize() == std::errc::operation_not_permitted);
+}
+
+int main() {
+    std::cout << "Running ComponentArray Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
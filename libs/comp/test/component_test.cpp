@@ -1,7 +1,11 @@
+#include <dspai/comp/clone.hpp>
 #include <dspai/comp/component.hpp>
-#include <iostream>
+#include <dspai/comp/conformance.hpp>
+#include "test_macros.hpp"
+#include <algorithm>
 #include <cassert>
 #include <string>
+#include <vector>
 
 using namespace dspai::comp;
 
@@ -55,49 +59,6 @@ private:
     int current_iteration_ = 0;
 };
 
-// Test helper macros
-#define TEST(name) void test_##name(); \
-    static struct test_##name##_runner { \
-        test_##name##_runner() { \
-            std::cout << "Running: " #name << "... "; \
-            test_##name(); \
-            std::cout << "PASSED\n"; \
-        } \
-    } test_##name##_instance; \
-    void test_##name()
-
-#define ASSERT_EQ_ENUM(expected, actual) \
-    if ((expected) != (actual)) { \
-        std::cerr << "\nAssertion failed: " << #expected << " != " << #actual \
-                  << "\n  Expected: " << static_cast<int>(expected) \
-                  << "\n  Actual: " << static_cast<int>(actual) \
-                  << "\n  At: " << __FILE__ << ":" << __LINE__ << "\n"; \
-        std::exit(1); \
-    }
-
-#define ASSERT_EQ(expected, actual) \
-    if ((expected) != (actual)) { \
-        std::cerr << "\nAssertion failed: " << #expected << " != " << #actual \
-                  << "\n  Expected: " << (expected) \
-                  << "\n  Actual: " << (actual) \
-                  << "\n  At: " << __FILE__ << ":" << __LINE__ << "\n"; \
-        std::exit(1); \
-    }
-
-#define ASSERT_TRUE(condition) \
-    if (!(condition)) { \
-        std::cerr << "\nAssertion failed: " << #condition \
-                  << " is false\n  At: " << __FILE__ << ":" << __LINE__ << "\n"; \
-        std::exit(1); \
-    }
-
-#define ASSERT_FALSE(condition) \
-    if (condition) { \
-        std::cerr << "\nAssertion failed: " << #condition \
-                  << " is true\n  At: " << __FILE__ << ":" << __LINE__ << "\n"; \
-        std::exit(1); \
-    }
-
 // Test initial state
 TEST(initial_state) {
     TestComponent component;
@@ -357,6 +318,207 @@ TEST(complete_lifecycle) {
     ASSERT_EQ_ENUM(ExecutionState::Done, component.execution_state());
 }
 
+// Test component with an expensive read-only artifact and cheap mutable state
+class FilterComponent : public Component {
+public:
+    explicit FilterComponent(std::size_t num_taps = 16) : num_taps_(num_taps) {}
+
+    const Shared<std::vector<float>>& taps() const { return taps_; }
+    const std::vector<float>& history() const { return history_; }
+    static int designs() { return designs_; }
+
+protected:
+    std::error_code doInitialize() noexcept override {
+        try {
+            auto taps = std::make_shared<std::vector<float>>(num_taps_, 1.0f / static_cast<float>(num_taps_));
+            history_.assign(num_taps_, 0.0f);
+            taps_ = std::move(taps);
+        } catch (...) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        designs_++;
+        return {};
+    }
+
+    std::error_code doClone(const Component& prototype) noexcept override {
+        const auto& other = static_cast<const FilterComponent&>(prototype);
+        try {
+            history_.assign(other.num_taps_, 0.0f);
+        } catch (...) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        num_taps_ = other.num_taps_;
+        taps_ = other.taps_;
+        return {};
+    }
+
+    void doTerminate() noexcept override { taps_.reset(); }
+    bool doExecute() noexcept override {
+        history_[0] += 1.0f;
+        return false;
+    }
+    void doReset() noexcept override { std::fill(history_.begin(), history_.end(), 0.0f); }
+
+private:
+    std::size_t num_taps_;
+    Shared<std::vector<float>> taps_;
+    std::vector<float> history_;
+    static inline int designs_ = 0;
+};
+
+// Test cloning an initialized prototype
+TEST(clone_shares_read_only_state) {
+    FilterComponent prototype(32);
+    ASSERT_FALSE(prototype.initialize());
+    prototype.execute();
+
+    auto result = clone(prototype);
+    ASSERT_TRUE(result.has_value());
+    auto& copy = **result;
+    ASSERT_EQ_ENUM(LifecycleState::Initialized, copy.lifecycle_state());
+    ASSERT_EQ_ENUM(ExecutionState::Reset, copy.execution_state());
+    ASSERT_EQ(0u, copy.count());
+    ASSERT_EQ(1, FilterComponent::designs()); // No redesign
+    ASSERT_TRUE(copy.taps() == prototype.taps()); // Shared by reference
+    ASSERT_EQ(32u, copy.history().size());
+    ASSERT_TRUE(copy.history().data() != prototype.history().data()); // Own mutable state
+    ASSERT_EQ(0.0f, copy.history()[0]);
+
+    // Clones run independently
+    copy.execute();
+    copy.execute();
+    ASSERT_EQ(2.0f, copy.history()[0]);
+    ASSERT_EQ(1.0f, prototype.history()[0]);
+
+    // Shared state outlives the prototype
+    prototype.terminate();
+    ASSERT_EQ(32u, copy.taps()->size());
+}
+
+// Test initialize_from() preconditions
+TEST(clone_preconditions) {
+    FilterComponent uninitialized;
+    auto r1 = clone(uninitialized);
+    ASSERT_FALSE(r1.has_value());
+    ASSERT_TRUE(r1.error() == std::errc::invalid_argument);
+
+    FilterComponent prototype;
+    prototype.initialize();
+
+    FilterComponent initialized;
+    initialized.initialize();
+    ASSERT_TRUE(initialized.initialize_from(prototype) == std::errc::operation_not_permitted);
+
+    // Different dynamic type
+    TestComponent other;
+    ASSERT_TRUE(other.initialize_from(prototype) == std::errc::invalid_argument);
+    ASSERT_EQ_ENUM(LifecycleState::Uninitialized, other.lifecycle_state());
+
+    // Cloning not supported by the derived class
+    TestComponent test_prototype;
+    test_prototype.initialize();
+    auto r2 = clone(test_prototype);
+    ASSERT_FALSE(r2.has_value());
+    ASSERT_TRUE(r2.error() == std::errc::operation_not_supported);
+}
+
+// Test component with a large buffer and synthetic-input dry runs
+class WarmComponent : public Component {
+public:
+    explicit WarmComponent(bool dry_run) : dry_run_(dry_run) {}
+
+    int prefaults = 0;
+    int real_steps = 0;
+    int synthetic_steps = 0;
+    float output = 0.0f;
+
+protected:
+    std::error_code doInitialize() noexcept override {
+        try {
+            buffer_.resize(1 << 20);
+        } catch (...) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        return {};
+    }
+    void doTerminate() noexcept override { buffer_.clear(); }
+    void doPrefault() noexcept override {
+        prefault(std::span<float>(buffer_));
+        prefaults++;
+    }
+    bool doWarmup() noexcept override {
+        synthetic_ = true;
+        return dry_run_;
+    }
+    bool doExecute() noexcept override {
+        (synthetic_ ? synthetic_steps : real_steps)++;
+        output += 1.0f;
+        return false;
+    }
+    void doReset() noexcept override {
+        synthetic_ = false;
+        output = 0.0f;
+    }
+
+private:
+    bool dry_run_;
+    bool synthetic_ = false;
+    std::vector<float> buffer_;
+};
+
+// Test warm_up() pre-faults, dry-runs and leaves the component in Reset
+TEST(warm_up) {
+    WarmComponent component(true);
+    ASSERT_TRUE(component.warm_up() == std::errc::operation_not_permitted); // Not initialized
+    component.initialize();
+
+    WarmupOptions options;
+    options.dry_run_steps = 5;
+    ASSERT_FALSE(component.warm_up(options));
+    ASSERT_EQ(1, component.prefaults);
+    ASSERT_EQ(5, component.synthetic_steps);
+    ASSERT_EQ_ENUM(ExecutionState::Reset, component.execution_state());
+    ASSERT_EQ(0u, component.count());
+    ASSERT_EQ(0.0f, component.output);
+
+    // First real call sees clean state
+    component.execute();
+    ASSERT_EQ(1, component.real_steps);
+    ASSERT_EQ(1.0f, component.output);
+
+    // Not allowed once running
+    ASSERT_TRUE(component.warm_up() == std::errc::operation_not_permitted);
+}
+
+// Test warm_up() without dry-run support or with options disabled
+TEST(warm_up_options) {
+    WarmComponent component(false);
+    component.initialize();
+    ASSERT_FALSE(component.warm_up());
+    ASSERT_EQ(1, component.prefaults);
+    ASSERT_EQ(0, component.synthetic_steps);
+    ASSERT_EQ(0, component.real_steps);
+
+    WarmupOptions none;
+    none.prefault = false;
+    none.dry_run_steps = 0;
+    ASSERT_FALSE(component.warm_up(none));
+    ASSERT_EQ(1, component.prefaults);
+    ASSERT_EQ_ENUM(ExecutionState::Reset, component.execution_state());
+}
+
+// Test the component passes the reusable conformance kit
+TEST(conformance_kit) {
+    ConformanceHooks<TestComponent> hooks;
+    hooks.digest = [](TestComponent& c) { return static_cast<std::uint64_t>(c.current_iteration()); };
+    auto result = check_component(hooks);
+    if (!result.passed()) {
+        std::cerr << result.summary();
+    }
+    ASSERT_TRUE(result.passed());
+    ASSERT_FALSE(result.allocations_checked); // No DSPAI_COMP_COUNT_ALLOCATIONS() here
+}
+
 int main() {
     std::cout << "Running Component Interface Tests\n";
     std::cout << "==================================\n";
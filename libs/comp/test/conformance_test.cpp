@@ -0,0 +1,164 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/conformance.hpp>
+#include "test_macros.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace dspai::comp;
+
+DSPAI_COMP_COUNT_ALLOCATIONS();
+
+// Accumulator with configurable contract violations
+class Accumulator : public Component {
+public:
+    struct Faults {
+        bool allocate_in_execute = false;
+        bool forget_reset = false;
+        bool forget_reset_running = false; ///< reset() only works after Done
+        bool fail_at_end = false;
+        std::chrono::nanoseconds work{0};
+    };
+
+    Accumulator() = default;
+    explicit Accumulator(Faults faults) : faults_(faults) {}
+
+    void set_input(std::uint64_t seed) { seed_ = seed; }
+    std::uint64_t sum() const { return sum_; }
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override {
+        if (faults_.forget_reset_running && step_ < 40) {
+            return;
+        }
+        if (!faults_.forget_reset) {
+            sum_ = 0;
+        }
+        step_ = 0;
+    }
+    bool doExecute() noexcept override {
+        if (faults_.allocate_in_execute) {
+            history_.push_back(sum_);
+        }
+        if (faults_.work.count() > 0) {
+            const auto until = std::chrono::steady_clock::now() + faults_.work;
+            while (std::chrono::steady_clock::now() < until) {
+            }
+        }
+        sum_ = sum_ * 31 + seed_ + step_;
+        if (++step_ < 40) {
+            return false;
+        }
+        if (faults_.fail_at_end) {
+            fail(std::make_error_code(std::errc::io_error));
+        }
+        return true;
+    }
+
+private:
+    Faults faults_;
+    std::uint64_t seed_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t step_ = 0;
+    std::vector<std::uint64_t> history_;
+};
+
+static ConformanceHooks<Accumulator> hooks(Accumulator::Faults faults) {
+    ConformanceHooks<Accumulator> result;
+    result.make = [faults] { return std::make_unique<Accumulator>(faults); };
+    result.prepare = [](Accumulator& c) { c.set_input(7); };
+    result.digest = [](Accumulator& c) { return c.sum(); };
+    return result;
+}
+
+static bool has_failure(const ConformanceResult& result, const std::string& text) {
+    for (const auto& failure : result.failures) {
+        if (failure.find(text) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Test a conforming component passes every check
+TEST(conformance_pass) {
+    ConformanceOptions options;
+    options.step_budget = std::chrono::milliseconds(50);
+    auto result = check_component(hooks({}), options);
+    if (!result.passed()) {
+        std::cerr << result.summary();
+    }
+    ASSERT_TRUE(result.passed());
+    ASSERT_TRUE(result.allocations_checked);
+    ASSERT_EQ(result.allocations, 0u);
+    ASSERT_EQ(result.steps, 4u * 40u);
+    ASSERT_TRUE(result.summary().find("PASS") == 0);
+
+    // Default-constructible components need no hooks; a latched error is a valid ending
+    ASSERT_TRUE(check_component<Accumulator>().passed());
+    ASSERT_TRUE(check_component(hooks({.allocate_in_execute = false, .forget_reset = false,
+                                       .forget_reset_running = false, .fail_at_end = true, .work = {}}))
+                    .passed());
+}
+
+// Test contract violations are each reported
+TEST(conformance_violations) {
+    auto allocating = check_component(hooks({.allocate_in_execute = true, .forget_reset = false,
+                                             .forget_reset_running = false, .fail_at_end = false, .work = {}}));
+    ASSERT_FALSE(allocating.passed());
+    ASSERT_TRUE(allocating.allocations > 0);
+    ASSERT_TRUE(has_failure(allocating, "allocated"));
+
+    auto sticky = check_component(hooks({.allocate_in_execute = false, .forget_reset = true,
+                                         .forget_reset_running = false, .fail_at_end = false, .work = {}}));
+    ASSERT_FALSE(sticky.passed());
+    ASSERT_TRUE(has_failure(sticky, "output differs"));
+
+    auto interrupted = check_component(hooks({.allocate_in_execute = false, .forget_reset = false,
+                                              .forget_reset_running = true, .fail_at_end = false, .work = {}}));
+    ASSERT_FALSE(interrupted.passed());
+    ASSERT_TRUE(has_failure(interrupted, "reset() while Running"));
+
+    ConformanceOptions options;
+    options.step_budget = std::chrono::microseconds(5);
+    options.latency_runs = 1;
+    auto slow = check_component(hooks({.allocate_in_execute = false, .forget_reset = false,
+                                       .forget_reset_running = false, .fail_at_end = false,
+                                       .work = std::chrono::microseconds(50)}),
+                                options);
+    ASSERT_FALSE(slow.passed());
+    ASSERT_TRUE(has_failure(slow, "exceeds budget"));
+    ASSERT_TRUE(slow.p50 >= std::chrono::microseconds(40));
+
+    // The percentile is exact: a budget between the step time and the next power of two passes
+    options.step_budget = std::chrono::microseconds(62);
+    options.budget_percentile = 50;
+    auto exact = check_component(hooks({.allocate_in_execute = false, .forget_reset = false,
+                                        .forget_reset_running = false, .fail_at_end = false,
+                                        .work = std::chrono::microseconds(50)}),
+                                 options);
+    ASSERT_FALSE(has_failure(exact, "exceeds budget"));
+    ASSERT_TRUE(exact.p50 >= std::chrono::microseconds(50));
+    ASSERT_TRUE(exact.p50 < std::chrono::microseconds(62));
+
+    ConformanceHooks<Accumulator> broken;
+    broken.make = [] { return std::unique_ptr<Accumulator>(); };
+    auto aborted = check_component(broken);
+    ASSERT_TRUE(aborted.aborted);
+    ASSERT_TRUE(aborted.summary().find("ABORTED") != std::string::npos);
+}
+
+int main() {
+    std::cout << "Running Conformance Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include <dspai/comp/component.hpp>
+#include "test_macros.hpp"
+#include <chrono>
+#include <thread>
+
+using namespace dspai::comp;
+using namespace std::chrono_literals;
+
+// Component that completes after a fixed number of steps, optionally sleeping per step
+class SteppingComponent : public Component {
+public:
+    explicit SteppingComponent(int steps, std::chrono::microseconds step_time = 0us)
+        : steps_(steps), step_time_(step_time) {}
+    int executed() const { return executed_; }
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override { executed_ = 0; }
+    bool doExecute() noexcept override {
+        if (step_time_.count() > 0) {
+            std::this_thread::sleep_for(step_time_);
+        }
+        return ++executed_ >= steps_;
+    }
+
+private:
+    int steps_;
+    std::chrono::microseconds step_time_;
+    int executed_ = 0;
+};
+
+// Test TickClock monotonicity and conversion
+TEST(tick_clock) {
+    const auto a = TickClock::now();
+    const auto b = TickClock::now();
+    ASSERT_TRUE(b >= a);
+    ASSERT_TRUE(TickClock::ticks_per_ns() > 0.0);
+    ASSERT_EQ(0u, TickClock::to_ticks(-5ns));
+
+    // Round trip within 1%
+    const auto ticks = TickClock::to_ticks(1ms);
+    const auto back = TickClock::to_duration(ticks);
+    ASSERT_TRUE(back > 990us && back < 1010us);
+
+    // Saturating deadline
+    ASSERT_EQ(~std::uint64_t{0}, TickClock::deadline_in(std::chrono::nanoseconds::max()));
+}
+
+// Test step-budgeted slices
+TEST(execute_until_step_budget) {
+    SteppingComponent component(10);
+    component.initialize();
+
+    ExecutionBudget budget;
+    budget.max_steps = 4;
+    auto slice = component.execute_until(budget);
+    ASSERT_FALSE(slice.done);
+    ASSERT_EQ(4u, slice.steps);
+    ASSERT_EQ_ENUM(ExecutionState::Running, component.execution_state());
+
+    slice = component.execute_until(budget);
+    ASSERT_EQ(4u, slice.steps);
+
+    // A zero step budget still makes one call
+    ExecutionBudget zero;
+    zero.max_steps = 0;
+    slice = component.execute_until(zero);
+    ASSERT_EQ(1u, slice.steps);
+
+    // Completes mid-slice
+    slice = component.execute_until(budget);
+    ASSERT_TRUE(slice.done);
+    ASSERT_EQ(1u, slice.steps);
+    ASSERT_EQ(10u, component.count());
+
+    // Done: no further calls
+    slice = component.execute_until(budget);
+    ASSERT_TRUE(slice.done);
+    ASSERT_EQ(0u, slice.steps);
+}
+
+// Test that an expired deadline still makes progress
+TEST(execute_until_expired_deadline) {
+    SteppingComponent component(10);
+    component.initialize();
+
+    ExecutionBudget budget;
+    budget.deadline = 0;
+    auto slice = component.execute_until(budget);
+    ASSERT_FALSE(slice.done);
+    ASSERT_EQ(1u, slice.steps);
+
+    // Clock read only every check_interval steps
+    budget.check_interval = 3;
+    slice = component.execute_until(budget);
+    ASSERT_EQ(3u, slice.steps);
+    ASSERT_EQ(4, component.executed());
+}
+
+// Test time-budgeted slices
+TEST(execute_for_time_budget) {
+    SteppingComponent component(1000000, 100us);
+    component.initialize();
+
+    const auto start = std::chrono::steady_clock::now();
+    auto slice = component.execute_for(2ms);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_FALSE(slice.done);
+    ASSERT_TRUE(slice.steps >= 1);
+    ASSERT_TRUE(slice.steps <= 20); // Each step takes at least 100us
+    ASSERT_TRUE(elapsed >= 2ms);
+    ASSERT_TRUE(elapsed < 500ms);
+}
+
+// Test behavior when not initialized or terminated
+TEST(execute_for_not_ready) {
+    SteppingComponent component(3);
+    auto slice = component.execute_for(1ms);
+    ASSERT_FALSE(slice.done);
+    ASSERT_EQ(0u, slice.steps);
+
+    component.initialize();
+    component.terminate();
+    slice = component.execute_for(1ms);
+    ASSERT_FALSE(slice.done);
+    ASSERT_EQ(0u, slice.steps);
+    ASSERT_EQ(0, component.executed());
+}
+
+// Test fair round-robin time slicing of two components on one thread
+TEST(execute_for_round_robin) {
+    SteppingComponent bulk(50);
+    SteppingComponent latency(5);
+    bulk.initialize();
+    latency.initialize();
+
+    int rounds = 0;
+    bool bulk_done = false;
+    bool latency_done = false;
+    while (!bulk_done || !latency_done) {
+        bulk_done = bulk.execute_for(1s, 10).done;
+        latency_done = latency.execute_for(1s, 10).done;
+        rounds++;
+    }
+    ASSERT_EQ(5, rounds);
+    ASSERT_EQ(50, bulk.executed());
+    ASSERT_EQ(5, latency.executed());
+}
+
+int main() {
+    std::cout << "Running Execute-For Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
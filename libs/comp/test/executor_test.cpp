@@ -0,0 +1,205 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/executor.hpp>
+#include <dspai/comp/spsc_ring.hpp>
+#include "test_macros.hpp"
+#include <array>
+#include <atomic>
+#include <set>
+#include <thread>
+
+using namespace dspai::comp;
+
+// Pushes 0..count-1 into a ring
+class Producer : public Component {
+public:
+    Producer(SpscRing<std::uint64_t>& ring, std::uint64_t count) : ring_(ring), count_(count) {}
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override { next_ = 0; }
+    bool doExecute() noexcept override {
+        while (next_ < count_ && ring_.try_push(next_)) {
+            next_++;
+        }
+        return next_ == count_;
+    }
+
+private:
+    SpscRing<std::uint64_t>& ring_;
+    std::uint64_t count_;
+    std::uint64_t next_ = 0;
+};
+
+// Sums count values from a ring
+class Consumer : public Component {
+public:
+    Consumer(SpscRing<std::uint64_t>& ring, std::uint64_t count) : ring_(ring), count_(count) {}
+    std::uint64_t sum() const { return sum_; }
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override { received_ = sum_ = 0; }
+    bool doExecute() noexcept override {
+        std::uint64_t value = 0;
+        while (received_ < count_ && ring_.try_pop(value)) {
+            sum_ += value;
+            received_++;
+        }
+        return received_ == count_;
+    }
+
+private:
+    SpscRing<std::uint64_t>& ring_;
+    std::uint64_t count_;
+    std::uint64_t received_ = 0;
+    std::uint64_t sum_ = 0;
+};
+
+// Records the threads it runs on and checks it never runs concurrently
+class ThreadRecorder : public Component {
+public:
+    explicit ThreadRecorder(std::atomic<bool>& finish) : finish_(finish) {}
+    const std::set<std::thread::id>& threads() const { return threads_; }
+    bool overlapped() const { return overlapped_; }
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override {}
+    bool doExecute() noexcept override {
+        if (in_flight_.fetch_add(1) != 0) {
+            overlapped_ = true;
+        }
+        try {
+            threads_.insert(std::this_thread::get_id());
+        } catch (...) {
+        }
+        in_flight_.fetch_sub(1);
+        return finish_.load();
+    }
+
+private:
+    std::atomic<bool>& finish_;
+    std::set<std::thread::id> threads_;
+    std::atomic<int> in_flight_{0};
+    bool overlapped_ = false;
+};
+
+// Test a producer/consumer pipeline split over two workers
+TEST(executor_pipeline) {
+    constexpr std::uint64_t count = 100000;
+    SpscRing<std::uint64_t> ring;
+    ring.allocate(256);
+    Producer producer(ring, count);
+    Consumer consumer(ring, count);
+    producer.initialize();
+    consumer.initialize();
+
+    Graph graph;
+    const auto np = *graph.add(producer);
+    const auto nc = *graph.add(consumer);
+    graph.connect(np, nc);
+    graph.build();
+
+    ThreadedExecutor executor(graph);
+    ASSERT_FALSE(executor.start(2));
+    ASSERT_TRUE(executor.running());
+    ASSERT_EQ(0u, executor.owner(np));
+    ASSERT_EQ(1u, executor.owner(nc));
+    ASSERT_TRUE(executor.start(2) == std::errc::operation_not_permitted);
+
+    executor.wait();
+    ASSERT_FALSE(executor.running());
+    ASSERT_TRUE(executor.finished());
+    ASSERT_EQ(count * (count - 1) / 2, consumer.sum());
+    ASSERT_EQ_ENUM(NodeStatus::Done, graph.status(nc));
+    ASSERT_TRUE(executor.steps(nc) >= 1);
+}
+
+// Test start() argument checks
+TEST(executor_start_errors) {
+    std::atomic<bool> finish{true};
+    ThreadRecorder recorder(finish);
+    recorder.initialize();
+    Graph graph;
+    graph.add(recorder);
+
+    ThreadedExecutor executor(graph);
+    ASSERT_TRUE(executor.start(1) == std::errc::operation_not_permitted); // Not built
+    graph.build();
+    ASSERT_TRUE(executor.start(0) == std::errc::invalid_argument);
+    std::array<std::size_t, 2> wrong_size{0, 0};
+    ASSERT_TRUE(executor.start(1, wrong_size) == std::errc::invalid_argument);
+    std::array<std::size_t, 1> out_of_range{3};
+    ASSERT_TRUE(executor.start(2, out_of_range) == std::errc::invalid_argument);
+    ASSERT_TRUE(executor.migrate(0, 0) == std::errc::operation_not_permitted);
+
+    std::array<std::size_t, 1> owners{1};
+    ASSERT_FALSE(executor.start(2, owners));
+    executor.wait();
+    ASSERT_EQ(1u, executor.owner(0));
+    ASSERT_EQ(0u, executor.worker_steps(0));
+    ASSERT_EQ(1u, executor.worker_steps(1));
+}
+
+// Test migrating a node between workers while running
+TEST(executor_migrate) {
+    std::atomic<bool> finish{false};
+    ThreadRecorder recorder(finish);
+    recorder.initialize();
+    Graph graph;
+    const auto id = *graph.add(recorder);
+    graph.build();
+
+    ThreadedExecutor executor(graph);
+    executor.start(2);
+    ASSERT_TRUE(executor.migrate(id, 5) == std::errc::invalid_argument);
+    while (executor.steps(id) < 10) {
+        std::this_thread::yield();
+    }
+    ASSERT_FALSE(executor.migrate(id, 1));
+    ASSERT_EQ(1u, executor.owner(id));
+    ASSERT_EQ(1u, executor.migrations());
+    const auto before = executor.worker_steps(1);
+    while (executor.worker_steps(1) < before + 10) {
+        std::this_thread::yield();
+    }
+    finish = true;
+    executor.wait();
+
+    ASSERT_EQ(2u, recorder.threads().size());
+    ASSERT_FALSE(recorder.overlapped());
+}
+
+// Test stop() before the graph finishes
+TEST(executor_stop) {
+    std::atomic<bool> finish{false};
+    ThreadRecorder recorder(finish);
+    recorder.initialize();
+    Graph graph;
+    graph.add(recorder);
+    graph.build();
+
+    ThreadedExecutor executor(graph);
+    executor.start(1);
+    while (executor.steps(0) < 5) {
+        std::this_thread::yield();
+    }
+    executor.stop();
+    ASSERT_FALSE(executor.running());
+    ASSERT_FALSE(executor.finished());
+    ASSERT_FALSE(executor.activity(0).busy);
+}
+
+int main() {
+    std::cout << "Running Executor Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
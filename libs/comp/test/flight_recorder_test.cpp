@@ -0,0 +1,236 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/executor.hpp>
+#include <dspai/comp/flight_recorder.hpp>
+#include "test_macros.hpp"
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace dspai::comp;
+
+static std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / (std::string(name) + "." + std::to_string(getpid()))).string();
+}
+
+// Finishes after a number of steps, optionally failing on the last one
+class Steps : public Component {
+public:
+    explicit Steps(std::uint64_t steps, bool fail = false) : steps_(steps), fail_(fail) {}
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override { run_ = 0; }
+    bool doExecute() noexcept override {
+        if (++run_ < steps_) {
+            return false;
+        }
+        if (fail_) {
+            fail(std::make_error_code(std::errc::io_error));
+        }
+        return true;
+    }
+
+private:
+    std::uint64_t steps_;
+    bool fail_;
+    std::uint64_t run_ = 0;
+};
+
+// Test events round-trip through a dump in order with their names
+TEST(flight_recorder_roundtrip) {
+    FlightRecorder recorder(64, 4, 8);
+    ASSERT_TRUE(recorder.valid());
+    recorder.name_source(1, "fir");
+    recorder.record(EventType::ExecuteBegin, 1);
+    recorder.record(EventType::ExecuteEnd, 1, 1);
+    recorder.record(EventType::QueueDepth, 2, 17);
+    recorder.record(EventType::Error, 2, 5);
+
+    const auto path = temp_path("dspai_flight_roundtrip");
+    ASSERT_FALSE(recorder.dump(path.c_str()));
+    auto dump = read_flight_dump(path.c_str());
+    std::filesystem::remove(path);
+    ASSERT_TRUE(dump.has_value());
+    ASSERT_EQ(dump->threads, 1u);
+    ASSERT_EQ(dump->events.size(), 4u);
+    ASSERT_EQ_ENUM(EventType::ExecuteBegin, dump->events[0].type);
+    ASSERT_EQ_ENUM(EventType::Error, dump->events[3].type);
+    ASSERT_EQ(dump->events[2].value, 17u);
+    ASSERT_EQ(dump->events[3].source, 2u);
+    ASSERT_TRUE(dump->events[0].tick <= dump->events[3].tick);
+    ASSERT_TRUE(dump->events[3].tick <= dump->dump_tick);
+    ASSERT_TRUE(dump->name(1) == "fir");
+    ASSERT_TRUE(dump->name(2).empty());
+    ASSERT_TRUE(event_type_name(EventType::QueueDepth) == "queue_depth");
+
+    ASSERT_EQ(read_flight_dump("/nonexistent/dump").error(), std::make_error_code(std::errc::no_such_file_or_directory));
+    ASSERT_TRUE(recorder.dump("/nonexistent/dump"));
+}
+
+// Test the ring keeps only the newest events
+TEST(flight_recorder_wraparound) {
+    FlightRecorder recorder(8, 1, 1);
+    ASSERT_EQ(recorder.capacity(), 8u);
+    for (std::uint64_t i = 0; i < 20; ++i) {
+        recorder.record(EventType::Mark, 0, i);
+    }
+    const auto path = temp_path("dspai_flight_wrap");
+    ASSERT_FALSE(recorder.dump(path.c_str()));
+    auto dump = read_flight_dump(path.c_str());
+    std::filesystem::remove(path);
+    ASSERT_TRUE(dump.has_value());
+    ASSERT_EQ(dump->events.size(), 8u);
+    ASSERT_EQ(dump->overwritten, 12u);
+    ASSERT_EQ(dump->events.front().value, 12u);
+    ASSERT_EQ(dump->events.back().value, 19u);
+}
+
+// Test per-thread rings, lost threads, and dumps racing with writers never tear events
+TEST(flight_recorder_threads) {
+    FlightRecorder recorder(256, 3, 1);
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&] {
+            for (std::uint64_t i = 1; !stop.load() || i < 1000; ++i) {
+                recorder.record(EventType::Mark, static_cast<std::uint32_t>(i & 0xffff), i);
+            }
+        });
+    }
+
+    const auto path = temp_path("dspai_flight_threads");
+    for (int d = 0; d < 20; ++d) {
+        ASSERT_FALSE(recorder.dump(path.c_str()));
+        auto dump = read_flight_dump(path.c_str());
+        ASSERT_TRUE(dump.has_value());
+        for (const auto& event : dump->events) {
+            ASSERT_EQ(event.source, event.value & 0xffff);
+            ASSERT_TRUE(event.thread < 3u);
+        }
+    }
+    stop = true;
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    std::filesystem::remove(path);
+    ASSERT_EQ(recorder.lost_threads(), 1u);
+}
+
+// Test rings return when their thread exits and are reused by later threads
+TEST(flight_recorder_thread_reuse) {
+    FlightRecorder recorder(64, 2, 1);
+    for (std::uint64_t t = 0; t < 6; ++t) { // Three times more thread lifetimes than rings
+        std::thread([&] { recorder.record(EventType::Mark, 0, t); }).join();
+    }
+    std::thread([&] {
+        recorder.record(EventType::Mark, 0, 100);
+        std::thread([&] { recorder.record(EventType::Mark, 0, 101); }).join(); // Second ring while one is held
+    }).join();
+    ASSERT_EQ(recorder.lost_threads(), 0u);
+
+    const auto path = temp_path("dspai_flight_reuse");
+    ASSERT_FALSE(recorder.dump(path.c_str()));
+    auto dump = read_flight_dump(path.c_str());
+    std::filesystem::remove(path);
+    ASSERT_TRUE(dump.has_value());
+    ASSERT_EQ(dump->threads, 2u);
+    ASSERT_EQ(dump->events.size(), 8u);
+    ASSERT_EQ(dump->events.front().value, 0u);
+    ASSERT_EQ(dump->events.back().value, 101u);
+}
+
+// Test the signal handler leaves errno as the interrupted code had it
+TEST(flight_recorder_signal_errno) {
+    FlightRecorder recorder(16, 1, 1);
+    recorder.record(EventType::Mark, 0);
+    const int signals[] = {SIGUSR2};
+    ASSERT_FALSE(install_dump_on_signal(recorder, "/nonexistent/dump", signals)); // dump() fails: sets errno
+    errno = EAGAIN;
+    std::raise(SIGUSR2);
+    ASSERT_EQ(errno, EAGAIN);
+    uninstall_dump_on_signal();
+}
+
+// Test the executor records steps, failures and state changes
+TEST(flight_recorder_executor) {
+    Steps ok(3);
+    Steps bad(2, true);
+    ok.initialize();
+    bad.initialize();
+    Graph graph;
+    NodeOptions options;
+    options.name = "ok";
+    graph.add(ok, options);
+    options.name = "bad";
+    options.policy = FailurePolicy::Isolate;
+    graph.add(bad, options);
+    graph.build();
+
+    FlightRecorder recorder(1024, 4, 8);
+    ThreadedExecutor executor(graph);
+    executor.set_recorder(&recorder);
+    ASSERT_FALSE(executor.start(2));
+    executor.wait();
+
+    const auto path = temp_path("dspai_flight_executor");
+    ASSERT_FALSE(recorder.dump(path.c_str()));
+    auto dump = read_flight_dump(path.c_str());
+    std::filesystem::remove(path);
+    ASSERT_TRUE(dump.has_value());
+    ASSERT_TRUE(dump->name(0) == "ok");
+    ASSERT_TRUE(dump->name(1) == "bad");
+
+    std::uint64_t begins = 0;
+    std::uint64_t errors = 0;
+    std::uint64_t isolated = 0;
+    for (const auto& event : dump->events) {
+        begins += event.type == EventType::ExecuteBegin;
+        if (event.type == EventType::Error) {
+            errors++;
+            ASSERT_EQ(event.source, 1u);
+            ASSERT_EQ(event.value, static_cast<std::uint64_t>(EIO));
+        }
+        isolated += event.type == EventType::StateChange && event.value == static_cast<std::uint64_t>(NodeStatus::Isolated);
+    }
+    ASSERT_EQ(begins, executor.steps(0) + executor.steps(1));
+    ASSERT_EQ(errors, 1u);
+    ASSERT_EQ(isolated, 1u);
+}
+
+// Test a non-fatal signal dumps and the process continues
+TEST(flight_recorder_signal) {
+    FlightRecorder recorder(16, 1, 1);
+    recorder.record(EventType::Mark, 0, 42);
+    const auto path = temp_path("dspai_flight_signal");
+    const int signals[] = {SIGUSR1};
+    ASSERT_FALSE(install_dump_on_signal(recorder, path.c_str(), signals));
+    std::raise(SIGUSR1);
+    uninstall_dump_on_signal();
+
+    auto dump = read_flight_dump(path.c_str());
+    std::filesystem::remove(path);
+    ASSERT_TRUE(dump.has_value());
+    ASSERT_EQ(dump->events.size(), 1u);
+    ASSERT_EQ(dump->events[0].value, 42u);
+
+    const std::string long_path(300, 'x');
+    ASSERT_EQ(install_dump_on_signal(recorder, long_path.c_str(), signals),
+              std::make_error_code(std::errc::filename_too_long));
+}
+
+int main() {
+    std::cout << "Running Flight Recorder Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,180 @@
+#include <dspai/comp/golden.hpp>
+#include "test_macros.hpp"
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+using namespace dspai::comp;
+
+// 8-tap FIR with zero history: out[i] = sum h[k] * in[i - k]
+static constexpr float taps[8] = {0.125f, -0.25f, 0.5f, 0.75f, 0.5f, -0.25f, 0.125f, 0.0625f};
+
+static void fir_scalar(std::span<const float> in, std::span<float> out) noexcept {
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        float acc = 0.0f;
+        for (std::size_t k = 0; k < 8 && k <= i; ++k) {
+            acc += taps[k] * in[i - k];
+        }
+        out[i] = acc;
+    }
+}
+
+// Wrong last tap: must be caught
+static void fir_broken(std::span<const float> in, std::span<float> out) noexcept {
+    fir_scalar(in, out);
+    for (std::size_t i = 7; i < in.size(); ++i) {
+        out[i] += 0.001f * in[i - 7];
+    }
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+__attribute__((target("avx2,fma"))) static void fir_avx2(std::span<const float> in, std::span<float> out) noexcept {
+    std::size_t i = 0;
+    for (; i < std::min<std::size_t>(8, in.size()); ++i) {
+        float acc = 0.0f;
+        for (std::size_t k = 0; k <= i; ++k) {
+            acc += taps[k] * in[i - k];
+        }
+        out[i] = acc;
+    }
+    for (; i + 8 <= in.size(); i += 8) {
+        __m256 acc = _mm256_setzero_ps();
+        for (std::size_t k = 0; k < 8; ++k) {
+            acc = _mm256_fmadd_ps(_mm256_set1_ps(taps[k]), _mm256_loadu_ps(&in[i - k]), acc);
+        }
+        _mm256_storeu_ps(&out[i], acc);
+    }
+    for (; i < in.size(); ++i) {
+        float acc = 0.0f;
+        for (std::size_t k = 0; k < 8; ++k) {
+            acc += taps[k] * in[i - k];
+        }
+        out[i] = acc;
+    }
+}
+
+__attribute__((target("avx512f"))) static void fir_avx512(std::span<const float> in, std::span<float> out) noexcept {
+    fir_scalar(in.first(std::min<std::size_t>(16, in.size())), out.first(std::min<std::size_t>(16, in.size())));
+    std::size_t i = 16;
+    for (; i + 16 <= in.size(); i += 16) {
+        __m512 acc = _mm512_setzero_ps();
+        for (std::size_t k = 0; k < 8; ++k) {
+            acc = _mm512_fmadd_ps(_mm512_set1_ps(taps[k]), _mm512_loadu_ps(&in[i - k]), acc);
+        }
+        _mm512_storeu_ps(&out[i], acc);
+    }
+    for (; i < in.size(); ++i) {
+        float acc = 0.0f;
+        for (std::size_t k = 0; k < 8; ++k) {
+            acc += taps[k] * in[i - k];
+        }
+        out[i] = acc;
+    }
+}
+#endif
+
+static std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / (std::string(name) + "." + std::to_string(getpid()))).string();
+}
+
+// Test ULP distance across signs, zeros and NaN
+TEST(golden_ulp) {
+    ASSERT_EQ(ulp_distance(1.0f, 1.0f), 0u);
+    ASSERT_EQ(ulp_distance(1.0f, std::nextafter(1.0f, 2.0f)), 1u);
+    ASSERT_EQ(ulp_distance(0.0f, -0.0f), 0u);
+    ASSERT_EQ(ulp_distance(-std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::denorm_min()), 2u);
+    ASSERT_EQ(ulp_distance(-1.0, std::nextafter(-1.0, 0.0)), 1u);
+    ASSERT_EQ(ulp_distance(1.0f, std::nanf("")), std::numeric_limits<std::uint64_t>::max());
+
+    const std::vector<float> reference = {1.0f, -1.0f};
+    const std::vector<float> noisy = {1.001f, -1.0f};
+    ASSERT_TRUE(std::isinf(snr_db<float>(reference, reference)));
+    ASSERT_TRUE(std::abs(snr_db<float>(reference, noisy) - 63.0) < 0.1);
+}
+
+// Test golden vectors round-trip and reject foreign files
+TEST(golden_file) {
+    const auto input = golden_input<float>(100, 7);
+    ASSERT_TRUE(input == golden_input<float>(100, 7));
+    ASSERT_TRUE(input != golden_input<float>(100, 8));
+    for (auto x : input) {
+        ASSERT_TRUE(x >= -1.0f && x < 1.0f);
+    }
+
+    const auto path = temp_path("dspai_golden");
+    ASSERT_FALSE(write_golden<float>(path.c_str(), input));
+    auto loaded = read_golden<float>(path.c_str());
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_TRUE(*loaded == input);
+    ASSERT_EQ(read_golden<double>(path.c_str()).error(), std::make_error_code(std::errc::illegal_byte_sequence));
+    std::filesystem::resize_file(path, 30);
+    ASSERT_EQ(read_golden<float>(path.c_str()).error(), std::make_error_code(std::errc::io_error));
+    std::filesystem::remove(path);
+    ASSERT_EQ(read_golden<float>(path.c_str()).error(), std::make_error_code(std::errc::no_such_file_or_directory));
+}
+
+// Test every available target matches the scalar golden output, and a wrong kernel fails
+TEST(golden_targets) {
+    const auto input = golden_input<float>(4099);
+    std::vector<float> golden(input.size());
+    fir_scalar(input, golden);
+
+    const KernelVariant<float> variants[] = {
+        {"fir/scalar", IsaTarget::Scalar, &fir_scalar},
+#if defined(__x86_64__) && defined(__GNUC__)
+        {"fir/avx2", IsaTarget::Avx2, &fir_avx2},
+        {"fir/avx512", IsaTarget::Avx512, &fir_avx512},
+#endif
+        {"fir/broken", IsaTarget::Scalar, &fir_broken},
+    };
+    GoldenOptions options;
+    options.tolerance.max_ulp = 16;
+    options.tolerance.abs_floor = 1e-6;
+    options.tolerance.min_snr_db = 100.0;
+    options.min_time = std::chrono::milliseconds(2);
+    auto report = check_golden<float>(variants, input, golden, options);
+    ASSERT_TRUE(report.has_value());
+    ASSERT_EQ(report->targets.size(), std::size(variants));
+    ASSERT_FALSE(report->passed());
+
+    const auto& scalar = report->targets.front();
+    ASSERT_TRUE(scalar.supported && scalar.passed);
+    ASSERT_EQ(scalar.max_ulp, 0u);
+    ASSERT_TRUE(scalar.samples_per_second > 0.0);
+    const auto& broken = report->targets.back();
+    ASSERT_FALSE(broken.passed);
+    ASSERT_TRUE(broken.failed_samples > 0);
+    for (std::size_t v = 1; v + 1 < report->targets.size(); ++v) {
+        const auto& simd = report->targets[v];
+        ASSERT_EQ(simd.supported, isa_supported(simd.target));
+        if (!simd.passed) {
+            std::cerr << format_golden_report(*report);
+        }
+        ASSERT_TRUE(simd.passed);
+    }
+
+    const auto text = format_golden_report(*report);
+    ASSERT_TRUE(text.find("fir/broken") != std::string::npos);
+    ASSERT_TRUE(text.find("FAIL") != std::string::npos);
+
+    ASSERT_EQ(check_golden<float>(variants, input, std::span<const float>(golden).first(10)).error(),
+              std::make_error_code(std::errc::invalid_argument));
+}
+
+int main() {
+    std::cout << "Running Golden Vector Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
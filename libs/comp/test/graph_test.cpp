@@ -0,0 +1,253 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/graph.hpp>
+#include "test_macros.hpp"
+
+using namespace dspai::comp;
+
+// Component that fails at a configurable step (1-based count within a run), otherwise never finishes
+class FaultyComponent : public Component {
+public:
+    explicit FaultyComponent(std::uint64_t fail_at = 0, std::uint64_t done_at = 0)
+        : fail_at_(fail_at), done_at_(done_at) {}
+    std::uint64_t executed() const { return executed_; }
+    std::uint64_t resets() const { return resets_; }
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override {
+        run_ = 0;
+        resets_++;
+    }
+    bool doExecute() noexcept override {
+        executed_++;
+        run_++;
+        if (fail_at_ && run_ == fail_at_) {
+            fail(std::make_error_code(std::errc::value_too_large));
+            return false;
+        }
+        return done_at_ && run_ >= done_at_;
+    }
+
+private:
+    std::uint64_t fail_at_;
+    std::uint64_t done_at_;
+    std::uint64_t executed_ = 0;
+    std::uint64_t resets_ = 0;
+    std::uint64_t run_ = 0;
+};
+
+NodeOptions node_options(std::string name, FailurePolicy policy, std::uint32_t max_restarts = 3,
+                         std::function<bool()> bypass = {}) {
+    NodeOptions options;
+    options.name = std::move(name);
+    options.policy = policy;
+    options.max_restarts = max_restarts;
+    options.bypass = std::move(bypass);
+    return options;
+}
+
+// Test the latched error channel on Component
+TEST(component_error_channel) {
+    FaultyComponent component(2);
+    ASSERT_FALSE(component.last_error());
+    component.initialize();
+
+    ASSERT_FALSE(component.execute());
+    ASSERT_TRUE(component.execute()); // Failure ends the step in Done
+    ASSERT_EQ_ENUM(ExecutionState::Done, component.execution_state());
+    ASSERT_TRUE(component.last_error() == std::errc::value_too_large);
+    ASSERT_TRUE(component.execute()); // Stays Done
+    ASSERT_EQ(2u, component.executed());
+
+    component.reset();
+    ASSERT_FALSE(component.last_error());
+    ASSERT_FALSE(component.execute());
+
+    component.terminate();
+    ASSERT_FALSE(component.last_error());
+}
+
+// Test graph construction and ordering
+TEST(graph_build) {
+    FaultyComponent a, b, c;
+    Graph graph;
+    const auto na = *graph.add(a);
+    const auto nb = *graph.add(b);
+    const auto nc = *graph.add(c);
+    ASSERT_TRUE(graph.connect(na, na) == std::errc::invalid_argument);
+    ASSERT_TRUE(graph.connect(na, 7) == std::errc::invalid_argument);
+
+    // c -> b -> a executes in dependency order
+    ASSERT_FALSE(graph.connect(nc, nb));
+    ASSERT_FALSE(graph.connect(nb, na));
+    ASSERT_FALSE(graph.step()); // Not built
+    ASSERT_FALSE(graph.build());
+    ASSERT_EQ(nc, graph.order()[0]);
+    ASSERT_EQ(nb, graph.order()[1]);
+    ASSERT_EQ(na, graph.order()[2]);
+
+    // Cycle
+    ASSERT_FALSE(graph.connect(na, nc));
+    ASSERT_TRUE(graph.build() == std::errc::invalid_argument);
+    ASSERT_FALSE(graph.built());
+}
+
+// Test normal completion
+TEST(graph_runs_to_completion) {
+    FaultyComponent a(0, 2);
+    FaultyComponent b(0, 4);
+    a.initialize();
+    b.initialize();
+    Graph graph;
+    graph.add(a);
+    graph.add(b);
+    graph.build();
+
+    int steps = 1;
+    while (!graph.step()) {
+        steps++;
+    }
+    ASSERT_EQ(4, steps);
+    ASSERT_EQ(2u, a.executed()); // Done nodes are not executed again
+    ASSERT_EQ_ENUM(NodeStatus::Done, graph.status(0));
+    ASSERT_FALSE(graph.error());
+}
+
+// Test Stop policy halts the graph
+TEST(policy_stop) {
+    FaultyComponent bad(2);
+    FaultyComponent good;
+    bad.initialize();
+    good.initialize();
+    Graph graph;
+    const auto nb = *graph.add(bad, node_options("bad", FailurePolicy::Stop));
+    graph.add(good);
+    graph.build();
+
+    ASSERT_FALSE(graph.step());
+    ASSERT_TRUE(graph.step());
+    ASSERT_TRUE(graph.stopped());
+    ASSERT_TRUE(graph.error() == std::errc::value_too_large);
+    ASSERT_EQ(1u, good.executed()); // Halted before the rest of the pass
+    ASSERT_EQ(1u, graph.stats(nb).failures);
+    ASSERT_TRUE(graph.step());
+    ASSERT_EQ(1u, good.executed());
+
+    graph.reset();
+    ASSERT_FALSE(graph.stopped());
+    ASSERT_EQ_ENUM(NodeStatus::Active, graph.status(nb));
+    ASSERT_FALSE(graph.step());
+}
+
+// Test Isolate policy keeps other streams flowing
+TEST(policy_isolate) {
+    FaultyComponent bad(3);
+    FaultyComponent bad_consumer;
+    FaultyComponent other;
+    bad.initialize();
+    bad_consumer.initialize();
+    other.initialize();
+
+    Graph graph;
+    const auto nb = *graph.add(bad, node_options("bad", FailurePolicy::Isolate));
+    const auto nc = *graph.add(bad_consumer);
+    graph.add(other);
+    graph.connect(nb, nc);
+    graph.build();
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_FALSE(graph.step());
+    }
+    ASSERT_EQ_ENUM(NodeStatus::Isolated, graph.status(nb));
+    ASSERT_EQ(3u, bad.executed());
+    ASSERT_EQ(10u, other.executed()); // Full rate
+    ASSERT_EQ(10u, bad_consumer.executed());
+    ASSERT_TRUE(graph.stats(nb).last_error == std::errc::value_too_large);
+    ASSERT_FALSE(graph.error());
+}
+
+// Test Restart policy with a restart budget
+TEST(policy_restart) {
+    FaultyComponent flaky(2);
+    flaky.initialize();
+    Graph graph;
+    const auto id = *graph.add(flaky, node_options("flaky", FailurePolicy::Restart, 2));
+    graph.build();
+
+    for (int i = 0; i < 4; ++i) {
+        graph.step();
+    }
+    ASSERT_EQ(2u, graph.stats(id).failures);
+    ASSERT_EQ(2u, graph.stats(id).restarts);
+    ASSERT_EQ_ENUM(NodeStatus::Active, graph.status(id));
+
+    // Budget exhausted: third failure isolates
+    graph.step();
+    ASSERT_TRUE(graph.step());
+    ASSERT_EQ(3u, graph.stats(id).failures);
+    ASSERT_EQ_ENUM(NodeStatus::Isolated, graph.status(id));
+}
+
+// Test Bypass policy
+TEST(policy_bypass) {
+    FaultyComponent bad(1);
+    FaultyComponent no_bypass(1);
+    bad.initialize();
+    no_bypass.initialize();
+
+    int passed_through = 0;
+    Graph graph;
+    const auto nb = *graph.add(bad, node_options("bad", FailurePolicy::Bypass, 3, [&] {
+        passed_through++;
+        return false;
+    }));
+    const auto nn = *graph.add(no_bypass, node_options("plain", FailurePolicy::Bypass));
+    graph.build();
+
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_FALSE(graph.step()); // Bypassed nodes keep the graph running
+    }
+    ASSERT_EQ_ENUM(NodeStatus::Bypassed, graph.status(nb));
+    ASSERT_EQ(4, passed_through);
+    ASSERT_EQ(4u, graph.stats(nb).bypassed_steps);
+    ASSERT_EQ(1u, bad.executed());
+    ASSERT_EQ_ENUM(NodeStatus::Isolated, graph.status(nn)); // No bypass function
+}
+
+// Test a bypassed graph runs to completion once the bypass function reports finished
+TEST(policy_bypass_completes) {
+    FaultyComponent bad(2);
+    FaultyComponent good(0, 6);
+    bad.initialize();
+    good.initialize();
+
+    int forwarded = 0;
+    Graph graph;
+    const auto nb = *graph.add(bad, node_options("bad", FailurePolicy::Bypass, 3, [&] { return ++forwarded == 3; }));
+    const auto ng = *graph.add(good, node_options("good", FailurePolicy::Stop));
+    graph.connect(nb, ng);
+    graph.build();
+
+    int steps = 1;
+    while (!graph.step()) {
+        ASSERT_TRUE(++steps <= 10);
+    }
+    ASSERT_EQ(6, steps);
+    ASSERT_FALSE(graph.error());
+    ASSERT_EQ_ENUM(NodeStatus::Isolated, graph.status(nb));
+    ASSERT_EQ_ENUM(NodeStatus::Done, graph.status(ng));
+    ASSERT_EQ(3, forwarded);
+    ASSERT_EQ(3u, graph.stats(nb).bypassed_steps);
+}
+
+int main() {
+    std::cout << "Running Graph Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <dspai/comp/latency.hpp>
+#include "test_macros.hpp"
+#include <chrono>
+#include <thread>
+
+using namespace dspai::comp;
+using namespace std::chrono_literals;
+
+// Spin for roughly d (sleep granularity is too coarse for stage timings)
+static void busy_for(std::chrono::nanoseconds d) {
+    const auto end = std::chrono::steady_clock::now() + d;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+// Test bucket boundaries and percentile bounds
+TEST(latency_histogram) {
+    ASSERT_EQ(LatencyHistogram::bucket_of(0), 0u);
+    ASSERT_EQ(LatencyHistogram::bucket_of(1), 0u);
+    ASSERT_EQ(LatencyHistogram::bucket_of(2), 1u);
+    ASSERT_EQ(LatencyHistogram::bucket_of(3), 1u);
+    ASSERT_EQ(LatencyHistogram::bucket_of(1024), 10u);
+
+    LatencyHistogram histogram;
+    ASSERT_EQ(histogram.percentile(50).count(), 0);
+    for (int i = 0; i < 99; ++i) {
+        histogram.record(100ns);
+    }
+    histogram.record(10us);
+    ASSERT_EQ(histogram.count(), 100u);
+    ASSERT_EQ(histogram.min().count(), 100);
+    ASSERT_EQ(histogram.max().count(), 10000);
+    ASSERT_EQ(histogram.mean().count(), (99 * 100 + 10000) / 100);
+    ASSERT_EQ(histogram.percentile(50).count(), 127); // [64, 128)
+    ASSERT_EQ(histogram.percentile(100).count(), 10000); // Capped at max
+    histogram.record(-5ns);
+    ASSERT_EQ(histogram.bucket(0), 1u);
+
+    histogram.reset();
+    ASSERT_EQ(histogram.count(), 0u);
+    ASSERT_EQ(histogram.min().count(), 0);
+}
+
+// Test probes through source -> filter -> sink with queueing and processing split
+TEST(latency_pipeline) {
+    LatencyTracer tracer;
+    ASSERT_TRUE(tracer.allocate(0, 4) == std::errc::invalid_argument);
+    ASSERT_FALSE(tracer.allocate(2, 4));
+    tracer.name_stage(0, "filter");
+    tracer.name_stage(1, "sink");
+
+    TagRing source_out;
+    TagRing filter_out;
+    source_out.allocate(16);
+    filter_out.allocate(16);
+    TagOutput source_tags(source_out);
+    TagInput filter_in(source_out);
+    TagOutput filter_tags(filter_out);
+    TagInput sink_in(filter_out);
+
+    constexpr std::uint64_t block = 64;
+    std::uint64_t stamped = 0;
+    for (std::uint64_t b = 0; b < 40; ++b) {
+        const std::uint64_t offset = b * block;
+        if (tracer.sample()) {
+            source_tags.post(tracer.stamp(offset));
+            stamped++;
+        }
+        busy_for(20us); // Block waits in the queue
+
+        filter_in.take(offset + block, [&](const Tag& tag) {
+            if (tag.key == TagKey::Latency) {
+                const auto arrived = tracer.arrive(0, tag);
+                busy_for(50us); // Processing
+                filter_tags.post(tracer.depart(0, tag, arrived, tag.offset / 2));
+            }
+        });
+
+        sink_in.take(offset / 2 + block, [&](const Tag& tag) {
+            if (tag.key == TagKey::Latency) {
+                const auto arrived = tracer.arrive(1, tag);
+                tracer.depart(1, tag, arrived, tag.offset);
+                tracer.complete(tag);
+            }
+        });
+    }
+
+    ASSERT_EQ(stamped, 10u);
+    ASSERT_EQ(tracer.queueing(0).count(), 10u);
+    ASSERT_EQ(tracer.processing(0).count(), 10u);
+    ASSERT_EQ(tracer.processing(1).count(), 10u);
+    ASSERT_EQ(tracer.end_to_end().count(), 10u);
+    ASSERT_EQ(tracer.stale(), 0u);
+
+    ASSERT_TRUE(tracer.queueing(0).min() >= 20us);
+    ASSERT_TRUE(tracer.processing(0).min() >= 50us);
+    ASSERT_TRUE(tracer.end_to_end().min() >= 70us);
+
+    const auto report = tracer.report();
+    ASSERT_TRUE(report.find("filter") != std::string::npos);
+    ASSERT_TRUE(report.find("end-to-end           n=10 ") != std::string::npos);
+}
+
+// Test a probe outliving its slot in the origin table is counted stale
+TEST(latency_stale) {
+    LatencyTracer tracer;
+    ASSERT_FALSE(tracer.allocate(1, 1, 2));
+    ASSERT_TRUE(tracer.sample());
+    const auto old_probe = tracer.stamp(0);
+    tracer.stamp(1);
+    tracer.stamp(2); // Reuses the slot of old_probe
+    tracer.complete(old_probe);
+    ASSERT_EQ(tracer.stale(), 1u);
+    ASSERT_EQ(tracer.end_to_end().count(), 0u);
+}
+
+int main() {
+    std::cout << "Running Latency Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
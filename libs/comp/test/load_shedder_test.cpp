@@ -0,0 +1,287 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/load_shedder.hpp>
+#include <dspai/comp/spsc_ring.hpp>
+#include "test_macros.hpp"
+#include <algorithm>
+
+using namespace dspai::comp;
+
+// Pushes `rate` items per step; items that do not fit are lost upstream
+class Source : public Component {
+public:
+    Source(SpscRing<int>& ring, int rate) : ring_(ring), rate_(rate) {}
+    void set_rate(int rate) { rate_ = rate; }
+    std::uint64_t lost() const { return lost_; }
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override {}
+    bool doExecute() noexcept override {
+        for (int i = 0; i < rate_; ++i) {
+            if (!ring_.try_push(i)) {
+                lost_++;
+            }
+        }
+        return false;
+    }
+
+private:
+    SpscRing<int>& ring_;
+    int rate_;
+    std::uint64_t lost_ = 0;
+};
+
+// Pops up to `rate` items per step
+class Sink : public Component {
+public:
+    Sink(SpscRing<int>& ring, int rate) : ring_(ring), rate_(rate) {}
+    std::uint64_t received() const { return received_; }
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override {}
+    bool doExecute() noexcept override {
+        int value = 0;
+        for (int i = 0; i < rate_ && ring_.try_pop(value); ++i) {
+            received_++;
+        }
+        return false;
+    }
+
+private:
+    SpscRing<int>& ring_;
+    int rate_;
+    std::uint64_t received_ = 0;
+};
+
+// Counts its steps
+class Counter : public Component {
+public:
+    int steps = 0;
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override {}
+    bool doExecute() noexcept override {
+        steps++;
+        return false;
+    }
+};
+
+// drop() hook: discard up to n oldest items (through readable(), as consume() requires)
+static std::size_t drop_oldest(SpscRing<int>& ring, std::size_t n) {
+    std::size_t dropped = 0;
+    for (auto region = ring.readable(); dropped < n && !region.empty(); region = ring.readable()) {
+        const auto chunk = std::min(n - dropped, region.size());
+        ring.consume(chunk);
+        dropped += chunk;
+    }
+    return dropped;
+}
+
+// Test graph-level decimation and backlog limits
+TEST(graph_shedding_controls) {
+    SpscRing<int> ring;
+    ring.allocate(64);
+    for (int i = 0; i < 40; ++i) {
+        ring.try_push(i);
+    }
+    Counter counter;
+    Sink sink(ring, 0);
+    counter.initialize();
+    sink.initialize();
+
+    Graph graph;
+    const auto nc = *graph.add(counter);
+    NodeOptions options;
+    options.backlog = [&] { return ring.size(); };
+    options.backlog_capacity = ring.capacity();
+    options.drop = [&](std::size_t n) { return drop_oldest(ring, n); };
+    const auto ns = *graph.add(sink, std::move(options));
+    graph.build();
+    ASSERT_EQ(1u, graph.decimation(nc));
+
+    graph.set_decimation(nc, 3);
+    for (int i = 0; i < 9; ++i) {
+        graph.step();
+    }
+    ASSERT_EQ(3, counter.steps);
+    ASSERT_EQ(6u, graph.stats(nc).shed_steps);
+
+    graph.set_decimation(nc, 0);
+    graph.step();
+    ASSERT_EQ(3, counter.steps);
+
+    // A skipped node's input is discarded, since nothing else consumes it
+    graph.set_decimation(ns, 0);
+    graph.step();
+    ASSERT_EQ(0u, ring.size());
+    ASSERT_EQ(40u, graph.stats(ns).dropped);
+    graph.set_decimation(ns, 1);
+    for (int i = 0; i < 40; ++i) {
+        ring.try_push(i);
+    }
+
+    graph.set_backlog_limit(ns, 10);
+    graph.step();
+    ASSERT_EQ(10u, ring.size());
+    ASSERT_EQ(70u, graph.stats(ns).dropped);
+}
+
+// Test escalation under sustained overload and recovery with hysteresis
+TEST(load_shedder_escalates_and_recovers) {
+    SpscRing<int> ring;
+    ring.allocate(64);
+    Source source(ring, 8);
+    Sink sink(ring, 4); // Half the arrival rate
+    Counter tap;
+    Counter optional;
+    for (Component* c : std::initializer_list<Component*>{&source, &sink, &tap, &optional}) {
+        c->initialize();
+    }
+
+    Graph graph;
+    const auto nsrc = *graph.add(source);
+    NodeOptions sink_options;
+    sink_options.name = "sink";
+    sink_options.backlog = [&] { return ring.size(); };
+    sink_options.backlog_capacity = ring.capacity();
+    sink_options.drop = [&](std::size_t n) { return drop_oldest(ring, n); };
+    const auto nsink = *graph.add(sink, std::move(sink_options));
+    NodeOptions tap_options;
+    tap_options.criticality = Criticality::Tap;
+    const auto ntap = *graph.add(tap, std::move(tap_options));
+    NodeOptions optional_options;
+    optional_options.criticality = Criticality::Optional;
+    const auto nopt = *graph.add(optional, std::move(optional_options));
+    graph.connect(nsrc, nsink);
+    graph.build();
+
+    ShedConfig config;
+    config.sustain = 2;
+    config.tap_decimation = 2;
+    LoadShedder shedder(graph, config);
+
+    // Backlog grows by 4 per step; the shedder escalates one stage per 2 overloaded updates
+    ShedLevel highest = ShedLevel::None;
+    for (int i = 0; i < 40; ++i) {
+        graph.step();
+        highest = std::max(highest, shedder.update());
+        if (shedder.level() == ShedLevel::DecimateTaps) {
+            ASSERT_EQ(2u, graph.decimation(ntap));
+            ASSERT_EQ(1u, graph.decimation(nopt));
+        }
+    }
+    ASSERT_EQ_ENUM(ShedLevel::DropOldest, highest);
+    ASSERT_EQ_ENUM(ShedLevel::DropOldest, shedder.level());
+    ASSERT_EQ(3u, shedder.escalations());
+    ASSERT_EQ(0u, graph.decimation(ntap));
+    ASSERT_EQ(0u, graph.decimation(nopt));
+    ASSERT_EQ(1u, graph.decimation(nsink)); // Critical path at full rate
+    ASSERT_EQ(40u * 4u, sink.received());
+    ASSERT_TRUE(ring.size() <= 48 + 8); // Bounded near the high watermark
+    ASSERT_TRUE(shedder.dropped() > 0);
+    ASSERT_TRUE(shedder.shed_steps() > 0);
+    ASSERT_EQ(graph.stats(ntap).shed_steps + graph.stats(nopt).shed_steps, shedder.shed_steps());
+
+    // Load drops below capacity: de-escalate stage by stage back to None
+    source.set_rate(0);
+    for (int i = 0; i < 40; ++i) {
+        graph.step();
+        shedder.update();
+    }
+    ASSERT_EQ_ENUM(ShedLevel::None, shedder.level());
+    ASSERT_EQ(1u, graph.decimation(ntap));
+    ASSERT_EQ(~std::size_t{0}, graph.backlog_limit(nsink));
+    const int tap_steps = tap.steps;
+    graph.step();
+    ASSERT_EQ(tap_steps + 1, tap.steps);
+}
+
+// Test a shed tap that consumes a probed ring is drained, so the critical producer is never
+// back-pressured and the level recovers once the load goes away
+TEST(load_shedder_drains_shed_tap) {
+    SpscRing<int> ring;
+    ring.allocate(64);
+    Source source(ring, 8);
+    Sink tap(ring, 4); // Half the arrival rate
+    source.initialize();
+    tap.initialize();
+
+    Graph graph;
+    const auto nsrc = *graph.add(source);
+    NodeOptions tap_options;
+    tap_options.criticality = Criticality::Tap;
+    tap_options.backlog = [&] { return ring.size(); };
+    tap_options.backlog_capacity = ring.capacity();
+    tap_options.drop = [&](std::size_t n) { return drop_oldest(ring, n); };
+    const auto ntap = *graph.add(tap, std::move(tap_options));
+    graph.connect(nsrc, ntap);
+    graph.build();
+
+    ShedConfig config;
+    config.sustain = 2;
+    config.tap_decimation = 2;
+    LoadShedder shedder(graph, config);
+
+    ShedLevel highest = ShedLevel::None;
+    for (int i = 0; i < 40; ++i) {
+        graph.step();
+        highest = std::max(highest, shedder.update());
+    }
+    ASSERT_TRUE(highest >= ShedLevel::DecimateTaps);
+    ASSERT_TRUE(graph.stats(ntap).dropped > 0);
+    ASSERT_EQ(0u, source.lost());
+
+    source.set_rate(0);
+    for (int i = 0; i < 20; ++i) {
+        graph.step();
+        shedder.update();
+    }
+    ASSERT_EQ_ENUM(ShedLevel::None, shedder.level());
+    ASSERT_EQ(1u, graph.decimation(ntap));
+    ASSERT_EQ(0u, ring.size());
+}
+
+// Test max_level caps escalation
+TEST(load_shedder_max_level) {
+    SpscRing<int> ring;
+    ring.allocate(16);
+    Source source(ring, 4);
+    Sink sink(ring, 1);
+    source.initialize();
+    sink.initialize();
+
+    Graph graph;
+    graph.add(source);
+    NodeOptions options;
+    options.backlog = [&] { return ring.size(); };
+    options.backlog_capacity = ring.capacity();
+    graph.add(sink, std::move(options));
+    graph.build();
+
+    ShedConfig config;
+    config.sustain = 1;
+    config.max_level = ShedLevel::DecimateTaps;
+    LoadShedder shedder(graph, config);
+    for (int i = 0; i < 20; ++i) {
+        graph.step();
+        shedder.update();
+    }
+    ASSERT_EQ_ENUM(ShedLevel::DecimateTaps, shedder.level());
+    ASSERT_EQ(0u, shedder.dropped());
+}
+
+int main() {
+    std::cout << "Running Load Shedder Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/memory.hpp>
+#include "test_macros.hpp"
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using namespace dspai::comp;
+
+// Allocates `bytes` of buffer in doInitialize() through memory()
+class Buffered : public Component {
+public:
+    explicit Buffered(std::size_t bytes) : bytes_(bytes) {}
+    const ResourceArray<unsigned char>& buffer() const { return buffer_; }
+
+protected:
+    std::error_code doInitialize() noexcept override {
+        auto buffer = make_array<unsigned char>(memory(), bytes_);
+        if (!buffer) {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        buffer_ = std::move(buffer);
+        return {};
+    }
+    void doTerminate() noexcept override { buffer_.reset(); }
+    void doReset() noexcept override {}
+    bool doExecute() noexcept override { return true; }
+
+private:
+    std::size_t bytes_;
+    ResourceArray<unsigned char> buffer_;
+};
+
+// Test allocations are attributed to the component and its graph, with peaks
+TEST(memory_attribution) {
+    MemoryAccount graph("graph");
+    MemoryAccount fir("fir", &graph);
+    MemoryAccount sink("sink", &graph);
+    Buffered a(4096);
+    Buffered b(1000);
+    ASSERT_FALSE(a.set_memory_account(&fir));
+    ASSERT_FALSE(b.set_memory_account(&sink));
+    ASSERT_TRUE(a.memory_account() == &fir);
+
+    ASSERT_FALSE(a.initialize());
+    ASSERT_FALSE(b.initialize());
+    ASSERT_EQ(fir.bytes(), 4096u);
+    ASSERT_EQ(sink.bytes(), 1000u);
+    ASSERT_EQ(graph.bytes(), 5096u);
+    ASSERT_EQ(fir.allocations(), 1u);
+    ASSERT_EQ(graph.allocations(), 0u);
+    ASSERT_EQ(a.buffer()[4095], 0u);
+    ASSERT_EQ(a.set_memory_account(nullptr), std::make_error_code(std::errc::operation_not_permitted));
+
+    a.terminate();
+    ASSERT_EQ(fir.bytes(), 0u);
+    ASSERT_EQ(fir.peak(), 4096u);
+    ASSERT_EQ(graph.bytes(), 1000u);
+    ASSERT_EQ(graph.peak(), 5096u);
+    b.terminate();
+    ASSERT_EQ(graph.bytes(), 0u);
+}
+
+// Test a budget makes initialize() fail cleanly, on the component or an ancestor
+TEST(memory_budget) {
+    MemoryAccount graph("graph", nullptr, 6000);
+    MemoryAccount fir("fir", &graph, 2048);
+    MemoryAccount sink("sink", &graph);
+
+    Buffered big(4096);
+    big.set_memory_account(&fir);
+    ASSERT_EQ(big.initialize(), std::make_error_code(std::errc::not_enough_memory));
+    ASSERT_EQ_ENUM(LifecycleState::Uninitialized, big.lifecycle_state());
+    ASSERT_EQ(fir.denied(), 1u);
+    ASSERT_EQ(fir.bytes(), 0u);
+    ASSERT_EQ(graph.bytes(), 0u);
+
+    Buffered other(5000);
+    other.set_memory_account(&sink);
+    ASSERT_FALSE(other.initialize());
+    Buffered small(1024);
+    small.set_memory_account(&fir);
+    ASSERT_EQ(small.initialize(), std::make_error_code(std::errc::not_enough_memory));
+    ASSERT_EQ(graph.denied(), 1u);
+    ASSERT_EQ(fir.bytes(), 0u); // rolled back
+    ASSERT_EQ(fir.peak(), 0u);  // Denied allocations never reach a peak
+    ASSERT_EQ(graph.peak(), 5000u);
+
+    fir.set_budget(0);
+    graph.set_budget(0);
+    ASSERT_FALSE(big.initialize());
+    ASSERT_EQ(graph.bytes(), 9096u);
+}
+
+// Test pmr containers, resident pages and the footprint report
+TEST(memory_report) {
+    MemoryAccount graph("graph");
+    MemoryAccount fir("fir", &graph);
+    {
+        std::pmr::vector<double> taps(&fir);
+        taps.resize(1 << 16);
+        ASSERT_EQ(fir.bytes(), taps.capacity() * sizeof(double));
+        ASSERT_TRUE(fir.resident() >= taps.size() * sizeof(double) / 2);
+        ASSERT_EQ(graph.resident(), 0u);
+
+        const auto report = format_memory_report(graph);
+        ASSERT_TRUE(report.find("graph") != std::string::npos);
+        ASSERT_TRUE(report.find("  fir") != std::string::npos);
+        ASSERT_TRUE(report.find("process: rss") != std::string::npos);
+    }
+    ASSERT_EQ(fir.bytes(), 0u);
+    ASSERT_TRUE(fir.peak() >= (1u << 16) * sizeof(double));
+
+    {
+        MemoryAccount temporary("temporary", &graph);
+        ASSERT_TRUE(graph.first_child() == &temporary);
+    }
+    ASSERT_TRUE(graph.first_child() == &fir);
+    ASSERT_TRUE(fir.next_sibling() == nullptr);
+
+    const auto process = read_process_memory();
+    ASSERT_TRUE(process.resident > 0);
+}
+
+int main() {
+    std::cout << "Running Memory Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <dspai/comp/mpmc_queue.hpp>
+#include "test_macros.hpp"
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace dspai::comp;
+
+// Test single-threaded queue behavior
+TEST(mpmc_basics) {
+    MpmcQueue<int> queue;
+    ASSERT_FALSE(queue.try_push(1)); // Not allocated
+    ASSERT_TRUE(queue.allocate(0) == std::errc::invalid_argument);
+    ASSERT_FALSE(queue.allocate(6));
+    ASSERT_EQ(8u, queue.capacity());
+    ASSERT_TRUE(queue.empty());
+
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(queue.try_push(i));
+    }
+    ASSERT_FALSE(queue.try_push(8));
+    ASSERT_EQ(8u, queue.size());
+
+    for (int i = 0; i < 8; ++i) {
+        int value = -1;
+        ASSERT_TRUE(queue.try_pop(value));
+        ASSERT_EQ(i, value);
+    }
+    int value = -1;
+    ASSERT_FALSE(queue.try_pop(value));
+}
+
+// Test batch push/pop with partial claims
+TEST(mpmc_batches) {
+    MpmcQueue<int> queue;
+    queue.allocate(8);
+
+    std::array<int, 5> first{0, 1, 2, 3, 4};
+    std::array<int, 5> second{5, 6, 7, 8, 9};
+    ASSERT_EQ(5u, queue.push_batch(first));
+    ASSERT_EQ(3u, queue.push_batch(second)); // Only three slots free
+
+    std::array<int, 6> out{};
+    ASSERT_EQ(6u, queue.pop_batch(out));
+    ASSERT_EQ(0, out[0]);
+    ASSERT_EQ(5, out[5]);
+
+    // Wrap around the end of the slot array
+    ASSERT_EQ(5u, queue.push_batch(second));
+    std::array<int, 16> rest{};
+    ASSERT_EQ(7u, queue.pop_batch(rest));
+    ASSERT_EQ(6, rest[0]);
+    ASSERT_EQ(9, rest[6]);
+    ASSERT_EQ(0u, queue.pop_batch(rest));
+}
+
+// Test fan-in from many producers with concurrent consumers
+TEST(mpmc_threads) {
+    constexpr std::size_t producers = 8;
+    constexpr std::size_t consumers = 2;
+    constexpr std::uint64_t per_producer = 20000;
+
+    MpmcQueue<std::uint64_t> queue;
+    queue.allocate(128);
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> popped{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            std::array<std::uint64_t, 4> batch{};
+            for (std::uint64_t i = 0; i < per_producer;) {
+                const std::size_t n = std::min<std::uint64_t>(batch.size(), per_producer - i);
+                for (std::size_t k = 0; k < n; ++k) {
+                    batch[k] = p * per_producer + i + k;
+                }
+                const auto pushed = queue.push_batch(std::span<const std::uint64_t>(batch.data(), n));
+                // Retry the unpushed tail on the next iteration
+                i += pushed;
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            std::array<std::uint64_t, 16> batch{};
+            while (popped.load(std::memory_order_relaxed) < producers * per_producer) {
+                const auto n = queue.pop_batch(batch);
+                std::uint64_t local = 0;
+                for (std::size_t k = 0; k < n; ++k) {
+                    local += batch[k];
+                }
+                sum.fetch_add(local, std::memory_order_relaxed);
+                popped.fetch_add(n, std::memory_order_relaxed);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const std::uint64_t total = producers * per_producer;
+    ASSERT_EQ(total, popped.load());
+    ASSERT_EQ(total * (total - 1) / 2, sum.load());
+    ASSERT_EQ(queue.cas_retries(), queue.push_retries() + queue.pop_retries());
+    ASSERT_TRUE(queue.empty());
+}
+
+int main() {
+    std::cout << "Running MPMC Queue Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
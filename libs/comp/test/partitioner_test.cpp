@@ -0,0 +1,197 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/partitioner.hpp>
+#include "test_macros.hpp"
+#include <array>
+#include <thread>
+
+using namespace dspai::comp;
+
+// Burns a configurable amount of work per step; finishes after `steps` steps (0 = never)
+class Worker : public Component {
+public:
+    explicit Worker(std::uint32_t work = 1, std::uint64_t steps = 0) : work_(work), steps_(steps) {}
+    std::uint64_t executed() const { return executed_; }
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override { run_ = 0; }
+    bool doExecute() noexcept override {
+        for (std::uint32_t i = 0; i < work_; ++i) {
+            sink_ = sink_ * 31 + i;
+        }
+        executed_++;
+        return steps_ && ++run_ >= steps_;
+    }
+
+private:
+    std::uint32_t work_;
+    std::uint64_t steps_;
+    std::uint64_t executed_ = 0;
+    std::uint64_t run_ = 0;
+    volatile std::uint64_t sink_ = 0;
+};
+
+static NodeOptions bytes(std::size_t output_bytes) {
+    NodeOptions options;
+    options.output_bytes = output_bytes;
+    return options;
+}
+
+// Test independent nodes are balanced
+TEST(partition_balance) {
+    std::array<Worker, 4> workers;
+    Graph graph;
+    for (auto& worker : workers) {
+        graph.add(worker);
+    }
+    ASSERT_FALSE(graph.build());
+
+    const std::array<double, 4> costs = {4.0, 3.0, 2.0, 1.0};
+    PartitionConfig config;
+    config.parts = 2;
+    auto result = partition(graph, costs, config);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->parts(), 2u);
+    ASSERT_EQ(result->max_load, 5.0);
+    ASSERT_EQ(result->cut_bytes, 0.0);
+    ASSERT_EQ(result->load[0] + result->load[1], 10.0);
+
+    config.parts = 0;
+    ASSERT_EQ(partition(graph, costs, config).error(), std::make_error_code(std::errc::invalid_argument));
+    config.parts = 2;
+    const std::array<double, 1> wrong = {1.0};
+    ASSERT_EQ(partition(graph, wrong, config).error(), std::make_error_code(std::errc::invalid_argument));
+}
+
+// Test chains with heavy edges stay whole, light edges are cut for balance
+TEST(partition_traffic_tradeoff) {
+    std::array<Worker, 6> workers;
+    Graph graph;
+    for (auto& worker : workers) {
+        graph.add(worker, bytes(4096));
+    }
+    graph.connect(0, 1);
+    graph.connect(1, 2);
+    graph.connect(3, 4);
+    graph.connect(4, 5);
+    ASSERT_FALSE(graph.build());
+
+    PartitionConfig config;
+    config.parts = 2;
+    auto result = partition(graph, {}, config);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->cut_bytes, 0.0);
+    ASSERT_EQ(result->max_load, 3.0);
+    ASSERT_EQ(result->owners[0], result->owners[2]);
+    ASSERT_EQ(result->owners[3], result->owners[5]);
+    ASSERT_TRUE(result->owners[0] != result->owners[3]);
+
+    // One chain, three workers: expensive edges keep it together, free edges spread it
+    Graph chain;
+    std::array<Worker, 3> stages;
+    for (auto& stage : stages) {
+        chain.add(stage, bytes(4096));
+    }
+    chain.connect(0, 1);
+    chain.connect(1, 2);
+    ASSERT_FALSE(chain.build());
+    config.parts = 3;
+    result = partition(chain, {}, config);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->max_load, 3.0);
+    ASSERT_EQ(result->cut_bytes, 0.0);
+
+    config.traffic_cost = 0.0;
+    result = partition(chain, {}, config);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->max_load, 1.0);
+    ASSERT_EQ(result->cut_bytes, 2.0 * 4096);
+}
+
+// Test profiling measures relative cost and leaves the graph reset
+TEST(partition_profile) {
+    Worker light(10);
+    Worker heavy(20000);
+    light.initialize();
+    heavy.initialize();
+    Graph graph;
+    graph.add(light);
+    graph.add(heavy);
+    ASSERT_FALSE(graph.build());
+
+    auto costs = profile_costs(graph, 50);
+    ASSERT_TRUE(costs.has_value());
+    ASSERT_EQ(costs->size(), 2u);
+    ASSERT_TRUE((*costs)[1] > (*costs)[0]);
+    ASSERT_EQ(light.executed(), 50u);
+    ASSERT_EQ_ENUM(ExecutionState::Reset, light.execution_state());
+
+    Graph unbuilt;
+    ASSERT_EQ(profile_costs(unbuilt, 1).error(), std::make_error_code(std::errc::operation_not_permitted));
+}
+
+// Test a node that finishes early keeps its per-step cost
+TEST(partition_profile_finished) {
+    Worker steady(20000);
+    Worker early(20000, 5);
+    steady.initialize();
+    early.initialize();
+    Graph graph;
+    graph.add(steady);
+    graph.add(early);
+    ASSERT_FALSE(graph.build());
+
+    auto costs = profile_costs(graph, 200);
+    ASSERT_TRUE(costs.has_value());
+    ASSERT_EQ(early.executed(), 5u);
+    ASSERT_TRUE((*costs)[1] > 0.5 * (*costs)[0]);
+}
+
+// Test applying a partition starts a stopped executor and migrates a running one
+TEST(partition_apply) {
+    std::array<Worker, 4> workers = {Worker(1, 200), Worker(1, 200), Worker(1, 0), Worker(1, 0)};
+    Graph graph;
+    for (auto& worker : workers) {
+        worker.initialize();
+        graph.add(worker);
+    }
+    ASSERT_FALSE(graph.build());
+
+    PartitionConfig config;
+    config.parts = 2;
+    auto result = partition(graph, {}, config);
+    ASSERT_TRUE(result.has_value());
+
+    ThreadedExecutor executor(graph);
+    ASSERT_FALSE(apply_partition(executor, *result));
+    ASSERT_TRUE(executor.running());
+    for (NodeId id = 0; id < 4; ++id) {
+        ASSERT_EQ(executor.owner(id), result->owners[id]);
+    }
+
+    Partition swapped = *result;
+    for (auto& owner : swapped.owners) {
+        owner = 1 - owner;
+    }
+    ASSERT_FALSE(apply_partition(executor, swapped));
+    for (NodeId id = 0; id < 4; ++id) {
+        ASSERT_EQ(executor.owner(id), swapped.owners[id]);
+    }
+
+    Partition three = *result;
+    three.load.push_back(0.0);
+    ASSERT_EQ(apply_partition(executor, three), std::make_error_code(std::errc::invalid_argument));
+    executor.stop();
+}
+
+int main() {
+    std::cout << "Running Partitioner Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/perf_map.hpp>
+#include "test_macros.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace dspai::comp;
+
+// Counts steps; finishes after `steps`
+class Counter : public Component {
+public:
+    explicit Counter(std::uint64_t steps) : steps_(steps) {}
+    std::uint64_t executed() const { return executed_; }
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override {}
+    bool doExecute() noexcept override { return ++executed_ >= steps_; }
+
+private:
+    std::uint64_t steps_;
+    std::uint64_t executed_ = 0;
+};
+
+// Find the map line of a symbol; returns its start address (0 if absent)
+static std::uintptr_t map_entry(const std::string& symbol) {
+    std::ifstream file(PerfMap::path());
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string start;
+        std::string size;
+        std::string name;
+        fields >> start >> size >> name;
+        if (name == symbol) {
+            return static_cast<std::uintptr_t>(std::stoull(start, nullptr, 16));
+        }
+    }
+    return 0;
+}
+
+// Test nodes run through named trampolines listed in the perf map
+TEST(perf_map_annotate) {
+    if (!PerfMap::supported()) {
+        return;
+    }
+    Counter fir(3);
+    Counter sink(3);
+    fir.initialize();
+    sink.initialize();
+    Graph graph;
+    NodeOptions options;
+    options.name = "fir0";
+    graph.add(fir, options);
+    graph.add(sink);
+    graph.connect(0, 1);
+    graph.build();
+
+    {
+        PerfMap map;
+        ASSERT_FALSE(map.annotate(graph));
+        ASSERT_EQ(map.size(), 2u);
+        ASSERT_TRUE(graph.execute_hook(0) != nullptr);
+
+        const auto fir_entry = map_entry("dspai::fir0");
+        ASSERT_TRUE(fir_entry != 0);
+        ASSERT_EQ(fir_entry, reinterpret_cast<std::uintptr_t>(graph.execute_hook(0)));
+        ASSERT_EQ(map_entry("dspai::node1"), reinterpret_cast<std::uintptr_t>(graph.execute_hook(1)));
+
+        while (!graph.step()) {
+        }
+        ASSERT_EQ(fir.executed(), 3u);
+        ASSERT_EQ(sink.executed(), 3u);
+        ASSERT_EQ_ENUM(NodeStatus::Done, graph.status(0));
+
+        PerfMap::uninstall(graph);
+        ASSERT_TRUE(graph.execute_hook(0) == nullptr);
+    }
+    std::filesystem::remove(PerfMap::path());
+}
+
+// Test trampolines forward the component and its result
+TEST(perf_map_trampoline) {
+    if (!PerfMap::supported()) {
+        return;
+    }
+    PerfMap map;
+    const std::string names[] = {"a", "b"};
+    auto hooks = map.make_trampolines(names);
+    ASSERT_TRUE(hooks.has_value());
+    ASSERT_EQ(hooks->size(), 2u);
+
+    Counter counter(2);
+    counter.initialize();
+    ASSERT_FALSE((*hooks)[1](&counter));
+    ASSERT_TRUE((*hooks)[0](&counter));
+    ASSERT_EQ(counter.executed(), 2u);
+    ASSERT_TRUE(map.make_trampolines({})->empty());
+    std::filesystem::remove(PerfMap::path());
+}
+
+int main() {
+    std::cout << "Running Perf Map Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/rebalancer.hpp>
+#include "test_macros.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace dspai::comp;
+
+// Burns a fixed amount of work per step until told to finish; checks it never runs concurrently
+class Busy : public Component {
+public:
+    explicit Busy(std::atomic<bool>& finish) : finish_(finish) {}
+    bool overlapped() const { return overlapped_; }
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override {}
+    bool doExecute() noexcept override {
+        if (in_flight_.fetch_add(1) != 0) {
+            overlapped_ = true;
+        }
+        for (int i = 0; i < 2000; ++i) {
+            sink_ = sink_ * 31 + static_cast<std::uint64_t>(i);
+        }
+        in_flight_.fetch_sub(1);
+        return finish_.load();
+    }
+
+private:
+    std::atomic<bool>& finish_;
+    std::atomic<int> in_flight_{0};
+    bool overlapped_ = false;
+    volatile std::uint64_t sink_ = 0;
+};
+
+static void settle() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); }
+
+// Synthetic busy-tick counters: each update interval, every unfinished node adds `load` of the
+// interval to its current owner, so the rebalancer's decisions do not depend on how the host
+// schedules the worker threads
+struct SyntheticLoad {
+    static constexpr std::uint64_t interval = 1000;
+
+    SyntheticLoad(const ThreadedExecutor& executor, std::vector<double> load)
+        : executor(&executor), load(std::move(load)), busy(executor.workers(), 0), ticks(this->load.size(), 0) {}
+
+    bool update(Rebalancer& rebalancer) {
+        now += interval;
+        for (NodeId id = 0; id < load.size(); ++id) {
+            const auto add = static_cast<std::uint64_t>(load[id] * interval);
+            ticks[id] += add;
+            busy[executor->owner(id)] += add;
+        }
+        return rebalancer.update(now, busy, ticks);
+    }
+
+    const ThreadedExecutor* executor;
+    std::vector<double> load;
+    std::vector<std::uint64_t> busy;
+    std::vector<std::uint64_t> ticks;
+    std::uint64_t now = 0;
+};
+
+// Test an overloaded worker sheds nodes to an idle one, with sustain and cooldown
+TEST(rebalancer_moves_load) {
+    std::atomic<bool> finish{false};
+    std::array<Busy, 4> nodes = {Busy(finish), Busy(finish), Busy(finish), Busy(finish)};
+    Graph graph;
+    for (auto& node : nodes) {
+        node.initialize();
+        graph.add(node);
+    }
+    graph.build();
+
+    ThreadedExecutor executor(graph);
+    const std::array<std::size_t, 4> owners = {0, 0, 0, 0};
+    ASSERT_FALSE(executor.start(2, owners));
+
+    RebalanceConfig config;
+    config.sustain = 2;
+    config.cooldown = 2;
+    std::vector<Migration> moves;
+    Rebalancer rebalancer(executor, config, [&](const Migration& m) { moves.push_back(m); });
+    SyntheticLoad load(executor, {0.2, 0.2, 0.2, 0.2});
+
+    ASSERT_FALSE(load.update(rebalancer)); // Baseline
+    ASSERT_FALSE(load.update(rebalancer)); // First imbalanced sample
+    ASSERT_EQ(rebalancer.utilization(0), 0.8);
+    ASSERT_EQ(rebalancer.utilization(1), 0.0);
+    ASSERT_TRUE(load.update(rebalancer)); // Sustained
+    ASSERT_EQ(rebalancer.migrations(), 1u);
+    ASSERT_EQ(moves.size(), 1u);
+    ASSERT_EQ(moves[0].from, 0u);
+    ASSERT_EQ(moves[0].to, 1u);
+    ASSERT_EQ(executor.owner(moves[0].node), 1u);
+    ASSERT_EQ(moves[0].load, 0.2);
+    ASSERT_EQ(moves[0].gap, 0.8);
+
+    // 0.6 vs 0.2: still imbalanced, but nothing moves during the cooldown
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_FALSE(load.update(rebalancer));
+    }
+    ASSERT_FALSE(load.update(rebalancer)); // Sustain restarts after the cooldown
+    ASSERT_TRUE(load.update(rebalancer));
+    ASSERT_EQ(rebalancer.migrations(), 2u);
+
+    // Balanced at 0.4 / 0.4: no further moves
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_FALSE(load.update(rebalancer));
+    }
+    ASSERT_EQ(rebalancer.utilization(0), rebalancer.utilization(1));
+    std::size_t on_worker1 = 0;
+    for (NodeId id = 0; id < 4; ++id) {
+        on_worker1 += executor.owner(id) == 1;
+    }
+    ASSERT_EQ(on_worker1, 2u);
+    ASSERT_EQ(executor.migrations(), rebalancer.migrations());
+
+    // Wrong counter sizes are rejected
+    const std::array<std::uint64_t, 1> short_busy = {0};
+    ASSERT_FALSE(rebalancer.update(load.now + 1000, short_busy, load.ticks));
+
+    finish = true;
+    executor.wait();
+    for (auto& node : nodes) {
+        ASSERT_FALSE(node.overlapped()); // Live migrations never ran a node on two threads
+    }
+}
+
+// Test a single dominant node is not moved: it would only shift the imbalance
+TEST(rebalancer_single_node) {
+    std::atomic<bool> finish{false};
+    Busy node(finish);
+    node.initialize();
+    Graph graph;
+    graph.add(node);
+    graph.build();
+
+    ThreadedExecutor executor(graph);
+    ASSERT_FALSE(executor.start(2));
+    RebalanceConfig config;
+    config.sustain = 1;
+    Rebalancer rebalancer(executor, config);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_FALSE(rebalancer.update());
+        settle();
+    }
+    ASSERT_EQ(rebalancer.migrations(), 0u);
+    finish = true;
+    executor.wait();
+    ASSERT_FALSE(rebalancer.update()); // Not running
+}
+
+int main() {
+    std::cout << "Running Rebalancer Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,460 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/sender.hpp>
+#include "test_macros.hpp"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace dspai::comp;
+
+// Component that completes after a fixed number of steps
+class CountingComponent : public Component {
+public:
+    explicit CountingComponent(int steps, bool fail_init = false) : steps_(steps), fail_init_(fail_init) {}
+    int executed() const { return executed_; }
+
+protected:
+    std::error_code doInitialize() noexcept override {
+        return fail_init_ ? std::make_error_code(std::errc::io_error) : std::error_code{};
+    }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override { executed_ = 0; }
+    bool doExecute() noexcept override { return ++executed_ >= steps_; }
+
+private:
+    int steps_;
+    bool fail_init_;
+    int executed_ = 0;
+};
+
+// Receiver recording how the operation completed
+struct Result {
+    int value_calls = 0;
+    int error_calls = 0;
+    int stopped_calls = 0;
+    std::uint64_t value = 0;
+    std::error_code error;
+    bool done() const { return value_calls + error_calls + stopped_calls > 0; }
+};
+
+struct TestReceiver {
+    using receiver_concept = exec::receiver_t;
+    Result* result;
+
+    void set_value() && noexcept { result->value_calls++; }
+    void set_value(std::uint64_t value) && noexcept {
+        result->value_calls++;
+        result->value = value;
+    }
+    void set_error(std::error_code ec) && noexcept {
+        result->error_calls++;
+        result->error = ec;
+    }
+    void set_stopped() && noexcept { result->stopped_calls++; }
+};
+
+// Single-threaded event loop scheduler: work runs only when the loop is pumped
+class ManualLoop {
+public:
+    struct Task {
+        virtual void run() noexcept = 0;
+        virtual ~Task() = default;
+    };
+
+    class Scheduler {
+    public:
+        using scheduler_concept = exec::scheduler_t;
+
+        class Sender {
+        public:
+            using sender_concept = exec::sender_t;
+            using completion_signatures = exec::completion_signatures<exec::set_value_t()>;
+
+            template <typename Receiver>
+            struct Operation : Task {
+                using operation_state_concept = exec::operation_state_t;
+                Operation(ManualLoop* loop, Receiver receiver) : loop(loop), receiver(std::move(receiver)) {}
+                ManualLoop* loop;
+                Receiver receiver;
+                void start() & noexcept { loop->tasks_.push_back(this); }
+                void run() noexcept override { std::move(receiver).set_value(); }
+            };
+
+            template <typename Receiver>
+            Operation<Receiver> connect(Receiver receiver) const {
+                return Operation<Receiver>(loop_, std::move(receiver));
+            }
+
+            ManualLoop* loop_;
+        };
+
+        Sender schedule() const noexcept { return Sender{loop_}; }
+        bool operator==(const Scheduler&) const noexcept = default;
+
+        ManualLoop* loop_;
+    };
+
+    Scheduler scheduler() { return Scheduler{this}; }
+
+    bool run_one() {
+        if (tasks_.empty()) {
+            return false;
+        }
+        Task* task = tasks_.front();
+        tasks_.pop_front();
+        task->run();
+        return true;
+    }
+
+    std::size_t pending() const { return tasks_.size(); }
+
+private:
+    std::deque<Task*> tasks_;
+};
+
+// Scheduler completing on a worker thread
+class ThreadScheduler {
+public:
+    struct Task {
+        virtual void run() noexcept = 0;
+        virtual ~Task() = default;
+    };
+
+    struct Context {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<Task*> tasks;
+        bool stop = false;
+        std::thread worker;
+
+        Context() : worker([this] { loop(); }) {}
+        ~Context() {
+            {
+                std::lock_guard lock(mutex);
+                stop = true;
+            }
+            cv.notify_one();
+            worker.join();
+        }
+
+        void push(Task* task) {
+            {
+                std::lock_guard lock(mutex);
+                tasks.push_back(task);
+            }
+            cv.notify_one();
+        }
+
+        void loop() {
+            for (;;) {
+                Task* task = nullptr;
+                {
+                    std::unique_lock lock(mutex);
+                    cv.wait(lock, [&] { return stop || !tasks.empty(); });
+                    if (tasks.empty()) {
+                        return;
+                    }
+                    task = tasks.front();
+                    tasks.pop_front();
+                }
+                task->run();
+            }
+        }
+    };
+
+    using scheduler_concept = exec::scheduler_t;
+
+    class Sender {
+    public:
+        using sender_concept = exec::sender_t;
+        using completion_signatures = exec::completion_signatures<exec::set_value_t()>;
+
+        template <typename Receiver>
+        struct Operation : Task {
+            using operation_state_concept = exec::operation_state_t;
+            Operation(Context* context, Receiver receiver) : context(context), receiver(std::move(receiver)) {}
+            Context* context;
+            Receiver receiver;
+            void start() & noexcept { context->push(this); }
+            void run() noexcept override { std::move(receiver).set_value(); }
+        };
+
+        template <typename Receiver>
+        Operation<Receiver> connect(Receiver receiver) const {
+            return Operation<Receiver>(context_, std::move(receiver));
+        }
+
+        Context* context_;
+    };
+
+    Sender schedule() const noexcept { return Sender{context_}; }
+    bool operator==(const ThreadScheduler&) const noexcept = default;
+
+    Context* context_;
+};
+
+// Receiver signalling completion to a waiting thread
+struct SignalReceiver {
+    using receiver_concept = exec::receiver_t;
+    std::mutex* mutex;
+    std::condition_variable* cv;
+    bool* finished;
+    std::uint64_t* count;
+
+    void complete(std::uint64_t value) noexcept {
+        std::lock_guard lock(*mutex);
+        *count = value;
+        *finished = true;
+        cv->notify_one();
+    }
+    void set_value(std::uint64_t value) && noexcept { complete(value); }
+    void set_error(std::error_code) && noexcept { complete(0); }
+    void set_stopped() && noexcept { complete(0); }
+};
+
+// Test lifecycle senders
+TEST(lifecycle_senders) {
+    CountingComponent component(3);
+
+    Result init;
+    auto op1 = exec::initialize(component).connect(TestReceiver{&init});
+    ASSERT_FALSE(init.done()); // Lazy: nothing happens until start()
+    op1.start();
+    ASSERT_EQ(1, init.value_calls);
+    ASSERT_EQ_ENUM(LifecycleState::Initialized, component.lifecycle_state());
+
+    // Second initialize reports the error through set_error
+    Result again;
+    auto op2 = exec::initialize(component).connect(TestReceiver{&again});
+    op2.start();
+    ASSERT_EQ(1, again.error_calls);
+    ASSERT_TRUE(again.error == std::errc::operation_not_permitted);
+
+    component.execute();
+    Result reset;
+    auto op3 = exec::reset(component).connect(TestReceiver{&reset});
+    op3.start();
+    ASSERT_EQ(1, reset.value_calls);
+    ASSERT_EQ_ENUM(ExecutionState::Reset, component.execution_state());
+
+    Result term;
+    auto op4 = exec::terminate(component).connect(TestReceiver{&term});
+    op4.start();
+    ASSERT_EQ(1, term.value_calls);
+    ASSERT_EQ_ENUM(LifecycleState::Terminated, component.lifecycle_state());
+}
+
+// Test failed initialization
+TEST(initialize_failure) {
+    CountingComponent component(3, true);
+    Result result;
+    auto op = exec::initialize(component).connect(TestReceiver{&result});
+    op.start();
+    ASSERT_EQ(1, result.error_calls);
+    ASSERT_TRUE(result.error == std::errc::io_error);
+}
+
+// Test run() on the inline scheduler (deep runs must not grow the stack)
+TEST(run_inline) {
+    CountingComponent component(100000);
+    component.initialize();
+
+    Result result;
+    auto op = exec::run(component, exec::InlineScheduler{}).connect(TestReceiver{&result});
+    op.start();
+    ASSERT_EQ(1, result.value_calls);
+    ASSERT_EQ(100000u, result.value);
+    ASSERT_EQ_ENUM(ExecutionState::Done, component.execution_state());
+}
+
+// Test two components time-sliced on one event loop thread
+TEST(run_interleaved_on_loop) {
+    ManualLoop loop;
+    CountingComponent a(4);
+    CountingComponent b(6);
+    a.initialize();
+    b.initialize();
+
+    Result ra, rb;
+    auto op_a = exec::run(a, loop.scheduler()).connect(TestReceiver{&ra});
+    auto op_b = exec::run(b, loop.scheduler(), 2).connect(TestReceiver{&rb});
+    op_a.start();
+    op_b.start();
+    ASSERT_EQ(0, a.executed()); // Nothing runs until the loop is pumped
+    ASSERT_EQ(2u, loop.pending());
+
+    loop.run_one();
+    loop.run_one();
+    ASSERT_EQ(1, a.executed());
+    ASSERT_EQ(2, b.executed()); // Two steps per slice
+
+    while (loop.run_one()) {
+    }
+    ASSERT_EQ(1, ra.value_calls);
+    ASSERT_EQ(4u, ra.value);
+    ASSERT_EQ(1, rb.value_calls);
+    ASSERT_EQ(6u, rb.value);
+}
+
+// Test run() on a worker thread scheduler
+TEST(run_on_thread) {
+    // Declared before the worker context so they outlive the worker thread
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool finished = false;
+    std::uint64_t count = 0;
+
+    ThreadScheduler::Context context;
+    CountingComponent component(1000);
+    component.initialize();
+
+    auto op = exec::run(component, ThreadScheduler{&context}, 10)
+                  .connect(SignalReceiver{&mutex, &cv, &finished, &count});
+    op.start();
+    {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&] { return finished; });
+    }
+    ASSERT_EQ(1000u, count);
+}
+
+// Test run() on a component that is not initialized
+TEST(run_not_initialized) {
+    CountingComponent component(3);
+    Result result;
+    auto op = exec::run(component, exec::InlineScheduler{}).connect(TestReceiver{&result});
+    op.start();
+    ASSERT_EQ(1, result.error_calls);
+    ASSERT_TRUE(result.error == std::errc::operation_not_permitted);
+}
+
+// Component that fails on its third step
+class FailingComponent : public Component {
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override { steps_ = 0; }
+    bool doExecute() noexcept override {
+        if (++steps_ == 3) {
+            fail(std::make_error_code(std::errc::value_too_large));
+        }
+        return false;
+    }
+
+private:
+    int steps_ = 0;
+};
+
+// Test run() reports a failed step through set_error
+TEST(run_failure) {
+    FailingComponent component;
+    component.initialize();
+    Result result;
+    auto op = exec::run(component, exec::InlineScheduler{}).connect(TestReceiver{&result});
+    op.start();
+    ASSERT_EQ(1, result.error_calls);
+    ASSERT_TRUE(result.error == std::errc::value_too_large);
+}
+
+// Inline scheduler whose first `values` schedules succeed; later ones stop or fail inline
+struct EndingScheduler {
+    using scheduler_concept = exec::scheduler_t;
+    int* values;
+    bool fail;
+
+    struct Sender {
+        using sender_concept = exec::sender_t;
+        using completion_signatures =
+            exec::completion_signatures<exec::set_value_t(), exec::set_error_t(std::error_code), exec::set_stopped_t()>;
+        int* values;
+        bool fail;
+
+        template <typename Receiver>
+        struct Operation {
+            using operation_state_concept = exec::operation_state_t;
+            int* values;
+            bool fail;
+            Receiver receiver;
+            void start() & noexcept {
+                if ((*values)-- > 0) {
+                    std::move(receiver).set_value();
+                } else if (fail) {
+                    std::move(receiver).set_error(std::make_error_code(std::errc::connection_aborted));
+                } else {
+                    std::move(receiver).set_stopped();
+                }
+            }
+        };
+
+        template <typename Receiver>
+        Operation<std::remove_cvref_t<Receiver>> connect(Receiver&& receiver) const {
+            return {values, fail, std::forward<Receiver>(receiver)};
+        }
+    };
+
+    Sender schedule() const noexcept { return {values, fail}; }
+    bool operator==(const EndingScheduler&) const noexcept = default;
+};
+
+// Receiver that destroys its own operation state on completion (as a detached start does)
+struct DestroyingReceiver {
+    using receiver_concept = exec::receiver_t;
+    Result* result;
+    std::function<void()>* destroy;
+
+    void set_value(std::uint64_t value) && noexcept {
+        result->value_calls++;
+        result->value = value;
+        (*destroy)();
+    }
+    void set_error(std::error_code ec) && noexcept {
+        result->error_calls++;
+        result->error = ec;
+        (*destroy)();
+    }
+    void set_stopped() && noexcept {
+        result->stopped_calls++;
+        (*destroy)();
+    }
+};
+
+// Test inline stopped/error slice completions may destroy the operation (checked under ASan)
+TEST(run_inline_stop_destroys_operation) {
+    for (bool fail : {false, true}) {
+        CountingComponent component(100);
+        component.initialize();
+        int values = 3;
+        Result result;
+        std::function<void()> destroy;
+
+        auto sender = exec::run(component, EndingScheduler{&values, fail});
+        using Operation = decltype(sender.connect(std::declval<DestroyingReceiver>()));
+        std::unique_ptr<Operation> op(new Operation(sender.connect(DestroyingReceiver{&result, &destroy})));
+        destroy = [&op] { op.reset(); };
+        op->start();
+
+        ASSERT_TRUE(op == nullptr);
+        ASSERT_EQ(3, component.executed());
+        ASSERT_EQ(fail ? 0 : 1, result.stopped_calls);
+        ASSERT_EQ(fail ? 1 : 0, result.error_calls);
+        ASSERT_EQ(0, result.value_calls);
+        if (fail) {
+            ASSERT_TRUE(result.error == std::errc::connection_aborted);
+        }
+    }
+}
+
+int main() {
+    std::cout << "Running Sender Adapter Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
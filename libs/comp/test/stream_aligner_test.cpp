@@ -0,0 +1,310 @@
+#include <dspai/comp/stream_aligner.hpp>
+#include "test_macros.hpp"
+#include <memory>
+#include <vector>
+
+using namespace dspai::comp;
+
+// Set of input streams whose sample values equal their common-clock time
+struct Streams {
+    explicit Streams(std::size_t n) : samples(n), tags(n), next_time(n, 0) {
+        for (std::size_t s = 0; s < n; ++s) {
+            samples[s] = std::make_unique<SpscRing<float>>();
+            tags[s] = std::make_unique<TagRing>();
+            samples[s]->allocate(64);
+            tags[s]->allocate(8);
+        }
+    }
+
+    std::vector<AlignerInput<float>> inputs() {
+        std::vector<AlignerInput<float>> result;
+        for (std::size_t s = 0; s < samples.size(); ++s) {
+            result.push_back({samples[s].get(), tags[s].get()});
+        }
+        return result;
+    }
+
+    // Stamp stream s: its next written sample has common-clock time `time`
+    void stamp(std::size_t s, std::uint64_t time) {
+        tags[s]->try_push(make_tag(written[s], TagKey::Timestamp, time));
+        next_time[s] = time;
+    }
+
+    void write(std::size_t s, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            samples[s]->try_push(static_cast<float>(next_time[s]++));
+        }
+        written[s] += n;
+    }
+
+    std::vector<std::unique_ptr<SpscRing<float>>> samples;
+    std::vector<std::unique_ptr<TagRing>> tags;
+    std::vector<std::uint64_t> next_time;
+    std::vector<std::uint64_t> written = std::vector<std::uint64_t>(samples.size(), 0);
+};
+
+// Test alignment of early, on-time and late streams
+TEST(align_planar) {
+    Streams streams(3);
+    StreamAligner<float> aligner(streams.inputs(), {.block_size = 8, .start_time = 100});
+    ASSERT_FALSE(aligner.initialize());
+
+    // No timestamps yet: no output
+    aligner.execute();
+    ASSERT_FALSE(aligner.has_output());
+
+    streams.stamp(0, 100); // On time
+    streams.stamp(1, 96);  // 4 samples behind
+    streams.stamp(2, 103); // 3 samples ahead
+    streams.write(0, 8);
+    streams.write(1, 12);
+    streams.write(2, 5);
+
+    aligner.execute();
+    ASSERT_TRUE(aligner.has_output());
+    ASSERT_EQ(100u, aligner.block_time());
+    for (std::size_t s = 0; s < 3; ++s) {
+        auto block = aligner.planar(s);
+        ASSERT_EQ(8u, block.size());
+        for (std::size_t i = 0; i < 8; ++i) {
+            const float expected = (s == 2 && i < 3) ? 0.0f : static_cast<float>(100 + i);
+            ASSERT_EQ(expected, block[i]);
+        }
+    }
+    ASSERT_TRUE(aligner.is_zero_copy(0));
+    ASSERT_FALSE(aligner.is_zero_copy(1));
+    ASSERT_EQ(4u, aligner.stats(1).dropped);
+    ASSERT_EQ(3u, aligner.stats(2).padded);
+
+    // Next block waits for all streams
+    streams.write(0, 8);
+    streams.write(1, 8);
+    aligner.execute();
+    ASSERT_FALSE(aligner.has_output());
+    streams.write(2, 8);
+    aligner.execute();
+    ASSERT_TRUE(aligner.has_output());
+    ASSERT_EQ(108u, aligner.block_time());
+    ASSERT_TRUE(aligner.is_zero_copy(1)); // Aligned now
+    ASSERT_EQ(108.0f, aligner.planar(1)[0]);
+    ASSERT_EQ(115.0f, aligner.planar(2)[7]);
+    ASSERT_EQ(2u, aligner.blocks());
+}
+
+// Test interleaved output and default start time
+TEST(align_interleaved) {
+    Streams streams(2);
+    StreamAligner<float> aligner(streams.inputs(), {.block_size = 4, .layout = MergeLayout::Interleaved, .start_time = std::nullopt});
+    aligner.initialize();
+
+    streams.stamp(0, 10);
+    streams.stamp(1, 12); // Latest first timestamp: output starts at 12
+    streams.write(0, 8);
+    streams.write(1, 4);
+
+    aligner.execute();
+    ASSERT_TRUE(aligner.has_output());
+    ASSERT_EQ(12u, aligner.block_time());
+    auto block = aligner.interleaved();
+    ASSERT_EQ(8u, block.size());
+    for (std::size_t i = 0; i < 4; ++i) {
+        ASSERT_EQ(static_cast<float>(12 + i), block[2 * i]);
+        ASSERT_EQ(static_cast<float>(12 + i), block[2 * i + 1]);
+    }
+    ASSERT_TRUE(aligner.planar(0).empty());
+}
+
+// Test a timestamp discontinuity inside a block
+TEST(align_timestamp_jump) {
+    Streams streams(1);
+    StreamAligner<float> aligner(streams.inputs(), {.block_size = 8, .start_time = 0});
+    aligner.initialize();
+
+    streams.stamp(0, 0);
+    streams.write(0, 3);
+    streams.stamp(0, 5); // Gap of 2 samples in the source
+    streams.write(0, 5);
+
+    aligner.execute();
+    ASSERT_TRUE(aligner.has_output());
+    auto block = aligner.planar(0);
+    ASSERT_EQ(2.0f, block[2]);
+    ASSERT_EQ(0.0f, block[3]);
+    ASSERT_EQ(0.0f, block[4]);
+    ASSERT_EQ(5.0f, block[5]);
+    ASSERT_EQ(7.0f, block[7]);
+    ASSERT_EQ(2u, aligner.stats(0).padded);
+}
+
+// Test that a dead stream is padded after the stall limit
+TEST(align_stall_limit) {
+    Streams streams(2);
+    StreamAligner<float> aligner(streams.inputs(), {.block_size = 4, .stall_limit = 2, .start_time = 0});
+    aligner.initialize();
+
+    streams.stamp(0, 0);
+    streams.stamp(1, 0);
+    streams.write(0, 4);
+    streams.write(1, 1);
+
+    aligner.execute();
+    aligner.execute();
+    ASSERT_FALSE(aligner.has_output());
+    aligner.execute();
+    ASSERT_TRUE(aligner.has_output());
+    ASSERT_EQ(0.0f, aligner.planar(1)[0]);
+    ASSERT_EQ(0.0f, aligner.planar(1)[3]);
+    ASSERT_EQ(3u, aligner.stats(1).padded);
+
+    // Late data for the padded times is dropped
+    streams.write(0, 4);
+    streams.write(1, 7);
+    aligner.execute();
+    ASSERT_TRUE(aligner.has_output());
+    ASSERT_EQ(4.0f, aligner.planar(1)[0]);
+    ASSERT_EQ(3u, aligner.stats(1).dropped);
+}
+
+// Test that a stream that never gets a timestamp does not hold back the start
+TEST(align_stall_limit_startup) {
+    Streams streams(2);
+    StreamAligner<float> aligner(streams.inputs(), {.block_size = 4, .stall_limit = 2, .start_time = {}});
+    aligner.initialize();
+
+    streams.stamp(0, 50);
+    streams.write(0, 8);
+    streams.write(1, 6); // Samples without a timestamp
+
+    aligner.execute();
+    aligner.execute();
+    ASSERT_FALSE(aligner.has_output());
+    aligner.execute();
+    ASSERT_TRUE(aligner.has_output());
+    ASSERT_EQ(50u, aligner.block_time());
+    ASSERT_EQ(50.0f, aligner.planar(0)[0]);
+    ASSERT_EQ(0.0f, aligner.planar(1)[0]);
+    ASSERT_EQ(4u, aligner.stats(1).padded);
+    ASSERT_EQ(6u, aligner.stats(1).dropped);
+    ASSERT_EQ(0u, streams.samples[1]->size()); // Untimed samples do not back up
+
+    // The stream joins once its first timestamp arrives
+    streams.stamp(1, 54);
+    streams.write(1, 4);
+    aligner.execute();
+    ASSERT_TRUE(aligner.has_output());
+    ASSERT_EQ(54.0f, aligner.planar(0)[0]);
+    ASSERT_EQ(54.0f, aligner.planar(1)[0]);
+    ASSERT_EQ(57.0f, aligner.planar(1)[3]);
+}
+
+// Test that a dead stream is padded on every block once stalled out, not once per stall_limit
+TEST(align_dead_stream) {
+    constexpr std::size_t n = 4;
+    constexpr std::size_t limit = 3;
+    constexpr std::size_t calls = 40;
+    Streams streams(n);
+    StreamAligner<float> aligner(streams.inputs(), {.block_size = 4, .stall_limit = limit, .start_time = 0});
+    aligner.initialize();
+    for (std::size_t s = 0; s < n; ++s) {
+        streams.stamp(s, 0);
+    }
+
+    // Stream n - 1 dies after its first sample
+    streams.write(n - 1, 1);
+    std::uint64_t blocks = 0;
+    for (std::size_t call = 0; call < calls; ++call) {
+        for (std::size_t s = 0; s + 1 < n; ++s) {
+            streams.write(s, 4);
+        }
+        aligner.execute();
+        blocks += aligner.has_output() ? 1 : 0;
+    }
+    ASSERT_EQ(blocks, calls - limit);
+    ASSERT_EQ(aligner.stats(n - 1).padded, 4 * blocks - 1);
+    for (std::size_t s = 0; s + 1 < n; ++s) {
+        // Live streams keep up: only the startup wait and the viewed block stay queued
+        ASSERT_EQ(4 * (limit + 1), streams.samples[s]->size());
+    }
+
+    // The stream recovers once it covers a block again
+    streams.stamp(n - 1, 4 * blocks);
+    streams.write(n - 1, 4);
+    for (std::size_t s = 0; s + 1 < n; ++s) {
+        streams.write(s, 4);
+    }
+    aligner.execute();
+    ASSERT_TRUE(aligner.has_output());
+    ASSERT_EQ(static_cast<float>(4 * blocks), aligner.planar(n - 1)[0]);
+    ASSERT_EQ(static_cast<float>(4 * blocks), aligner.planar(0)[0]);
+    ASSERT_EQ(4 * blocks - 1, aligner.stats(n - 1).padded);
+}
+
+// Test many streams per instance
+TEST(align_many_streams) {
+    constexpr std::size_t n = 72;
+    Streams streams(n);
+    StreamAligner<float> aligner(streams.inputs(), {.block_size = 16, .start_time = 1000});
+    ASSERT_FALSE(aligner.initialize());
+
+    for (std::size_t s = 0; s < n; ++s) {
+        streams.stamp(s, 1000 - s % 8); // Latency spread of 8 samples
+        streams.write(s, 32);
+    }
+    aligner.execute();
+    ASSERT_TRUE(aligner.has_output());
+    for (std::size_t s = 0; s < n; ++s) {
+        ASSERT_EQ(1000.0f, aligner.planar(s)[0]);
+        ASSERT_EQ(1015.0f, aligner.planar(s)[15]);
+    }
+
+    // Reset restarts the output clock from the streams' current timing
+    aligner.reset();
+    ASSERT_EQ(0u, aligner.blocks());
+    for (std::size_t s = 0; s < n; ++s) {
+        streams.write(s, 16);
+    }
+    aligner.execute();
+    ASSERT_TRUE(aligner.has_output());
+    ASSERT_EQ(1016u, aligner.block_time());
+}
+
+// Test per-stream state and scratch are both charged to the memory account
+TEST(align_memory_account) {
+    constexpr std::size_t n = 4;
+    const std::size_t scratch = 16 * n * sizeof(float);
+    Streams streams(n);
+    MemoryAccount account("aligner");
+    StreamAligner<float> aligner(streams.inputs(), {.block_size = 16, .start_time = 0});
+    ASSERT_FALSE(aligner.set_memory_account(&account));
+    ASSERT_FALSE(aligner.initialize());
+    ASSERT_TRUE(account.bytes() > scratch);
+    aligner.terminate();
+    ASSERT_EQ(account.bytes(), 0u);
+
+    // A budget covering only the scratch leaves no room for the stream state
+    MemoryAccount tight("tight", nullptr, scratch);
+    StreamAligner<float> bounded(streams.inputs(), {.block_size = 16, .start_time = 0});
+    ASSERT_FALSE(bounded.set_memory_account(&tight));
+    ASSERT_TRUE(bounded.initialize() == std::errc::not_enough_memory);
+    ASSERT_EQ(tight.bytes(), 0u);
+}
+
+// Test invalid configuration
+TEST(align_invalid_config) {
+    StreamAligner<float> empty({}, {});
+    ASSERT_TRUE(empty.initialize() == std::errc::invalid_argument);
+
+    StreamAligner<float> null_input({AlignerInput<float>{}}, {});
+    ASSERT_TRUE(null_input.initialize() == std::errc::invalid_argument);
+}
+
+int main() {
+    std::cout << "Running Stream Aligner Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
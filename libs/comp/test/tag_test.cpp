@@ -0,0 +1,205 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/tag.hpp>
+#include "test_macros.hpp"
+#include <array>
+#include <thread>
+#include <vector>
+
+using namespace dspai::comp;
+
+// Decimate-by-N component that forwards tags with rescaled offsets
+class Decimator : public Component {
+public:
+    Decimator(SpscRing<float>& in, TagRing& in_tags, SpscRing<float>& out, TagRing& out_tags, std::uint32_t factor)
+        : in_(in), out_(out), tags_in_(in_tags), tags_out_(out_tags), factor_(factor) {}
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override { consumed_ = 0; }
+
+    bool doExecute() noexcept override {
+        auto block = in_.readable();
+        const std::size_t n = block.size() - block.size() % factor_;
+        for (std::size_t i = 0; i < n; i += factor_) {
+            out_.try_push(block[i]);
+        }
+        in_.consume(n);
+        consumed_ += n;
+        tags_in_.propagate(consumed_, tags_out_, RateRatio{1, factor_});
+        return n == 0;
+    }
+
+private:
+    SpscRing<float>& in_;
+    SpscRing<float>& out_;
+    TagInput tags_in_;
+    TagOutput tags_out_;
+    std::uint32_t factor_;
+    std::uint64_t consumed_ = 0;
+};
+
+// Test SPSC ring basics
+TEST(spsc_ring_basics) {
+    SpscRing<int> ring;
+    ASSERT_FALSE(ring.try_push(1)); // Not allocated
+    ASSERT_TRUE(ring.allocate(0) == std::errc::invalid_argument);
+    ASSERT_FALSE(ring.allocate(5));
+    ASSERT_EQ(8u, ring.capacity());
+    ASSERT_TRUE(ring.empty());
+
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(ring.try_push(i));
+    }
+    ASSERT_FALSE(ring.try_push(8)); // Full
+    ASSERT_EQ(8u, ring.size());
+
+    int value = -1;
+    ASSERT_TRUE(ring.try_pop(value));
+    ASSERT_EQ(0, value);
+
+    // Bulk write wraps around the end of the buffer
+    std::array<int, 3> values{10, 11, 12};
+    ASSERT_EQ(1u, ring.write(values));
+    std::array<int, 16> out{};
+    ASSERT_EQ(8u, ring.read(out));
+    ASSERT_EQ(1, out[0]);
+    ASSERT_EQ(10, out[7]);
+    ASSERT_TRUE(ring.empty());
+
+    ASSERT_EQ(3u, ring.write(values));
+    ASSERT_EQ(3u, ring.read(out));
+    ASSERT_EQ(12, out[2]);
+}
+
+// Test SPSC ring across threads
+TEST(spsc_ring_threads) {
+    SpscRing<std::uint64_t> ring;
+    ring.allocate(64);
+    constexpr std::uint64_t count = 100000;
+
+    std::thread producer([&] {
+        for (std::uint64_t i = 0; i < count;) {
+            if (ring.try_push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::uint64_t expected = 0;
+    while (expected < count) {
+        std::uint64_t value;
+        if (ring.try_pop(value)) {
+            ASSERT_EQ(expected, value);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    ASSERT_TRUE(ring.empty());
+}
+
+// Test tag payloads and offset rescaling
+TEST(tag_payload_and_rescale) {
+    auto tag = make_tag(100, TagKey::Frequency, 2.5e9);
+    ASSERT_EQ(2.5e9, tag.as_double());
+    ASSERT_EQ(24u, sizeof(Tag));
+
+    ASSERT_EQ(25u, (RateRatio{1, 4}.rescale(100)));
+    ASSERT_EQ(25u, (RateRatio{1, 4}.rescale(103)));
+    ASSERT_EQ(300u, (RateRatio{3, 1}.rescale(100)));
+    ASSERT_EQ(150u, (RateRatio{3, 2}.rescale(100)));
+    const std::uint64_t big = std::uint64_t{1} << 62;
+    ASSERT_EQ(big / 2 * 3, (RateRatio{3, 2}.rescale(big)));
+}
+
+// Test take() only consumes tags inside the processed block
+TEST(tag_take_by_offset) {
+    TagRing ring;
+    ring.allocate(4);
+    TagOutput out(ring);
+    TagInput in(ring);
+
+    ASSERT_TRUE(out.post(make_tag(5, TagKey::BurstStart)));
+    ASSERT_TRUE(out.post(make_tag(12, TagKey::BurstEnd)));
+
+    std::vector<Tag> seen;
+    ASSERT_EQ(0u, in.take(5, [&](const Tag& t) { seen.push_back(t); }));
+    ASSERT_EQ(1u, in.take(10, [&](const Tag& t) { seen.push_back(t); }));
+    ASSERT_EQ(5u, seen[0].offset);
+    ASSERT_EQ(12u, in.peek()->offset);
+    ASSERT_EQ(1u, in.take(13, [&](const Tag& t) { seen.push_back(t); }));
+    ASSERT_TRUE(in.peek() == nullptr);
+
+    // Overflow is counted, not blocking
+    for (int i = 0; i < 5; ++i) {
+        out.post(make_tag(20 + i, TagKey::User));
+    }
+    ASSERT_EQ(1u, out.dropped());
+
+    // Unbound ports are no-ops
+    TagOutput unbound;
+    ASSERT_FALSE(unbound.post(make_tag(0, TagKey::User)));
+    TagInput unbound_in;
+    ASSERT_EQ(0u, unbound_in.take(100, [](const Tag&) {}));
+}
+
+// Test tags propagated through a rate-changing component
+TEST(tag_propagate_through_decimator) {
+    SpscRing<float> in, out;
+    TagRing in_tags, out_tags;
+    in.allocate(64);
+    out.allocate(64);
+    in_tags.allocate(8);
+    out_tags.allocate(8);
+
+    Decimator decimator(in, in_tags, out, out_tags, 4);
+    decimator.initialize();
+
+    std::array<float, 32> samples{};
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<float>(i);
+    }
+    TagOutput source(in_tags);
+    source.post(make_tag(8, TagKey::Timestamp, std::uint64_t{1234}));
+    source.post(make_tag(21, TagKey::BurstStart));
+    source.post(make_tag(40, TagKey::BurstEnd)); // Beyond the first block
+
+    in.write(std::span<const float>(samples.data(), 24));
+    decimator.execute();
+
+    TagInput sink(out_tags);
+    std::vector<Tag> seen;
+    sink.take(~std::uint64_t{0}, [&](const Tag& t) { seen.push_back(t); });
+    ASSERT_EQ(2u, seen.size());
+    ASSERT_EQ(2u, seen[0].offset);
+    ASSERT_EQ(1234u, seen[0].value);
+    ASSERT_EQ(5u, seen[1].offset);
+
+    // Tagged samples line up with the decimated stream
+    std::array<float, 8> decimated{};
+    ASSERT_EQ(6u, out.read(decimated));
+    ASSERT_EQ(8.0f, decimated[seen[0].offset]);
+    ASSERT_EQ(20.0f, decimated[seen[1].offset]);
+
+    in.write(std::span<const float>(samples.data() + 24, 8));
+    in.write(std::span<const float>(samples.data(), 12));
+    decimator.execute();
+    sink.take(~std::uint64_t{0}, [&](const Tag& t) { seen.push_back(t); });
+    ASSERT_EQ(3u, seen.size());
+    ASSERT_EQ(10u, seen[2].offset);
+}
+
+int main() {
+    std::cout << "Running Stream Tag Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+
+// Test helper macros
+#define TEST(name) void test_##name(); \
+    static struct test_##name##_runner { \
+        test_##name##_runner() { \
+            std::cout << "Running: " #name << "... "; \
+            test_##name(); \
+            std::cout << "PASSED\n"; \
+        } \
+    } test_##name##_instance; \
+    void test_##name()
+
+#define ASSERT_EQ_ENUM(expected, actual) \
+    if ((expected) != (actual)) { \
+        std::cerr << "\nAssertion failed: " << #expected << " != " << #actual \
+                  << "\n  Expected: " << static_cast<int>(expected) \
+                  << "\n  Actual: " << static_cast<int>(actual) \
+                  << "\n  At: " << __FILE__ << ":" << __LINE__ << "\n"; \
+        std::exit(1); \
+    }
+
+#define ASSERT_EQ(expected, actual) \
+    if ((expected) != (actual)) { \
+        std::cerr << "\nAssertion failed: " << #expected << " != " << #actual \
+                  << "\n  Expected: " << (expected) \
+                  << "\n  Actual: " << (actual) \
+                  << "\n  At: " << __FILE__ << ":" << __LINE__ << "\n"; \
+        std::exit(1); \
+    }
+
+#define ASSERT_TRUE(condition) \
+    if (!(condition)) { \
+        std::cerr << "\nAssertion failed: " << #condition \
+                  << " is false\n  At: " << __FILE__ << ":" << __LINE__ << "\n"; \
+        std::exit(1); \
+    }
+
+#define ASSERT_FALSE(condition) \
+    if (condition) { \
+        std::cerr << "\nAssertion failed: " << #condition \
+                  << " is true\n  At: " << __FILE__ << ":" << __LINE__ << "\n"; \
+        std::exit(1); \
+    }
@@ -0,0 +1,218 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/timed_command.hpp>
+#include "test_macros.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace dspai::comp;
+
+struct SetGain {
+    float gain = 1.0f;
+};
+
+// Gain stage that applies scheduled gain changes on exact samples
+class GainComponent : public Component {
+public:
+    static constexpr std::size_t block_size = 16;
+
+    TimedCommandQueue<SetGain>& commands() { return commands_; }
+    const std::array<float, block_size>& output() const { return output_; }
+    std::size_t segments() const { return segments_; }
+
+protected:
+    std::error_code doInitialize() noexcept override { return commands_.allocate(8); }
+    void doTerminate() noexcept override { commands_.deallocate(); }
+    void doReset() noexcept override {
+        commands_.reset();
+        gain_ = 1.0f;
+    }
+
+    bool doExecute() noexcept override {
+        commands_.run(
+            block_size, [&](const SetGain& cmd) { gain_ = cmd.gain; },
+            [&](std::size_t offset, std::size_t count) {
+                segments_++;
+                for (std::size_t i = offset; i < offset + count; ++i) {
+                    output_[i] = gain_;
+                }
+            });
+        return false;
+    }
+
+private:
+    TimedCommandQueue<SetGain> commands_;
+    std::array<float, block_size> output_{};
+    float gain_ = 1.0f;
+    std::size_t segments_ = 0;
+};
+
+// Test a command splitting a block on the exact sample
+TEST(command_splits_block) {
+    GainComponent component;
+    ASSERT_FALSE(component.initialize());
+    ASSERT_TRUE(component.commands().schedule(21, SetGain{2.0f}));
+
+    component.execute(); // Samples 0..15: unaffected
+    ASSERT_EQ(1u, component.segments());
+    ASSERT_EQ(1.0f, component.output()[15]);
+    ASSERT_EQ(16u, component.commands().position());
+
+    component.execute(); // Samples 16..31: gain changes at sample 21 (offset 5)
+    ASSERT_EQ(3u, component.segments());
+    ASSERT_EQ(1.0f, component.output()[4]);
+    ASSERT_EQ(2.0f, component.output()[5]);
+    ASSERT_EQ(2.0f, component.output()[15]);
+    ASSERT_EQ(0u, component.commands().pending());
+}
+
+// Test several commands in one block, including one on the block boundary
+TEST(multiple_commands_per_block) {
+    GainComponent component;
+    component.initialize();
+    auto& commands = component.commands();
+    commands.schedule(0, SetGain{3.0f});
+    commands.schedule(4, SetGain{4.0f});
+    commands.schedule(4, SetGain{5.0f}); // Same sample: last one wins
+    commands.schedule(15, SetGain{6.0f});
+    commands.schedule(16, SetGain{7.0f}); // Next block
+
+    component.execute();
+    ASSERT_EQ(3.0f, component.output()[0]);
+    ASSERT_EQ(3.0f, component.output()[3]);
+    ASSERT_EQ(5.0f, component.output()[4]);
+    ASSERT_EQ(5.0f, component.output()[14]);
+    ASSERT_EQ(6.0f, component.output()[15]);
+    ASSERT_EQ(1u, commands.pending());
+
+    component.execute();
+    ASSERT_EQ(7.0f, component.output()[0]);
+}
+
+// Test late commands and reset
+TEST(late_commands_and_reset) {
+    GainComponent component;
+    component.initialize();
+    component.execute();
+    component.execute();
+
+    // Sample 3 already passed: applied at the start of the next block
+    component.commands().schedule(3, SetGain{8.0f});
+    component.execute();
+    ASSERT_EQ(8.0f, component.output()[0]);
+
+    // Reset drops pending commands and restarts the sample counter
+    component.commands().schedule(100, SetGain{9.0f});
+    component.reset();
+    ASSERT_EQ(0u, component.commands().position());
+    ASSERT_EQ(0u, component.commands().pending());
+    component.execute();
+    ASSERT_EQ(1.0f, component.output()[0]);
+}
+
+struct Marker {
+    std::uint64_t at = 0;
+};
+
+// Records the sample each command took effect on
+class MarkerComponent : public Component {
+public:
+    static constexpr std::size_t block_size = 16;
+
+    struct Applied {
+        std::uint64_t at = 0;
+        std::uint64_t sample = 0;
+    };
+
+    explicit MarkerComponent(std::size_t expected) { applied_.reserve(expected); }
+
+    TimedCommandQueue<Marker>& commands() { return commands_; }
+    const std::vector<Applied>& applied() const { return applied_; }
+    std::uint64_t blocks() const { return blocks_.load(std::memory_order_acquire); }
+
+protected:
+    std::error_code doInitialize() noexcept override { return commands_.allocate(8); }
+    void doTerminate() noexcept override { commands_.deallocate(); }
+    void doReset() noexcept override { commands_.reset(); }
+
+    bool doExecute() noexcept override {
+        const std::uint64_t start = commands_.position();
+        std::size_t waiting = 0;
+        commands_.run(
+            block_size,
+            [&](const Marker& m) {
+                applied_.push_back({m.at, 0});
+                waiting++;
+            },
+            [&](std::size_t offset, std::size_t) {
+                for (std::size_t i = applied_.size() - waiting; i < applied_.size(); ++i) {
+                    applied_[i].sample = start + offset;
+                }
+                waiting = 0;
+            });
+        blocks_.store(blocks_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        return false;
+    }
+
+private:
+    TimedCommandQueue<Marker> commands_;
+    std::vector<Applied> applied_;
+    std::atomic<std::uint64_t> blocks_{0};
+};
+
+// Test scheduling from a control thread while the component executes concurrently
+TEST(schedule_from_control_thread) {
+    constexpr std::size_t count = 500;
+    MarkerComponent component(count);
+    ASSERT_FALSE(component.initialize());
+    std::atomic<bool> done{false};
+    std::vector<std::uint64_t> scheduled;
+    scheduled.reserve(count);
+
+    // Schedules a little ahead of the executing thread; the 8-entry queue fills regularly
+    std::thread control([&] {
+        std::uint64_t at = 0;
+        for (std::size_t k = 0; k < count; ++k) {
+            at = std::max(at, component.blocks() * MarkerComponent::block_size + 24 + (k * 5) % 16);
+            while (!component.commands().schedule(at, Marker{at})) {
+                std::this_thread::yield();
+            }
+            scheduled.push_back(at);
+        }
+        done.store(true, std::memory_order_release);
+    });
+    while (!done.load(std::memory_order_acquire) || component.commands().pending() > 0) {
+        component.execute();
+    }
+    control.join();
+
+    // Every command arrives once, in order, on its sample or (if it arrived late) at the
+    // start of the first block after it was scheduled
+    const auto& applied = component.applied();
+    ASSERT_EQ(applied.size(), count);
+    std::size_t on_time = 0;
+    for (std::size_t k = 0; k < count; ++k) {
+        ASSERT_EQ(applied[k].at, scheduled[k]);
+        ASSERT_TRUE(applied[k].sample >= applied[k].at);
+        if (applied[k].sample == applied[k].at) {
+            on_time++;
+        } else {
+            ASSERT_EQ(applied[k].sample % MarkerComponent::block_size, 0u);
+        }
+    }
+    ASSERT_TRUE(on_time > 0);
+}
+
+int main() {
+    std::cout << "Running Timed Command Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,250 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/placement.hpp>
+#include <dspai/comp/topology.hpp>
+#include "test_macros.hpp"
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+using namespace dspai::comp;
+namespace fs = std::filesystem;
+
+// Runs for a fixed number of steps
+class Stage : public Component {
+public:
+    explicit Stage(int steps = 1) : steps_(steps) {}
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override { count_ = 0; }
+    bool doExecute() noexcept override { return ++count_ >= steps_; }
+
+private:
+    int steps_;
+    int count_ = 0;
+};
+
+static void write_file(const fs::path& path, const std::string& text) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path) << text << '\n';
+}
+
+// Fake sysfs: 2 packages x 2 cores x 2 threads, one L3 and one NUMA node per package.
+// CPU n: package n/4, core (n/2)%2, sibling of n^1.
+static fs::path make_sysfs() {
+    const fs::path root = fs::temp_directory_path() / ("dspai_topology_" + std::to_string(getpid()));
+    fs::remove_all(root);
+    const fs::path cpu_root = root / "devices/system/cpu";
+    write_file(cpu_root / "online", "0-7");
+    for (unsigned cpu = 0; cpu < 8; ++cpu) {
+        const fs::path dir = cpu_root / ("cpu" + std::to_string(cpu));
+        const unsigned package = cpu / 4;
+        write_file(dir / "topology/physical_package_id", std::to_string(package));
+        write_file(dir / "topology/core_id", std::to_string((cpu / 2) % 2));
+        write_file(dir / "cache/index0/level", "1");
+        write_file(dir / "cache/index0/shared_cpu_list", std::to_string(cpu & ~1u) + "-" + std::to_string(cpu | 1u));
+        write_file(dir / "cache/index3/level", "3");
+        write_file(dir / "cache/index3/shared_cpu_list",
+                   std::to_string(package * 4) + "-" + std::to_string(package * 4 + 3));
+    }
+    write_file(root / "devices/system/node/node0/cpulist", "0-3");
+    write_file(root / "devices/system/node/node1/cpulist", "4-7");
+    return root;
+}
+
+static NodeOptions named(const char* name) {
+    NodeOptions options;
+    options.name = name;
+    return options;
+}
+
+// Test CPU list parsing
+TEST(topology_cpu_list) {
+    std::vector<unsigned> cpus;
+    ASSERT_TRUE(detail::parse_cpu_list("0-2,5,8-9\n", cpus));
+    ASSERT_EQ(cpus.size(), 6u);
+    ASSERT_EQ(cpus[3], 5u);
+    ASSERT_EQ(cpus[5], 9u);
+    ASSERT_FALSE(detail::parse_cpu_list("0-x", cpus));
+}
+
+// Test discovery from a fake sysfs tree
+TEST(topology_discover) {
+    const auto root = make_sysfs();
+    auto topology = discover_topology(root.string());
+    fs::remove_all(root);
+    ASSERT_TRUE(topology.has_value());
+    ASSERT_EQ(topology->cpus.size(), 8u);
+    ASSERT_EQ(topology->packages, 2u);
+    ASSERT_EQ(topology->cores, 4u);
+    ASSERT_EQ(topology->l3_domains, 2u);
+    ASSERT_EQ(topology->numa_nodes, 2u);
+
+    const auto* cpu5 = topology->find(5);
+    ASSERT_TRUE(cpu5 != nullptr);
+    ASSERT_EQ(cpu5->package, 1u);
+    ASSERT_EQ(cpu5->smt, 1u);
+    ASSERT_EQ(cpu5->l3, 1u);
+    ASSERT_EQ(cpu5->numa, 1u);
+    ASSERT_EQ(cpu5->core, topology->find(4)->core);
+    ASSERT_TRUE(topology->find(8) == nullptr);
+
+    ASSERT_EQ(discover_topology("/nonexistent").error(), std::make_error_code(std::errc::no_such_file_or_directory));
+}
+
+// Test discovery on this machine
+TEST(topology_discover_host) {
+    if (!fs::exists("/sys/devices/system/cpu/online")) {
+        return;
+    }
+    auto topology = discover_topology();
+    ASSERT_TRUE(topology.has_value());
+    ASSERT_TRUE(!topology->cpus.empty());
+    ASSERT_TRUE(topology->cores >= 1u && topology->cores <= topology->cpus.size());
+    ASSERT_TRUE(topology->l3_domains >= 1u);
+}
+
+// Test two independent chains land in separate L3 domains with no cut cache edges
+TEST(placement_two_chains) {
+    const auto root = make_sysfs();
+    auto topology = discover_topology(root.string());
+    fs::remove_all(root);
+    ASSERT_TRUE(topology.has_value());
+
+    std::array<Stage, 6> stages;
+    Graph graph;
+    const char* names[] = {"a.src", "a.fir", "a.sink", "b.src", "b.fir", "b.sink"};
+    for (std::size_t i = 0; i < stages.size(); ++i) {
+        graph.add(stages[i], named(names[i]));
+    }
+    graph.connect(0, 1);
+    graph.connect(1, 2);
+    graph.connect(3, 4);
+    graph.connect(4, 5);
+    ASSERT_FALSE(graph.build());
+
+    const std::array<double, 6> costs = {1.0, 4.0, 1.0, 1.0, 4.0, 1.0};
+    auto plan = place(graph, *topology, costs);
+    ASSERT_TRUE(plan.has_value());
+    ASSERT_EQ(plan->workers(), 4u); // One per physical core
+    for (auto cpu : plan->cpus) {
+        ASSERT_EQ(topology->find(cpu)->smt, 0u);
+    }
+    ASSERT_EQ(plan->cross_l3_edges, 0u);
+    ASSERT_TRUE(plan->worker_l3[plan->owners[0]] != plan->worker_l3[plan->owners[3]]);
+    // The heavy stage of each chain gets a core to itself
+    ASSERT_TRUE(plan->owners[1] != plan->owners[0] && plan->owners[1] != plan->owners[2]);
+    ASSERT_EQ(plan->worker_load[plan->owners[1]], 4.0);
+
+    const auto text = format_plan(*plan, graph);
+    ASSERT_TRUE(text.find("a.fir") != std::string::npos);
+    ASSERT_TRUE(text.find("cross-l3 edges: 0") != std::string::npos);
+
+    PlacementOptions smt;
+    smt.use_smt = true;
+    smt.max_workers = 2;
+    plan = place(graph, *topology, costs, smt);
+    ASSERT_TRUE(plan.has_value());
+    ASSERT_EQ(plan->workers(), 2u);
+    ASSERT_EQ(plan->cpus[0], 0u);
+    ASSERT_EQ(plan->cpus[1], 2u); // Second core before SMT sibling
+
+    const std::array<double, 2> wrong = {1.0, 1.0};
+    ASSERT_EQ(place(graph, *topology, wrong).error(), std::make_error_code(std::errc::invalid_argument));
+}
+
+// src -> ddc -> fir -> demod -> sink, with per-node output traffic
+static void make_chain(Graph& graph, std::array<Stage, 5>& stages, const std::array<std::size_t, 5>& bytes) {
+    for (std::size_t i = 0; i < stages.size(); ++i) {
+        NodeOptions options;
+        options.output_bytes = bytes[i];
+        graph.add(stages[i], std::move(options));
+        if (i > 0) {
+            graph.connect(i - 1, i);
+        }
+    }
+}
+
+// Test a single chain is cut across both L3 domains at its lowest-traffic edge
+TEST(placement_single_chain) {
+    const auto root = make_sysfs();
+    auto topology = discover_topology(root.string());
+    fs::remove_all(root);
+    ASSERT_TRUE(topology.has_value());
+
+    // The decimating ddc makes ddc -> fir the cheapest edge
+    std::array<Stage, 5> stages;
+    Graph graph;
+    make_chain(graph, stages, {4096, 512, 2048, 2048, 0});
+    ASSERT_FALSE(graph.build());
+
+    const std::array<double, 5> costs = {1.0, 3.0, 3.0, 2.0, 1.0};
+    auto plan = place(graph, *topology, costs);
+    ASSERT_TRUE(plan.has_value());
+    ASSERT_EQ(plan->workers(), 4u);
+    ASSERT_EQ(plan->cross_l3_edges, 1u);
+    auto l3 = [&](NodeId id) { return plan->worker_l3[plan->owners[id]]; };
+    ASSERT_EQ(l3(0), l3(1));
+    ASSERT_TRUE(l3(1) != l3(2));
+    for (std::size_t w = 0; w < plan->workers(); ++w) {
+        ASSERT_TRUE(plan->worker_load[w] > 0.0); // Every worker has work
+    }
+
+    // With equal traffic the cut balances cost
+    Graph uniform;
+    make_chain(uniform, stages, {1024, 1024, 1024, 1024, 1024});
+    ASSERT_FALSE(uniform.build());
+    const std::array<double, 5> even = {1.0, 1.0, 1.0, 1.0, 2.0};
+    plan = place(uniform, *topology, even);
+    ASSERT_TRUE(plan.has_value());
+    ASSERT_EQ(plan->cross_l3_edges, 1u);
+    ASSERT_EQ(l3(0), l3(2));
+    ASSERT_TRUE(l3(2) != l3(3));
+}
+
+// Test a plan drives the executor and measured costs feed back into place()
+TEST(placement_executor) {
+    auto topology = discover_topology();
+    if (!topology) {
+        return;
+    }
+    std::array<Stage, 3> stages = {Stage(50), Stage(50), Stage(50)};
+    Graph graph;
+    for (auto& stage : stages) {
+        stage.initialize();
+        graph.add(stage);
+    }
+    graph.connect(0, 1);
+    graph.connect(1, 2);
+    ASSERT_FALSE(graph.build());
+
+    PlacementOptions options;
+    options.max_workers = 2;
+    auto plan = place(graph, *topology, {}, options);
+    ASSERT_TRUE(plan.has_value());
+
+    ThreadedExecutor executor(graph);
+    ASSERT_FALSE(executor.start(plan->workers(), plan->owners, plan->cpus));
+    executor.wait();
+    ASSERT_TRUE(executor.finished());
+
+    const auto costs = measured_costs(executor);
+    ASSERT_EQ(costs.size(), 3u);
+    ASSERT_TRUE(costs[0] > 0.0);
+    ASSERT_TRUE(place(graph, *topology, costs, options).has_value());
+    ASSERT_TRUE(format_plan(*plan, graph).find("#2") != std::string::npos);
+}
+
+int main() {
+    std::cout << "Running Topology Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <dspai/comp/component.hpp>
+#include <dspai/comp/watchdog.hpp>
+#include "test_macros.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+using namespace dspai::comp;
+using namespace std::chrono_literals;
+
+// Component whose first step blocks until released
+class StuckComponent : public Component {
+public:
+    StuckComponent(std::atomic<bool>& hold, std::atomic<bool>& finish) : hold_(hold), finish_(finish) {}
+
+protected:
+    std::error_code doInitialize() noexcept override { return {}; }
+    void doTerminate() noexcept override {}
+    void doReset() noexcept override {}
+    bool doExecute() noexcept override {
+        while (hold_.load()) {
+            std::this_thread::yield();
+        }
+        return finish_.load();
+    }
+
+private:
+    std::atomic<bool>& hold_;
+    std::atomic<bool>& finish_;
+};
+
+// Test detection, reporting and evacuation of a stuck worker
+TEST(watchdog_detects_stall) {
+    std::atomic<bool> hold{true};
+    std::atomic<bool> no_hold{false};
+    std::atomic<bool> finish{false};
+    StuckComponent stuck(hold, finish);
+    StuckComponent b(no_hold, finish);
+    StuckComponent c(no_hold, finish);
+    StuckComponent d(no_hold, finish);
+    for (auto* component : {&stuck, &b, &c, &d}) {
+        component->initialize();
+    }
+
+    Graph graph;
+    NodeOptions stuck_options;
+    stuck_options.name = "stuck";
+    const auto ns = *graph.add(stuck, std::move(stuck_options));
+    const auto nb = *graph.add(b);
+    const auto nc = *graph.add(c);
+    const auto nd = *graph.add(d);
+    graph.build();
+
+    // Worker 0 owns stuck, b and c; worker 1 owns d
+    ThreadedExecutor executor(graph);
+    FlightRecorder recorder(1024, 4, 4);
+    executor.set_recorder(&recorder);
+    std::array<std::size_t, 4> owners{0, 0, 0, 1};
+    ASSERT_FALSE(executor.start(2, owners));
+
+    std::vector<StallReport> reports;
+    const auto dump_path = (std::filesystem::temp_directory_path() / "dspai_watchdog_dump").string();
+    Watchdog watchdog(executor, {.budget = 1s, .period = 1ms, .migrate = true, .dump_path = dump_path},
+                      [&](const StallReport& report) { reports.push_back(report); });
+    ASSERT_TRUE(watchdog.set_budget(99, 1ms) == std::errc::invalid_argument);
+    ASSERT_FALSE(watchdog.set_budget(ns, 5ms));
+
+    while (watchdog.check() == 0) {
+        std::this_thread::sleep_for(1ms);
+    }
+    ASSERT_EQ(1u, reports.size());
+    ASSERT_EQ(ns, reports[0].node);
+    ASSERT_TRUE(reports[0].name == "stuck");
+    ASSERT_EQ(0u, reports[0].worker);
+    ASSERT_TRUE(reports[0].elapsed >= 5ms);
+    ASSERT_EQ(2u, reports[0].migrated);
+    ASSERT_EQ(1u, executor.owner(nb));
+    ASSERT_EQ(1u, executor.owner(nc));
+    ASSERT_EQ(0u, executor.owner(ns));
+
+    // The stall was recorded and the recorder dumped
+    auto dump = read_flight_dump(dump_path.c_str());
+    std::filesystem::remove(dump_path);
+    ASSERT_TRUE(dump.has_value());
+    std::size_t stall_events = 0;
+    for (const auto& event : dump->events) {
+        stall_events += event.type == EventType::Stall && event.source == ns;
+    }
+    ASSERT_EQ(1u, stall_events);
+    ASSERT_TRUE(dump->name(ns) == "stuck");
+
+    // Evacuated nodes keep running while the stuck step holds worker 0
+    const auto steps_b = executor.steps(nb);
+    while (executor.steps(nb) < steps_b + 10 || executor.steps(nd) < 10) {
+        std::this_thread::yield();
+    }
+    ASSERT_EQ(0u, watchdog.check()); // Reported once per step
+    ASSERT_EQ(1u, watchdog.stalls());
+
+    hold = false;
+    finish = true;
+    executor.wait();
+    ASSERT_TRUE(executor.finished());
+}
+
+// Test healthy steps within budget are not reported, using the polling thread
+TEST(watchdog_thread_no_false_positive) {
+    std::atomic<bool> no_hold{false};
+    std::atomic<bool> finish{false};
+    StuckComponent a(no_hold, finish);
+    a.initialize();
+    Graph graph;
+    graph.add(a);
+    graph.build();
+
+    ThreadedExecutor executor(graph);
+    executor.start(1);
+    Watchdog watchdog(executor, {.budget = 1s, .period = 1ms, .migrate = true, .dump_path = {}});
+    ASSERT_FALSE(watchdog.start());
+    ASSERT_TRUE(watchdog.start() == std::errc::operation_not_permitted);
+    std::this_thread::sleep_for(20ms);
+    watchdog.stop();
+    ASSERT_EQ(0u, watchdog.stalls());
+
+    finish = true;
+    executor.wait();
+}
+
+int main() {
+    std::cout << "Running Watchdog Tests\n";
+    std::cout << "==================================\n";
+
+    // All tests run automatically via static initialization
+
+    std::cout << "==================================\n";
+    std::cout << "All tests passed!\n";
+    return 0;
+}
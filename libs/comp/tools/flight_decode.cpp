@@ -0,0 +1,92 @@
+// Flight recorder dump decoder
+//
+// Prints the merged timeline of a FlightRecorder::dump() file: time relative to the first
+// event, thread, source name, event and value. ExecuteEnd lines also show how long the step
+// took (matched with the ExecuteBegin of the same thread and source).
+//
+// Usage: dspai_comp_flight_decode <dump> [--csv]
+
+#include <dspai/comp/flight_recorder.hpp>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+
+using namespace dspai::comp;
+
+namespace {
+
+double to_us(const FlightDump& dump, std::uint64_t ticks) { return static_cast<double>(ticks) / dump.ticks_per_ns / 1e3; }
+
+std::string source_label(const FlightDump& dump, std::uint32_t source) {
+    const auto name = dump.name(source);
+    return name.empty() ? "#" + std::to_string(source) : std::string(name);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <dump> [--csv]\n", argv[0]);
+        return 2;
+    }
+    const bool csv = argc > 2 && std::strcmp(argv[2], "--csv") == 0;
+
+    auto dump = read_flight_dump(argv[1]);
+    if (!dump) {
+        std::fprintf(stderr, "%s: %s\n", argv[1], dump.error().message().c_str());
+        return 1;
+    }
+    if (dump->events.empty()) {
+        std::printf("# %u threads, no events\n", dump->threads);
+        return 0;
+    }
+
+    const auto origin = dump->events.front().tick;
+    std::map<std::pair<std::uint16_t, std::uint32_t>, std::uint64_t> begins;
+    if (csv) {
+        std::printf("time_us,thread,source,event,value,duration_us\n");
+    } else {
+        std::printf("# %u threads, %zu events, %llu overwritten, dump at %+.3f us\n", dump->threads,
+                    dump->events.size(), static_cast<unsigned long long>(dump->overwritten),
+                    dump->dump_tick >= origin ? to_us(*dump, dump->dump_tick - origin) : 0.0);
+        std::printf("%14s %6s  %-24s %-14s %s\n", "time_us", "thread", "source", "event", "value");
+    }
+
+    for (const auto& event : dump->events) {
+        const auto time = to_us(*dump, event.tick - origin);
+        const auto label = source_label(*dump, event.source);
+        const auto type = event_type_name(event.type);
+        const auto key = std::make_pair(event.thread, event.source);
+
+        double duration = -1.0;
+        if (event.type == EventType::ExecuteBegin) {
+            begins[key] = event.tick;
+        } else if (event.type == EventType::ExecuteEnd) {
+            auto begin = begins.find(key);
+            if (begin != begins.end() && begin->second <= event.tick) {
+                duration = to_us(*dump, event.tick - begin->second);
+                begins.erase(begin);
+            }
+        }
+
+        const auto value = static_cast<unsigned long long>(event.value);
+        if (csv) {
+            std::printf("%.3f,%u,%s,%.*s,%llu,", time, event.thread, label.c_str(), static_cast<int>(type.size()),
+                        type.data(), value);
+            if (duration >= 0.0) {
+                std::printf("%.3f", duration);
+            }
+            std::printf("\n");
+        } else {
+            std::printf("%14.3f %6u  %-24s %-14.*s %llu", time, event.thread, label.c_str(),
+                        static_cast<int>(type.size()), type.data(), value);
+            if (duration >= 0.0) {
+                std::printf("  (%.3f us)", duration);
+            }
+            std::printf("\n");
+        }
+    }
+    return 0;
+}